@@ -1,71 +1,14 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <libxsmm.h>
+#include <omp.h>
+#include <vector>
 #include "BinaryContraction.h"
+#include "ContractionPlan.h"
+#include "PlanCache.h"
 
-int64_t tpp_nets::backend::BinaryContraction::filter_attributes( int64_t         i_size,
-                                                                 int8_t          i_type_filter,
-                                                                 int8_t  const * i_types,
-                                                                 int64_t const * i_attributes,
-                                                                 int64_t       * o_attributes ) {
-  int64_t l_id_out = 0;
-  for( int64_t l_id_in = 0; l_id_in < i_size; l_id_in++ ) {
-    if( i_types[l_id_in] == i_type_filter ) {
-      o_attributes[l_id_out] = i_attributes[l_id_in];
-      l_id_out++;
-    }
-  }
-  return l_id_out;
-}
-
-int64_t tpp_nets::backend::BinaryContraction::loop_configs( int64_t         i_n_dims_a,
-                                                            int64_t         i_n_dims_b,
-                                                            int8_t          i_type_filter_a,
-                                                            int8_t          i_type_filter_b,
-                                                            int8_t  const * i_types_a,
-                                                            int8_t  const * i_types_b,
-                                                            int64_t const * i_sizes_a,
-                                                            int64_t const * i_strides_a,
-                                                            int64_t const * i_strides_b,
-                                                            int64_t       * o_loops_sizes,
-                                                            int64_t       * o_loops_strides_a,
-                                                            int64_t       * o_loops_strides_b ) {
-  int64_t l_num_loops       = filter_attributes( i_n_dims_a,
-                                                  i_type_filter_a,
-                                                  i_types_a,
-                                                  i_sizes_a,
-                                                  o_loops_sizes );
-
-  int64_t l_num_loops_tmp_0 = filter_attributes( i_n_dims_a,
-                                                  i_type_filter_a,
-                                                  i_types_a,
-                                                  i_strides_a,
-                                                  o_loops_strides_a );
-  assert( l_num_loops == l_num_loops_tmp_0 );
-
-  int64_t l_num_loops_tmp_1 = filter_attributes( i_n_dims_b,
-                                                  i_type_filter_b,
-                                                  i_types_b,
-                                                  i_strides_b,
-                                                  o_loops_strides_b );
-  assert( l_num_loops == l_num_loops_tmp_1 );
-
-  return l_num_loops;
-}
-
-bool tpp_nets::backend::BinaryContraction::advance_loop( int64_t         i_num_loops,
-                                                         int64_t const * i_sizes,
-                                                         int64_t       * io_counters ) {
-  for( int64_t l_id_loop = i_num_loops; l_id_loop >= 0; l_id_loop-- ) {
-    if( io_counters[l_id_loop]+1 < i_sizes[l_id_loop] ) {
-      io_counters[l_id_loop]++;
-      return false;
-    }
-    else {
-      io_counters[l_id_loop] = 0;
-    }
-  }
-
-  return true;
+int64_t tpp_nets::backend::BinaryContraction::n_threads() const {
+  return ( m_pool != nullptr ) ? m_pool->n_threads() : omp_get_max_threads();
 }
 
 void tpp_nets::backend::BinaryContraction::tppdot( int64_t         i_n_dims_s,
@@ -81,215 +24,221 @@ void tpp_nets::backend::BinaryContraction::tppdot( int64_t         i_n_dims_s,
                                                    int64_t const * i_strides_u,
                                                    void          * i_s,
                                                    void          * i_t,
-                                                   void          * o_u ) {
-  int64_t l_dtype_size = 4;
-
-  // create LIBXSMM kernel
-  assert( i_strides_s[i_n_dims_s-1] == 1 );
-  assert( i_strides_t[i_n_dims_t-1] == 1 );
-  assert( i_strides_u[i_n_dims_u-1] == 1 );
-
-  int8_t l_gemm_type_s = i_types_s[i_n_dims_s-1];
-  int8_t l_gemm_type_t = i_types_t[i_n_dims_t-1];
-  int8_t l_gemm_type_u = i_types_u[i_n_dims_u-1];
-
-  libxsmm_blasint l_gemm_m = 0;
-  libxsmm_blasint l_gemm_n = 0;
-  libxsmm_blasint l_gemm_k = 0;
-
-  libxsmm_blasint l_gemm_lda = 0;
-  libxsmm_blasint l_gemm_ldb = 0;
-  libxsmm_blasint l_gemm_ldc = 0;
-
-  libxsmm_bitfield l_gemm_flags = 0;
-  libxsmm_bitfield l_gemm_prefetch_flags = 0;
-
-  if(    l_gemm_type_s == 0
-      && l_gemm_type_t == 0 ) {
-    // A is column-major, B is row-major
-    l_gemm_m = i_sizes_s[i_n_dims_s-1];
-    l_gemm_n = i_sizes_t[i_n_dims_t-1];
-    l_gemm_k = i_sizes_t[i_n_dims_t-2];
-
-    l_gemm_lda = l_gemm_m;
-    l_gemm_ldb = l_gemm_n;
-    l_gemm_ldc = l_gemm_m;
-
-    l_gemm_flags = LIBXSMM_GEMM_FLAGS('N', 'T');
+                                                   void          * o_u,
+                                                   dtype_t         i_dtype_in,
+                                                   dtype_t         i_dtype_out,
+                                                   Epilogue const& i_epilogue,
+                                                   void    const * i_bias ) {
+  std::shared_ptr< ContractionPlan const > l_plan = PlanCache::instance().get( i_n_dims_s,
+                                                                              i_n_dims_t,
+                                                                              i_n_dims_u,
+                                                                              i_sizes_s,
+                                                                              i_sizes_t,
+                                                                              i_types_s,
+                                                                              i_types_t,
+                                                                              i_types_u,
+                                                                              i_strides_s,
+                                                                              i_strides_t,
+                                                                              i_strides_u,
+                                                                              i_dtype_in,
+                                                                              i_dtype_out,
+                                                                              i_epilogue,
+                                                                              n_threads() );
+
+  l_plan->execute( i_s,
+                   i_t,
+                   o_u,
+                   i_bias,
+                   nullptr,
+                   m_pool );
+}
 
-    // TODO: row-major C
-    assert( l_gemm_type_u == 0 );
+tpp_nets::backend::Executor::handle_t tpp_nets::backend::BinaryContraction::submit( Executor                                 & io_executor,
+                                                                                   std::vector< Executor::handle_t > const & i_deps,
+                                                                                   int64_t                                    i_n_dims_s,
+                                                                                   int64_t                                    i_n_dims_t,
+                                                                                   int64_t                                    i_n_dims_u,
+                                                                                   int64_t                            const * i_sizes_s,
+                                                                                   int64_t                            const * i_sizes_t,
+                                                                                   int8_t                             const * i_types_s,
+                                                                                   int8_t                             const * i_types_t,
+                                                                                   int8_t                             const * i_types_u,
+                                                                                   int64_t                            const * i_strides_s,
+                                                                                   int64_t                            const * i_strides_t,
+                                                                                   int64_t                            const * i_strides_u,
+                                                                                   void                                     * i_s,
+                                                                                   void                                     * i_t,
+                                                                                   void                                     * o_u,
+                                                                                   dtype_t                                    i_dtype_in,
+                                                                                   dtype_t                                    i_dtype_out,
+                                                                                   Epilogue                           const & i_epilogue,
+                                                                                   void                               const * i_bias ) {
+  // the caller's geometry arrays may be gone once the task runs
+  std::vector< int64_t > l_sizes_s(   i_sizes_s,   i_sizes_s   + i_n_dims_s );
+  std::vector< int64_t > l_sizes_t(   i_sizes_t,   i_sizes_t   + i_n_dims_t );
+  std::vector< int8_t  > l_types_s(   i_types_s,   i_types_s   + i_n_dims_s );
+  std::vector< int8_t  > l_types_t(   i_types_t,   i_types_t   + i_n_dims_t );
+  std::vector< int8_t  > l_types_u(   i_types_u,   i_types_u   + i_n_dims_u );
+  std::vector< int64_t > l_strides_s( i_strides_s, i_strides_s + i_n_dims_s );
+  std::vector< int64_t > l_strides_t( i_strides_t, i_strides_t + i_n_dims_t );
+  std::vector< int64_t > l_strides_u( i_strides_u, i_strides_u + i_n_dims_u );
+
+  std::vector< int64_t > l_strides_bias;
+  if( i_epilogue.strides_bias != nullptr ) {
+    l_strides_bias.assign( i_epilogue.strides_bias,
+                           i_epilogue.strides_bias + i_n_dims_u );
   }
-  else if(    l_gemm_type_s == 0
-           && l_gemm_type_t == 1 ) {
-    // A and B are column-major
-    l_gemm_m = i_sizes_s[i_n_dims_s-1];
-    l_gemm_n = i_sizes_t[i_n_dims_t-2];
-    l_gemm_k = i_sizes_t[i_n_dims_t-1];
 
-    l_gemm_lda = l_gemm_m;
-    l_gemm_ldb = l_gemm_k;
-    l_gemm_ldc = l_gemm_m;
+  ThreadPool * l_pool = m_pool;
+
+  return io_executor.submit( [=]() {
+                               Epilogue l_epilogue = i_epilogue;
+                               if( i_epilogue.strides_bias != nullptr ) {
+                                 l_epilogue.strides_bias = l_strides_bias.data();
+                               }
+
+                               BinaryContraction l_bin_con( l_pool );
+                               l_bin_con.tppdot( i_n_dims_s,
+                                                 i_n_dims_t,
+                                                 i_n_dims_u,
+                                                 l_sizes_s.data(),
+                                                 l_sizes_t.data(),
+                                                 l_types_s.data(),
+                                                 l_types_t.data(),
+                                                 l_types_u.data(),
+                                                 l_strides_s.data(),
+                                                 l_strides_t.data(),
+                                                 l_strides_u.data(),
+                                                 i_s,
+                                                 i_t,
+                                                 o_u,
+                                                 i_dtype_in,
+                                                 i_dtype_out,
+                                                 l_epilogue,
+                                                 i_bias );
+                             },
+                             i_deps );
+}
 
-    l_gemm_flags = LIBXSMM_GEMM_FLAGS('N', 'N');
+void tpp_nets::backend::BinaryContraction::first_touch( int64_t         i_n_dims_s,
+                                                        int64_t         i_n_dims_t,
+                                                        int64_t         i_n_dims_u,
+                                                        int64_t const * i_sizes_s,
+                                                        int64_t const * i_sizes_t,
+                                                        int8_t  const * i_types_s,
+                                                        int8_t  const * i_types_t,
+                                                        int8_t  const * i_types_u,
+                                                        int64_t const * i_strides_s,
+                                                        int64_t const * i_strides_t,
+                                                        int64_t const * i_strides_u,
+                                                        void          * o_u,
+                                                        dtype_t         i_dtype_in,
+                                                        dtype_t         i_dtype_out,
+                                                        Epilogue const& i_epilogue ) {
+  std::shared_ptr< ContractionPlan const > l_plan = PlanCache::instance().get( i_n_dims_s,
+                                                                              i_n_dims_t,
+                                                                              i_n_dims_u,
+                                                                              i_sizes_s,
+                                                                              i_sizes_t,
+                                                                              i_types_s,
+                                                                              i_types_t,
+                                                                              i_types_u,
+                                                                              i_strides_s,
+                                                                              i_strides_t,
+                                                                              i_strides_u,
+                                                                              i_dtype_in,
+                                                                              i_dtype_out,
+                                                                              i_epilogue,
+                                                                              n_threads() );
+
+  l_plan->first_touch( o_u,
+                       m_pool );
+}
 
-    // TODO: row-major C
-    assert( l_gemm_type_u == 0 );
+void tpp_nets::backend::BinaryContraction::tppdot_grouped( int64_t       i_n_groups,
+                                                           Group const * i_groups ) {
+  int64_t l_n_threads = n_threads();
+
+  // plans of the groups
+  std::vector< std::shared_ptr< ContractionPlan const > > l_plans( i_n_groups );
+  int64_t l_n_contractions = 0;
+
+  for( int64_t l_gr = 0; l_gr < i_n_groups; l_gr++ ) {
+    Group const & l_group = i_groups[l_gr];
+    assert( l_group.n_contractions == 0 || ( l_group.s != nullptr && l_group.t != nullptr && l_group.u != nullptr ) );
+    assert( l_group.n_contractions == 0 || l_group.epilogue.strides_bias == nullptr || l_group.bias != nullptr );
+
+    l_plans[l_gr] = PlanCache::instance().get( l_group.n_dims_s,
+                                               l_group.n_dims_t,
+                                               l_group.n_dims_u,
+                                               l_group.sizes_s,
+                                               l_group.sizes_t,
+                                               l_group.types_s,
+                                               l_group.types_t,
+                                               l_group.types_u,
+                                               l_group.strides_s,
+                                               l_group.strides_t,
+                                               l_group.strides_u,
+                                               l_group.dtype_in,
+                                               l_group.dtype_out,
+                                               l_group.epilogue,
+                                               l_n_threads );
+    l_n_contractions += l_group.n_contractions;
   }
-  else if(    l_gemm_type_s == 1
-           && l_gemm_type_t == 0 ) {
-    // A and B are row-major
-    l_gemm_m = i_sizes_s[i_n_dims_s-2];
-    l_gemm_n = i_sizes_t[i_n_dims_t-1];
-    l_gemm_k = i_sizes_s[i_n_dims_s-1];
-
-    l_gemm_lda = l_gemm_k;
-    l_gemm_ldb = l_gemm_n;
-    l_gemm_ldc = l_gemm_m;
-
-    l_gemm_flags = LIBXSMM_GEMM_FLAGS('T', 'T');
-
-    // TODO: row-major C
-    assert( l_gemm_type_u == 0 );
+  if( l_n_contractions == 0 ) return;
+
+  // work items: ranges of C blocks of the contractions
+  struct Item {
+    int64_t group;
+    int64_t contraction;
+    int64_t first;
+    int64_t last;
+  };
+  std::vector< Item > l_items;
+
+  int64_t l_n_items_min = m_items_per_thread * l_n_threads;
+  int64_t l_n_chunks = ( l_n_items_min + l_n_contractions - 1 ) / l_n_contractions;
+
+  for( int64_t l_gr = 0; l_gr < i_n_groups; l_gr++ ) {
+    int64_t l_n_blocks = l_plans[l_gr]->n_blocks();
+    int64_t l_n_chunks_group = std::min( l_n_chunks, l_n_blocks );
+
+    for( int64_t l_co = 0; l_co < i_groups[l_gr].n_contractions; l_co++ ) {
+      for( int64_t l_ch = 0; l_ch < l_n_chunks_group; l_ch++ ) {
+        l_items.push_back( { l_gr,
+                             l_co,
+                             l_n_blocks * l_ch / l_n_chunks_group,
+                             l_n_blocks * ( l_ch + 1 ) / l_n_chunks_group } );
+      }
+    }
   }
-  else if(    l_gemm_type_s == 1
-           && l_gemm_type_t == 1 ) {
-    // A is row-major, B is column-major
-    l_gemm_m = i_sizes_s[i_n_dims_s-2];
-    l_gemm_n = i_sizes_t[i_n_dims_t-2];
-    l_gemm_k = i_sizes_s[i_n_dims_s-1];
-
-    l_gemm_lda = l_gemm_k;
-    l_gemm_ldb = l_gemm_k;
-    l_gemm_ldc = l_gemm_m;
 
-    l_gemm_flags = LIBXSMM_GEMM_FLAGS('T', 'N');
-
-    // TODO: row-major C
-    assert( l_gemm_type_u == 0 );
+  int64_t l_n_items = l_items.size();
+  auto l_execute = [&]( int64_t i_it ) {
+    Item const & l_item = l_items[i_it];
+    Group const & l_group = i_groups[l_item.group];
+
+    l_plans[l_item.group]->execute_blocks( l_group.s[l_item.contraction],
+                                           l_group.t[l_item.contraction],
+                                           l_group.u[l_item.contraction],
+                                           ( l_group.bias != nullptr ) ? l_group.bias[l_item.contraction] : nullptr,
+                                           l_item.first,
+                                           l_item.last );
+  };
+
+  if( m_pool != nullptr ) {
+    // dynamic scheduling through a shared counter
+    std::atomic< int64_t > l_next = 0;
+    m_pool->run( [&]( int64_t ) {
+      for( int64_t l_it = l_next++; l_it < l_n_items; l_it = l_next++ ) {
+        l_execute( l_it );
+      }
+    } );
   }
   else {
-    assert( false );
-  }
-
-  l_gemm_flags |= LIBXSMM_GEMM_FLAG_USE_XGEMM_ABI;
-
-  libxsmm_gemm_shape l_gemm_shape = libxsmm_create_gemm_shape( l_gemm_m,
-                                                               l_gemm_n,
-                                                               l_gemm_k,
-                                                               l_gemm_lda,
-                                                               l_gemm_ldb,
-                                                               l_gemm_ldc,
-                                                               LIBXSMM_DATATYPE_F32,
-                                                               LIBXSMM_DATATYPE_F32,
-                                                               LIBXSMM_DATATYPE_F32,
-                                                               LIBXSMM_DATATYPE_F32 );
-
-  libxsmm_gemmfunction l_gemm = libxsmm_dispatch_gemm_v2( l_gemm_shape,
-                                                          l_gemm_flags,
-                                                          l_gemm_prefetch_flags );
-
-  // configuration of the M loops
-  int64_t l_m_loops_sizes[m_max_loops]     = { 0 };
-  int64_t l_m_loops_strides_s[m_max_loops] = { 0 };
-  int64_t l_m_loops_strides_u[m_max_loops] = { 0 };
-
-  int64_t l_num_m_loops = loop_configs( i_n_dims_s,
-                                        i_n_dims_u,
-                                        0,
-                                        0,
-                                        i_types_s,
-                                        i_types_u,
-                                        i_sizes_s,
-                                        i_strides_s,
-                                        i_strides_u,
-                                        l_m_loops_sizes,
-                                        l_m_loops_strides_s,
-                                        l_m_loops_strides_u );
-
-  // configuration of the N loops
-  int64_t l_n_loops_sizes[m_max_loops]     = { 0 };
-  int64_t l_n_loops_strides_t[m_max_loops] = { 0 };
-  int64_t l_n_loops_strides_u[m_max_loops] = { 0 };
-
-  int64_t l_num_n_loops = loop_configs( i_n_dims_t,
-                                        i_n_dims_u,
-                                        0,
-                                        1,
-                                        i_types_t,
-                                        i_types_u,
-                                        i_sizes_t,
-                                        i_strides_t,
-                                        i_strides_u,
-                                        l_n_loops_sizes,
-                                        l_n_loops_strides_t,
-                                        l_n_loops_strides_u );
-
-  // configuration of the K loops
-  int64_t l_k_loops_sizes[m_max_loops]     = { 0 };
-  int64_t l_k_loops_strides_s[m_max_loops] = { 0 };
-  int64_t l_k_loops_strides_t[m_max_loops] = { 0 };
-
-  int64_t l_num_k_loops = loop_configs( i_n_dims_s,
-                                        i_n_dims_t,
-                                        1,
-                                        1,
-                                        i_types_s,
-                                        i_types_t,
-                                        i_sizes_s,
-                                        i_strides_s,
-                                        i_strides_t,
-                                        l_k_loops_sizes,
-                                        l_k_loops_strides_s,
-                                        l_k_loops_strides_t );
-
-  // TODO: add batch (B) loops
-
-  int64_t l_m_loops_ctrs[m_max_loops] = { 0 };
-  int64_t l_n_loops_ctrs[m_max_loops] = { 0 };
-  int64_t l_k_loops_ctrs[m_max_loops] = { 0 };
-  int64_t l_b_loops_ctrs[m_max_loops] = { 0 };
-
-  while( true ) {
-    int64_t l_offset_s = 0;
-    int64_t l_offset_t = 0;
-    int64_t l_offset_u = 0;
-    for( int64_t l_loop_id_m = 0; l_loop_id_m < l_num_m_loops; l_loop_id_m++ ) {
-      l_offset_s += l_m_loops_ctrs[l_loop_id_m] * l_m_loops_strides_s[l_loop_id_m];
-      l_offset_u += l_m_loops_ctrs[l_loop_id_m] * l_m_loops_strides_u[l_loop_id_m];
-    }
-    for( int64_t l_loop_id_n = 0; l_loop_id_n < l_num_n_loops; l_loop_id_n++ ) {
-      l_offset_t += l_n_loops_ctrs[l_loop_id_n] * l_n_loops_strides_t[l_loop_id_n];
-      l_offset_u += l_n_loops_ctrs[l_loop_id_n] * l_n_loops_strides_u[l_loop_id_n];
-    }
-    for( int64_t l_loop_id_k = 0; l_loop_id_k < l_num_k_loops; l_loop_id_k++ ) {
-      l_offset_s += l_k_loops_ctrs[l_loop_id_k] * l_k_loops_strides_s[l_loop_id_k];
-      l_offset_t += l_k_loops_ctrs[l_loop_id_k] * l_k_loops_strides_t[l_loop_id_k];
-    }
-
-    libxsmm_gemm_param l_param;
-    l_param.a.primary = (char *) i_s + l_offset_s * l_dtype_size;
-    l_param.b.primary = (char *) i_t + l_offset_t * l_dtype_size;
-    l_param.c.primary = (char *) o_u + l_offset_u * l_dtype_size;
-
-    l_gemm( &l_param );
-
-    bool l_advance_n = advance_loop( l_num_k_loops-2,
-                                     l_k_loops_sizes,
-                                     l_k_loops_ctrs );
-
-    if( l_advance_n ) {
-      bool l_advance_m = advance_loop( l_num_n_loops-2,
-                                       l_n_loops_sizes,
-                                       l_n_loops_ctrs );
-
-      if( l_advance_m ) {
-        bool l_finished = advance_loop( l_num_m_loops-2,
-                                        l_m_loops_sizes,
-                                        l_m_loops_ctrs );
-        if( l_finished ) break;
-      }
+#pragma omp parallel for schedule(dynamic,1)
+    for( int64_t l_it = 0; l_it < l_n_items; l_it++ ) {
+      l_execute( l_it );
     }
   }
-
-}
\ No newline at end of file
+}
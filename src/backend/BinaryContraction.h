@@ -1,6 +1,12 @@
 #ifndef TPP_NETS_BACKEND_BINARY_CONTRACTION
+#define TPP_NETS_BACKEND_BINARY_CONTRACTION
 
 #include <cstdint>
+#include <vector>
+#include "DataType.h"
+#include "Epilogue.h"
+#include "Executor.h"
+#include "ThreadPool.h"
 
 namespace tpp_nets {
   namespace backend {
@@ -9,78 +15,79 @@ namespace tpp_nets {
 }
 
 class tpp_nets::backend::BinaryContraction {
-    static constexpr int64_t m_max_loops = 25;
+  public:
+    //! group of independent contractions with the same geometry, datatypes and epilogue
+    struct Group {
+      //! S's number of dimensions
+      int64_t n_dims_s = 0;
+      //! T's number of dimensions
+      int64_t n_dims_t = 0;
+      //! U's number of dimensions
+      int64_t n_dims_u = 0;
+      //! sizes of S's dimensions
+      int64_t const * sizes_s = nullptr;
+      //! sizes of T's dimensions
+      int64_t const * sizes_t = nullptr;
+      //! types of S's dimensions (0: M, 1: K, 2: B)
+      int8_t const * types_s = nullptr;
+      //! types of T's dimensions (0: N, 1: K, 2: B)
+      int8_t const * types_t = nullptr;
+      //! types of U's dimensions (0: M, 1: N, 2: B)
+      int8_t const * types_u = nullptr;
+      //! strides of S's dimensions
+      int64_t const * strides_s = nullptr;
+      //! strides of T's dimensions
+      int64_t const * strides_t = nullptr;
+      //! strides of U's dimensions
+      int64_t const * strides_u = nullptr;
+      //! datatype of S and T
+      dtype_t dtype_in = dtype_t::fp32;
+      //! datatype of U
+      dtype_t dtype_out = dtype_t::fp32;
+      //! initialization of U and epilogue applied to U
+      Epilogue epilogue;
+
+      //! number of contractions
+      int64_t n_contractions = 0;
+      //! data pointers of the contractions' S tensors
+      void * const * s = nullptr;
+      //! data pointers of the contractions' T tensors
+      void * const * t = nullptr;
+      //! data pointers of the contractions' U tensors
+      void * const * u = nullptr;
+      //! data pointers of the contractions' biases, only used if the epilogue adds a bias
+      void const * const * bias = nullptr;
+    };
+
+  private:
+    //! minimum number of work items per thread of a grouped call
+    static constexpr int64_t m_items_per_thread = 4;
+
+    //! thread pool executing the contractions, nullptr if OpenMP threads are used
+    ThreadPool * m_pool = nullptr;
 
     /**
-     * Filters an array based on the elements' type.
-     *
-     * Given an array with i_size element.
-     * Each element has a type (i_types) and a attribute (i_attributes).
-     *
-     * The routine iterates from [0, i_size-1] through the array.
-     * Whenever the the of an element matches i_type_filter,
-     * the elements' attribute is copied over to o_attribute.
-     *
-     * Copy operations to o_attribute start at position 0.
-     * The position is incremented after every copy operation.
-     *
-     * @param i_size size of the input array holding elements with a type and attribute.
-     * @param i_type_filter type which is filtered.
-     * @param i_types types of the array's elements.
-     * @param i_attributes attributes of the array's elements.
-     * @param o_attributes will be set to filtered attributes.
-     * @return number copy operations, i.e., number of times the filtered type occurred in the input.
-     **/
-    static int64_t filter_attributes( int64_t         i_size,
-                                      int8_t          i_type_filter,
-                                      int8_t  const * i_types,
-                                      int64_t const * i_attributes,
-                                      int64_t       * o_attributes );
-    /**
-     * Derives the configuration of loops iterating over dimension in a binary tensor contraction.
+     * Gets the number of threads executing the contractions.
      *
-     * @param i_n_dims_a number of dimensions of A.
-     * @param i_n_dims_b number of dimensions of B.
-     * @param i_types_a types of A's dimensions.
-     * @param i_types_b types of B's dimensions.
-     * @param i_sizes_a sizes of A's dimensions.
-     * @param i_strides_a strides of A's dimensions.
-     * @param i_strides_b strides of B's dimensions.
-     * @param o_loops_sizes will be set to sizes of the resulting loops.
-     * @param o_loops_strides_a will be set to strides of the resulting loops w.r.t. A.
-     * @param o_loops_strides_b will be set to strides of the resulting loops w.r.t. B.
-     * @return number of loops.
+     * @return number of the pool's threads or omp_get_max_threads() if no pool is used.
      **/
-    static int64_t loop_configs( int64_t         i_n_dims_a,
-                                 int64_t         i_n_dims_b,
-                                 int8_t          i_type_filter_a,
-                                 int8_t          i_type_filter_b,
-                                 int8_t  const * i_types_a,
-                                 int8_t  const * i_types_b,
-                                 int64_t const * i_sizes_a,
-                                 int64_t const * i_strides_a,
-                                 int64_t const * i_strides_b,
-                                 int64_t       * o_loops_sizes,
-                                 int64_t       * o_loops_strides_a,
-                                 int64_t       * o_loops_strides_b );
+    int64_t n_threads() const;
 
+  public:
     /**
-     * Advance the given loops if possible.
-     * If not the loop counters are set to zero.
+     * Constructor.
      *
-     * @param i_num_loops number of loops.
-     * @param i_sizes sizes of the loops.
-     * @param io_counters loop counters.
-     * @return true if the counter have been set to zero, false otherwise. 
+     * @param io_pool thread pool executing the contractions, nullptr for OpenMP threads, see ThreadPool::instance.
      **/
-    bool advance_loop( int64_t         i_num_loops,
-                       int64_t const * i_sizes,
-                       int64_t       * io_counters );
+    BinaryContraction( ThreadPool * io_pool = nullptr ) : m_pool( io_pool ) {}
 
-  public:
     /**
      * Performs a (generalized) tensordot operation using Tensor Processing Primitives.
      * S and T are the input tensors, U is the output tensors.
+     *
+     * The routine obtains the contraction plan from the process-wide plan cache and executes it.
+     * The plan is only constructed in the first call for a given geometry.
+     * The plan is executed by the thread pool if one was given at construction.
      * 
      * @param i_n_dims_s S's number of dimensions.
      * @param i_n_dims_t T's number of dimensions.
@@ -97,6 +104,10 @@ class tpp_nets::backend::BinaryContraction {
      * @param i_s data pointer of S.
      * @param i_t data pointer of T.
      * @param o_u data pointer of U.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     * @param i_bias data pointer of the bias, only used if the epilogue adds a bias.
      **/
     void tppdot( int64_t         i_n_dims_s,
                  int64_t         i_n_dims_t,
@@ -111,7 +122,109 @@ class tpp_nets::backend::BinaryContraction {
                  int64_t const * i_strides_u,
                  void          * i_s,
                  void          * i_t,
-                 void          * o_u );
+                 void          * o_u,
+                 dtype_t         i_dtype_in  = dtype_t::fp32,
+                 dtype_t         i_dtype_out = dtype_t::fp32,
+                 Epilogue const& i_epilogue  = Epilogue(),
+                 void    const * i_bias      = nullptr );
+
+    /**
+     * Submits a tensordot operation to an executor, i.e., performs tppdot asynchronously.
+     * The geometry arrays are copied, the data pointers have to stay valid until the returned task finished.
+     * The plan is obtained on the executing worker and thus optimized for the worker's number of threads.
+     *
+     * @param io_executor executor which runs the operation.
+     * @param i_deps tasks which have to finish before the operation starts, e.g., producers of S or T.
+     * @param i_n_dims_s S's number of dimensions.
+     * @param i_n_dims_t T's number of dimensions.
+     * @param i_n_dims_u U's number of dimensions.
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_types_s types of S's dimensions (0: M, 1: K, 2: B).
+     * @param i_types_t types of T's dimensions (0: N, 1: K, 2: B).
+     * @param i_types_u types of U's dimensions (0: M, 1: N, 2: B).
+     * @param i_strides_s strides of S's dimensions.
+     * @param i_strides_t strides of T's dimensions.
+     * @param i_strides_u strides of U's dimensions.
+     * @param i_s data pointer of S.
+     * @param i_t data pointer of T.
+     * @param o_u data pointer of U.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     * @param i_bias data pointer of the bias, only used if the epilogue adds a bias.
+     * @return handle of the submitted task.
+     **/
+    Executor::handle_t submit( Executor                                 & io_executor,
+                               std::vector< Executor::handle_t > const & i_deps,
+                               int64_t                                    i_n_dims_s,
+                               int64_t                                    i_n_dims_t,
+                               int64_t                                    i_n_dims_u,
+                               int64_t                            const * i_sizes_s,
+                               int64_t                            const * i_sizes_t,
+                               int8_t                             const * i_types_s,
+                               int8_t                             const * i_types_t,
+                               int8_t                             const * i_types_u,
+                               int64_t                            const * i_strides_s,
+                               int64_t                            const * i_strides_t,
+                               int64_t                            const * i_strides_u,
+                               void                                     * i_s,
+                               void                                     * i_t,
+                               void                                     * o_u,
+                               dtype_t                                    i_dtype_in  = dtype_t::fp32,
+                               dtype_t                                    i_dtype_out = dtype_t::fp32,
+                               Epilogue                           const & i_epilogue  = Epilogue(),
+                               void                               const * i_bias      = nullptr );
+
+    /**
+     * Zeroes U with the C blocks assigned to the same threads as in tppdot, see ContractionPlan::first_touch.
+     * The arguments have to match those of the following tppdot calls to hit the same plan.
+     *
+     * @param i_n_dims_s S's number of dimensions.
+     * @param i_n_dims_t T's number of dimensions.
+     * @param i_n_dims_u U's number of dimensions.
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_types_s types of S's dimensions (0: M, 1: K, 2: B).
+     * @param i_types_t types of T's dimensions (0: N, 1: K, 2: B).
+     * @param i_types_u types of U's dimensions (0: M, 1: N, 2: B).
+     * @param i_strides_s strides of S's dimensions.
+     * @param i_strides_t strides of T's dimensions.
+     * @param i_strides_u strides of U's dimensions.
+     * @param o_u data pointer of U.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     **/
+    void first_touch( int64_t         i_n_dims_s,
+                      int64_t         i_n_dims_t,
+                      int64_t         i_n_dims_u,
+                      int64_t const * i_sizes_s,
+                      int64_t const * i_sizes_t,
+                      int8_t  const * i_types_s,
+                      int8_t  const * i_types_t,
+                      int8_t  const * i_types_u,
+                      int64_t const * i_strides_s,
+                      int64_t const * i_strides_t,
+                      int64_t const * i_strides_u,
+                      void          * o_u,
+                      dtype_t         i_dtype_in  = dtype_t::fp32,
+                      dtype_t         i_dtype_out = dtype_t::fp32,
+                      Epilogue const& i_epilogue  = Epilogue() );
+
+    /**
+     * Performs groups of independent tensordot operations.
+     *
+     * The plan of every group is obtained once from the process-wide plan cache.
+     * The contractions of all groups are distributed over the OpenMP threads (or the pool's threads) with dynamic scheduling.
+     * If there are too few contractions to keep all threads busy, the contractions are split into ranges of C blocks.
+     * Strided batches of a single shape are better expressed through B dimensions of a single tppdot call.
+     *
+     * @param i_n_groups number of groups.
+     * @param i_groups groups of contractions.
+     **/
+    void tppdot_grouped( int64_t       i_n_groups,
+                         Group const * i_groups );
 };
 
 #endif
\ No newline at end of file
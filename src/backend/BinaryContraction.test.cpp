@@ -270,4 +270,430 @@ TEST_CASE( "Tests the tppdot routine with row-major A and B, and column-major C.
 
   REQUIRE( at::allclose( l_u,
                          l_ref_td ) );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Tests the tppdot routine with batch dimensions.",
+           "[tpp_nets][BinaryContraction][tppdot_batch]" ) {
+  //                        0   1   2   3   4
+  //                       b0  m0  k0  b1  m1
+  //                        a   b   c   d   e
+  int64_t l_sizes_s[5] = {  3,  5, 17,  4, 13 };
+
+  //                        0   1   2   3
+  //                       b0  b1  n0  k0
+  //                        a   d   f   c
+  int64_t l_sizes_t[4] = {  3,  4,  8, 17 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                            0   1   2   3   4
+  //                           b0  b1  n0  m0  m1
+  //                            a   d   f   b   e
+  at::Tensor l_u = at::zeros( { 3,  4,  8,  5, 13 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[5] = { 2, 0, 1, 2, 0 };
+  int8_t l_types_t[4] = { 2, 2, 0, 1 };
+  int8_t l_types_u[5] = { 2, 2, 1, 0, 0 };
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( 5,
+                    4,
+                    5,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "abcde,adfc->adfbe",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the tppdot routine with column-major A, row-major B, and row-major C.",
+           "[tpp_nets][BinaryContraction][tppdot_001]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0   1   2   3
+  //                       k0  n0  k1  n1
+  //                        a   e   c   f
+  int64_t l_sizes_t[4] = { 17,  8, 22,  7 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                            0   1   2   3
+  //                           m0  n0  m1  n1
+  //                            b   e   d   f
+  at::Tensor l_u = at::zeros( { 5,  8, 13,  7 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 1, 0, 1, 0 };
+  int8_t l_types_u[4] = { 0, 1, 0, 1 };
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( 4,
+                    4,
+                    4,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "abcd,aecf->bedf",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the tppdot routine with column-major A and B, and row-major C.",
+           "[tpp_nets][BinaryContraction][tppdot_011]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0   1   2   3
+  //                       n0  k0  n1  k1
+  //                        e   a   f   c
+  int64_t l_sizes_t[4] = {  8, 17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                            0   1   2   3
+  //                           m0  n0  m1  n1
+  //                            b   e   d   f
+  at::Tensor l_u = at::zeros( { 5,  8, 13,  7 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 0, 1, 0, 1 };
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( 4,
+                    4,
+                    4,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "abcd,eafc->bedf",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the tppdot routine with row-major A, column-major B, and row-major C.",
+           "[tpp_nets][BinaryContraction][tppdot_111]" ) {
+  //                        0   1   2   3
+  //                       m0  k0  m1  k1
+  //                        b   a   d   c
+  int64_t l_sizes_s[4] = {  5, 17, 13, 22 };
+
+  //                        0   1   2   3
+  //                       n0  k0  n1  k1
+  //                        e   a   f   c
+  int64_t l_sizes_t[4] = {  8, 17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                            0   1   2   3
+  //                           m0  n0  m1  n1
+  //                            b   e   d   f
+  at::Tensor l_u = at::zeros( { 5,  8, 13,  7 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 0, 1, 0, 1 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 0, 1, 0, 1 };
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( 4,
+                    4,
+                    4,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "badc,eafc->bedf",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the tppdot routine with row-major A, B and C.",
+           "[tpp_nets][BinaryContraction][tppdot_101]" ) {
+  //                        0   1   2   3
+  //                       m0  k0  m1  k1
+  //                        b   a   d   c
+  int64_t l_sizes_s[4] = {  5, 17, 13, 22 };
+
+  //                        0   1   2   3
+  //                       k0  n0  k1  n1
+  //                        a   e   c   f
+  int64_t l_sizes_t[4] = { 17,  8, 22,  7 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                            0   1   2   3
+  //                           m0  n0  m1  n1
+  //                            b   e   d   f
+  at::Tensor l_u = at::zeros( { 5,  8, 13,  7 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 0, 1, 0, 1 };
+  int8_t l_types_t[4] = { 1, 0, 1, 0 };
+  int8_t l_types_u[4] = { 0, 1, 0, 1 };
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( 4,
+                    4,
+                    4,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "badc,aecf->bedf",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the grouped tppdot routine.",
+           "[tpp_nets][BinaryContraction][tppdot_grouped]" ) {
+  // group 0: many small column-major matrix products
+  //                                m0  k0
+  int64_t l_sizes_s_0[2]   = {      24, 16 };
+  //                                k0  n0
+  int64_t l_sizes_t_0[2]   = {      16, 12 };
+  int64_t l_strides_s_0[2] = {       1, 24 };
+  int64_t l_strides_t_0[2] = {       1, 16 };
+  int64_t l_strides_u_0[2] = {       1, 24 };
+  int8_t  l_types_s_0[2]   = {       0,  1 };
+  int8_t  l_types_t_0[2]   = {       1,  0 };
+  int8_t  l_types_u_0[2]   = {       0,  1 };
+
+  // group 1: a few larger contractions with a batch dimension, accumulated into U
+  //                                 b  m0  k0
+  int64_t l_sizes_s_1[3]   = {       3, 40, 32 };
+  //                                 b  k0  n0
+  int64_t l_sizes_t_1[3]   = {       3, 32, 36 };
+  int64_t l_strides_s_1[3] = { 32*40, 1, 40 };
+  int64_t l_strides_t_1[3] = { 32*36, 1, 32 };
+  int64_t l_strides_u_1[3] = { 36*40, 1, 40 };
+  int8_t  l_types_s_1[3]   = {       2,  0,  1 };
+  int8_t  l_types_t_1[3]   = {       2,  1,  0 };
+  int8_t  l_types_u_1[3]   = {       2,  0,  1 };
+
+  std::vector< at::Tensor > l_s_0, l_t_0, l_u_0;
+  std::vector< void * > l_ptrs_s_0, l_ptrs_t_0, l_ptrs_u_0;
+  for( int64_t l_co = 0; l_co < 50; l_co++ ) {
+    l_s_0.push_back( at::rand( { 16, 24 } ) );
+    l_t_0.push_back( at::rand( { 12, 16 } ) );
+    l_u_0.push_back( at::rand( { 12, 24 } ) );
+    l_ptrs_s_0.push_back( l_s_0.back().data_ptr() );
+    l_ptrs_t_0.push_back( l_t_0.back().data_ptr() );
+    l_ptrs_u_0.push_back( l_u_0.back().data_ptr() );
+  }
+
+  std::vector< at::Tensor > l_s_1, l_t_1, l_u_1, l_u_1_init;
+  std::vector< void * > l_ptrs_s_1, l_ptrs_t_1, l_ptrs_u_1;
+  for( int64_t l_co = 0; l_co < 3; l_co++ ) {
+    l_s_1.push_back( at::rand( { 3, 32, 40 } ) );
+    l_t_1.push_back( at::rand( { 3, 36, 32 } ) );
+    l_u_1.push_back( at::rand( { 3, 36, 40 } ) );
+    l_u_1_init.push_back( l_u_1.back().clone() );
+    l_ptrs_s_1.push_back( l_s_1.back().data_ptr() );
+    l_ptrs_t_1.push_back( l_t_1.back().data_ptr() );
+    l_ptrs_u_1.push_back( l_u_1.back().data_ptr() );
+  }
+
+  tpp_nets::backend::BinaryContraction::Group l_groups[2];
+  l_groups[0].n_dims_s = 2;
+  l_groups[0].n_dims_t = 2;
+  l_groups[0].n_dims_u = 2;
+  l_groups[0].sizes_s = l_sizes_s_0;
+  l_groups[0].sizes_t = l_sizes_t_0;
+  l_groups[0].types_s = l_types_s_0;
+  l_groups[0].types_t = l_types_t_0;
+  l_groups[0].types_u = l_types_u_0;
+  l_groups[0].strides_s = l_strides_s_0;
+  l_groups[0].strides_t = l_strides_t_0;
+  l_groups[0].strides_u = l_strides_u_0;
+  l_groups[0].epilogue.zero_u = true;
+  l_groups[0].n_contractions = 50;
+  l_groups[0].s = l_ptrs_s_0.data();
+  l_groups[0].t = l_ptrs_t_0.data();
+  l_groups[0].u = l_ptrs_u_0.data();
+
+  l_groups[1].n_dims_s = 3;
+  l_groups[1].n_dims_t = 3;
+  l_groups[1].n_dims_u = 3;
+  l_groups[1].sizes_s = l_sizes_s_1;
+  l_groups[1].sizes_t = l_sizes_t_1;
+  l_groups[1].types_s = l_types_s_1;
+  l_groups[1].types_t = l_types_t_1;
+  l_groups[1].types_u = l_types_u_1;
+  l_groups[1].strides_s = l_strides_s_1;
+  l_groups[1].strides_t = l_strides_t_1;
+  l_groups[1].strides_u = l_strides_u_1;
+  l_groups[1].n_contractions = 3;
+  l_groups[1].s = l_ptrs_s_1.data();
+  l_groups[1].t = l_ptrs_t_1.data();
+  l_groups[1].u = l_ptrs_u_1.data();
+
+  tpp_nets::backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot_grouped( 2,
+                            l_groups );
+
+  for( int64_t l_co = 0; l_co < 50; l_co++ ) {
+    at::Tensor l_ref = at::einsum( "km,nk->nm",
+                                   {l_s_0[l_co], l_t_0[l_co]} );
+    REQUIRE( at::allclose( l_u_0[l_co],
+                           l_ref ) );
+  }
+
+  for( int64_t l_co = 0; l_co < 3; l_co++ ) {
+    at::Tensor l_ref = l_u_1_init[l_co] + at::einsum( "bkm,bnk->bnm",
+                                                      {l_s_1[l_co], l_t_1[l_co]} );
+    REQUIRE( at::allclose( l_u_1[l_co],
+                           l_ref ) );
+  }
+}
+
+TEST_CASE( "Tests the first touch and the tppdot routine through a thread pool.",
+           "[tpp_nets][BinaryContraction][tppdot_pool]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0    1   2   3
+  //                       n0   k0  n1  k1
+  //                        e    a   f   c
+  int64_t l_sizes_t[4] = {  8,  17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                           0   1   2   3
+  //                          n0  m0  n1  m1
+  //                           e   b   f   d
+  at::Tensor l_u = at::rand( { 8,  5,  7, 13 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::ThreadPool l_pool( 3 );
+  tpp_nets::backend::BinaryContraction l_bin_con( &l_pool );
+
+  // U is zeroed by the pool's threads which own the C blocks
+  l_bin_con.first_touch( 4,
+                         4,
+                         4,
+                         l_sizes_s,
+                         l_sizes_t,
+                         l_types_s,
+                         l_types_t,
+                         l_types_u,
+                         l_strides_s.data(),
+                         l_strides_t.data(),
+                         l_strides_u.data(),
+                         l_u.data_ptr() );
+  REQUIRE( at::equal( l_u,
+                      at::zeros_like( l_u ) ) );
+
+  l_bin_con.tppdot( 4,
+                    4,
+                    4,
+                    l_sizes_s,
+                    l_sizes_t,
+                    l_types_s,
+                    l_types_t,
+                    l_types_u,
+                    l_strides_s.data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+  // einsum reference
+  at::Tensor l_ref = at::einsum( "abcd,eafc->ebfd",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cassert>
+#include "BlockScheduler.h"
+
+tpp_nets::backend::BlockScheduler::BlockScheduler( int64_t i_n_threads,
+                                                   int64_t i_n_blocks,
+                                                   int64_t i_chunk ) : m_deques( i_n_threads ) {
+  assert( i_n_threads > 0 );
+  assert( i_n_blocks >= 0 && i_n_blocks < ( int64_t(1) << 32 ) );
+
+  // by default, every thread's range is split into about eight tasks
+  m_chunk = i_chunk;
+  if( m_chunk <= 0 ) {
+    m_chunk = std::max( i_n_blocks / ( 8 * i_n_threads ),
+                        int64_t(1) );
+  }
+
+  for( int64_t l_th = 0; l_th < i_n_threads; l_th++ ) {
+    m_deques[l_th].range.store( pack( i_n_blocks * l_th / i_n_threads,
+                                      i_n_blocks * ( l_th + 1 ) / i_n_threads ),
+                                std::memory_order_relaxed );
+  }
+}
+
+bool tpp_nets::backend::BlockScheduler::pop( int64_t   i_tid,
+                                             int64_t & o_first,
+                                             int64_t & o_last ) {
+  std::atomic< uint64_t > & l_range = m_deques[i_tid].range;
+  uint64_t l_old = l_range.load( std::memory_order_relaxed );
+
+  while( true ) {
+    int64_t l_first = l_old >> 32;
+    int64_t l_last  = l_old & 0xFFFFFFFF;
+    if( l_first >= l_last ) return false;
+
+    int64_t l_first_new = std::min( l_first + m_chunk,
+                                    l_last );
+    if( l_range.compare_exchange_weak( l_old,
+                                       pack( l_first_new, l_last ),
+                                       std::memory_order_relaxed ) ) {
+      o_first = l_first;
+      o_last = l_first_new;
+      return true;
+    }
+  }
+}
+
+bool tpp_nets::backend::BlockScheduler::steal( int64_t   i_tid,
+                                               int64_t & o_first,
+                                               int64_t & o_last ) {
+  std::atomic< uint64_t > & l_range = m_deques[i_tid].range;
+  uint64_t l_old = l_range.load( std::memory_order_relaxed );
+
+  while( true ) {
+    int64_t l_first = l_old >> 32;
+    int64_t l_last  = l_old & 0xFFFFFFFF;
+    if( l_first >= l_last ) return false;
+
+    int64_t l_last_new = std::max( l_last - m_chunk,
+                                   l_first );
+    if( l_range.compare_exchange_weak( l_old,
+                                       pack( l_first, l_last_new ),
+                                       std::memory_order_relaxed ) ) {
+      o_first = l_last_new;
+      o_last = l_last;
+      return true;
+    }
+  }
+}
+
+bool tpp_nets::backend::BlockScheduler::next( int64_t   i_tid,
+                                              int64_t & o_first,
+                                              int64_t & o_last ) {
+  if( pop( i_tid, o_first, o_last ) ) return true;
+
+  // victims are visited round robin, starting at the next thread
+  int64_t l_n_threads = m_deques.size();
+  for( int64_t l_vi = 1; l_vi < l_n_threads; l_vi++ ) {
+    if( steal( ( i_tid + l_vi ) % l_n_threads, o_first, o_last ) ) return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,104 @@
+#ifndef TPP_NETS_BACKEND_BLOCK_SCHEDULER
+#define TPP_NETS_BACKEND_BLOCK_SCHEDULER
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+namespace tpp_nets {
+  namespace backend {
+    class BlockScheduler;
+  }
+}
+
+/**
+ * Work-stealing scheduler of a contraction's C blocks.
+ *
+ * Every thread has a deque of blocks which is initialized with the thread's static range of blocks,
+ * i.e., without stealing, the threads execute the same blocks as a static partitioning.
+ * A deque is stored as a single atomic word holding the first and last block of the remaining range.
+ * The owner takes chunks of blocks from the front of its deque.
+ * Once its deque is empty, the thread steals chunks from the back of the other threads' deques,
+ * i.e., the blocks which the owner would execute last.
+ **/
+class tpp_nets::backend::BlockScheduler {
+  private:
+    //! remaining range of a thread: first block in the upper 32 bits, block after the last one in the lower 32 bits
+    struct alignas(64) Deque {
+      std::atomic< uint64_t > range;
+    };
+
+    //! deques of the threads
+    std::vector< Deque > m_deques;
+
+    //! number of blocks per task
+    int64_t m_chunk = 1;
+
+    /**
+     * Packs a range of blocks into a single word.
+     *
+     * @param i_first first block.
+     * @param i_last block after the last one.
+     * @return packed range.
+     **/
+    static uint64_t pack( int64_t i_first,
+                          int64_t i_last ) { return ( (uint64_t) i_first << 32 ) | (uint64_t) i_last; }
+
+    /**
+     * Takes a chunk of blocks from the front of a deque.
+     *
+     * @param i_tid id of the deque's thread.
+     * @param o_first will be set to the chunk's first block.
+     * @param o_last will be set to the block after the chunk's last one.
+     * @return true if a chunk was taken, false if the deque is empty.
+     **/
+    bool pop( int64_t   i_tid,
+              int64_t & o_first,
+              int64_t & o_last );
+
+    /**
+     * Takes a chunk of blocks from the back of a deque.
+     *
+     * @param i_tid id of the deque's thread.
+     * @param o_first will be set to the chunk's first block.
+     * @param o_last will be set to the block after the chunk's last one.
+     * @return true if a chunk was taken, false if the deque is empty.
+     **/
+    bool steal( int64_t   i_tid,
+                int64_t & o_first,
+                int64_t & o_last );
+
+  public:
+    /**
+     * Constructor, the blocks are partitioned into contiguous ranges of the threads.
+     *
+     * @param i_n_threads number of threads.
+     * @param i_n_blocks number of blocks.
+     * @param i_chunk number of blocks per task, zero derives the size from the number of blocks per thread.
+     **/
+    BlockScheduler( int64_t i_n_threads,
+                    int64_t i_n_blocks,
+                    int64_t i_chunk = 0 );
+
+    /**
+     * Gets the next chunk of blocks of a thread.
+     * The chunk is taken from the thread's own deque first, afterwards from the other threads' deques.
+     *
+     * @param i_tid id of the calling thread.
+     * @param o_first will be set to the chunk's first block.
+     * @param o_last will be set to the block after the chunk's last one.
+     * @return true if a chunk was obtained, false if all blocks are taken.
+     **/
+    bool next( int64_t   i_tid,
+               int64_t & o_first,
+               int64_t & o_last );
+
+    /**
+     * Gets the number of blocks per task.
+     *
+     * @return number of blocks.
+     **/
+    int64_t chunk() const { return m_chunk; }
+};
+
+#endif
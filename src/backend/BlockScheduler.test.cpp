@@ -0,0 +1,64 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <omp.h>
+#include "BlockScheduler.h"
+
+TEST_CASE( "Tests the order in which a thread obtains its own and stolen blocks.",
+           "[tpp_nets][BlockScheduler][next]" ) {
+  // ranges: [0,5), [5,10), [10,15)
+  tpp_nets::backend::BlockScheduler l_scheduler( 3,
+                                                 15,
+                                                 2 );
+  REQUIRE( l_scheduler.chunk() == 2 );
+
+  int64_t l_first = 0;
+  int64_t l_last = 0;
+
+  // own range from the front
+  REQUIRE( l_scheduler.next( 1, l_first, l_last ) );
+  REQUIRE( l_first == 5 );
+  REQUIRE( l_last == 7 );
+  REQUIRE( l_scheduler.next( 1, l_first, l_last ) );
+  REQUIRE( l_first == 7 );
+  REQUIRE( l_last == 9 );
+  REQUIRE( l_scheduler.next( 1, l_first, l_last ) );
+  REQUIRE( l_first == 9 );
+  REQUIRE( l_last == 10 );
+
+  // stolen from the back of the next thread
+  REQUIRE( l_scheduler.next( 1, l_first, l_last ) );
+  REQUIRE( l_first == 13 );
+  REQUIRE( l_last == 15 );
+
+  // the owner continues at the front
+  REQUIRE( l_scheduler.next( 2, l_first, l_last ) );
+  REQUIRE( l_first == 10 );
+  REQUIRE( l_last == 12 );
+}
+
+TEST_CASE( "Tests that concurrent threads obtain every block exactly once.",
+           "[tpp_nets][BlockScheduler][parallel]" ) {
+  int64_t l_n_blocks = 1013;
+  std::vector< int64_t > l_counts( l_n_blocks, 0 );
+
+  tpp_nets::backend::BlockScheduler l_scheduler( omp_get_max_threads(),
+                                                 l_n_blocks );
+
+#pragma omp parallel num_threads( omp_get_max_threads() )
+  {
+    int64_t l_first = 0;
+    int64_t l_last = 0;
+    while( l_scheduler.next( omp_get_thread_num(),
+                             l_first,
+                             l_last ) ) {
+      for( int64_t l_bl = l_first; l_bl < l_last; l_bl++ ) {
+#pragma omp atomic
+        l_counts[l_bl]++;
+      }
+    }
+  }
+
+  for( int64_t l_bl = 0; l_bl < l_n_blocks; l_bl++ ) {
+    REQUIRE( l_counts[l_bl] == 1 );
+  }
+}
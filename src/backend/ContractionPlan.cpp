@@ -0,0 +1,1264 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <omp.h>
+#include <unistd.h>
+#include "ContractionPlan.h"
+#include "BlockScheduler.h"
+#include "LoopOptimizer.h"
+
+int64_t tpp_nets::backend::ContractionPlan::filter_attributes( int64_t         i_size,
+                                                               int8_t          i_type_filter,
+                                                               int8_t  const * i_types,
+                                                               int64_t const * i_attributes,
+                                                               int64_t       * o_attributes ) {
+  int64_t l_id_out = 0;
+  for( int64_t l_id_in = 0; l_id_in < i_size; l_id_in++ ) {
+    if( i_types[l_id_in] == i_type_filter ) {
+      o_attributes[l_id_out] = i_attributes[l_id_in];
+      l_id_out++;
+    }
+  }
+  return l_id_out;
+}
+
+int64_t tpp_nets::backend::ContractionPlan::loop_configs( int64_t         i_n_dims_a,
+                                                          int64_t         i_n_dims_b,
+                                                          int8_t          i_type_filter_a,
+                                                          int8_t          i_type_filter_b,
+                                                          int8_t  const * i_types_a,
+                                                          int8_t  const * i_types_b,
+                                                          int64_t const * i_sizes_a,
+                                                          int64_t const * i_strides_a,
+                                                          int64_t const * i_strides_b,
+                                                          int64_t       * o_loops_sizes,
+                                                          int64_t       * o_loops_strides_a,
+                                                          int64_t       * o_loops_strides_b ) {
+  int64_t l_num_loops       = filter_attributes( i_n_dims_a,
+                                                  i_type_filter_a,
+                                                  i_types_a,
+                                                  i_sizes_a,
+                                                  o_loops_sizes );
+
+  int64_t l_num_loops_tmp_0 = filter_attributes( i_n_dims_a,
+                                                  i_type_filter_a,
+                                                  i_types_a,
+                                                  i_strides_a,
+                                                  o_loops_strides_a );
+  assert( l_num_loops == l_num_loops_tmp_0 );
+
+  int64_t l_num_loops_tmp_1 = filter_attributes( i_n_dims_b,
+                                                  i_type_filter_b,
+                                                  i_types_b,
+                                                  i_strides_b,
+                                                  o_loops_strides_b );
+  assert( l_num_loops == l_num_loops_tmp_1 );
+
+  return l_num_loops;
+}
+
+bool tpp_nets::backend::ContractionPlan::advance_loop( int64_t         i_num_loops,
+                                                       int64_t const * i_sizes,
+                                                       int64_t       * io_counters ) {
+  for( int64_t l_id_loop = i_num_loops; l_id_loop >= 0; l_id_loop-- ) {
+    if( io_counters[l_id_loop]+1 < i_sizes[l_id_loop] ) {
+      io_counters[l_id_loop]++;
+      return false;
+    }
+    else {
+      io_counters[l_id_loop] = 0;
+    }
+  }
+
+  return true;
+}
+
+int64_t tpp_nets::backend::ContractionPlan::dtype_size( dtype_t i_dtype ) {
+  if(      i_dtype == dtype_t::fp32 ) return 4;
+  else if( i_dtype == dtype_t::fp64 ) return 8;
+  else if( i_dtype == dtype_t::bf16 ) return 2;
+  else if( i_dtype == dtype_t::fp16 ) return 2;
+
+  assert( false );
+  return 0;
+}
+
+libxsmm_datatype tpp_nets::backend::ContractionPlan::dtype_libxsmm( dtype_t i_dtype ) {
+  if(      i_dtype == dtype_t::fp32 ) return LIBXSMM_DATATYPE_F32;
+  else if( i_dtype == dtype_t::fp64 ) return LIBXSMM_DATATYPE_F64;
+  else if( i_dtype == dtype_t::bf16 ) return LIBXSMM_DATATYPE_BF16;
+  else if( i_dtype == dtype_t::fp16 ) return LIBXSMM_DATATYPE_F16;
+
+  assert( false );
+  return LIBXSMM_DATATYPE_UNSUPPORTED;
+}
+
+void tpp_nets::backend::ContractionPlan::pack_a( char const * i_s,
+                                                 int64_t      i_first_iter,
+                                                 int64_t      i_last_iter,
+                                                 char       * o_packed ) const {
+  // scratch for the column-major tile is located behind the packed blocks
+  char * l_tile = o_packed + m_n_k_iters * m_pack_a_block_size;
+
+  for( int64_t l_it = i_first_iter; l_it < i_last_iter; l_it++ ) {
+    char const * l_in = i_s + m_pack_offsets_s[l_it];
+    char * l_out = o_packed + l_it * m_pack_a_block_size;
+
+    if( m_pack_vnni == nullptr ) {
+      m_packer_a.pack( l_in,
+                       l_out );
+      continue;
+    }
+
+    if( m_pack_a_copy ) {
+      m_packer_a.pack( l_in,
+                       l_tile );
+      l_in = l_tile;
+
+      // zero columns padding K to the VNNI packing factor
+      if( m_pad_k > 0 ) {
+        std::memset( l_tile + m_packer_a.size(),
+                     0,
+                     m_pack_a_block_size - m_packer_a.size() );
+      }
+    }
+
+    libxsmm_meltw_unary_param l_param;
+    l_param.in.primary = (void *) l_in;
+    l_param.out.primary = l_out;
+    m_pack_vnni( &l_param );
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::pack_b( char const * i_t,
+                                                 int64_t      i_first_iter,
+                                                 int64_t      i_last_iter,
+                                                 char       * o_packed ) const {
+  for( int64_t l_it = i_first_iter; l_it < i_last_iter; l_it++ ) {
+    char * l_out = o_packed + l_it * m_pack_b_block_size;
+    m_packer_b.pack( i_t + m_pack_offsets_t[l_it],
+                     l_out );
+
+    // zero rows padding K to the VNNI packing factor
+    if( m_pad_k > 0 ) {
+      int64_t l_n_cols = m_pack_b_block_size / m_pack_b_ld;
+      for( int64_t l_co = 0; l_co < l_n_cols; l_co++ ) {
+        std::memset( l_out + ( l_co + 1 ) * m_pack_b_ld - m_pad_k * m_dtype_size_in,
+                     0,
+                     m_pad_k * m_dtype_size_in );
+      }
+    }
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::init( int64_t         i_n_dims_s,
+                                               int64_t         i_n_dims_t,
+                                               int64_t         i_n_dims_u,
+                                               int64_t const * i_sizes_s,
+                                               int64_t const * i_sizes_t,
+                                               int8_t  const * i_types_s,
+                                               int8_t  const * i_types_t,
+                                               int8_t  const * i_types_u,
+                                               int64_t const * i_strides_s,
+                                               int64_t const * i_strides_t,
+                                               int64_t const * i_strides_u,
+                                               dtype_t         i_dtype_in,
+                                               dtype_t         i_dtype_out,
+                                               Epilogue const& i_epilogue,
+                                               int64_t         i_n_threads ) {
+  m_swap_operands = false;
+
+  // row-major C: swap the roles of S and T and compute C^T = B^T A^T
+  int64_t l_fastest_u = i_n_dims_u-1;
+  for( int64_t l_di = 0; l_di < i_n_dims_u; l_di++ ) {
+    if( i_strides_u[l_di] < i_strides_u[l_fastest_u] ) {
+      l_fastest_u = l_di;
+    }
+  }
+
+  if( i_types_u[l_fastest_u] == 1 ) {
+    assert( i_n_dims_u <= m_max_loops );
+
+    int8_t l_types_u_swapped[m_max_loops] = { 0 };
+    for( int64_t l_di = 0; l_di < i_n_dims_u; l_di++ ) {
+      if(      i_types_u[l_di] == 0 ) l_types_u_swapped[l_di] = 1;
+      else if( i_types_u[l_di] == 1 ) l_types_u_swapped[l_di] = 0;
+      else                            l_types_u_swapped[l_di] = i_types_u[l_di];
+    }
+
+    init( i_n_dims_t,
+          i_n_dims_s,
+          i_n_dims_u,
+          i_sizes_t,
+          i_sizes_s,
+          i_types_t,
+          i_types_s,
+          l_types_u_swapped,
+          i_strides_t,
+          i_strides_s,
+          i_strides_u,
+          i_dtype_in,
+          i_dtype_out,
+          i_epilogue );
+
+    m_swap_operands = true;
+    return;
+  }
+
+  // FP32 and FP64 use a single datatype, BF16 and FP16 are accumulated in FP32
+  libxsmm_datatype l_dtype_comp = LIBXSMM_DATATYPE_F32;
+  if( i_dtype_in == dtype_t::fp64 ) {
+    assert( i_dtype_out == dtype_t::fp64 );
+    l_dtype_comp = LIBXSMM_DATATYPE_F64;
+  }
+  else if( i_dtype_in == dtype_t::fp32 ) {
+    assert( i_dtype_out == dtype_t::fp32 );
+  }
+  else {
+    assert(    i_dtype_out == dtype_t::fp32
+            || i_dtype_out == i_dtype_in );
+  }
+
+  m_dtype_size_in  = dtype_size( i_dtype_in );
+  m_dtype_size_out = dtype_size( i_dtype_out );
+
+  // loops of the individual types, the i-th dimension of a type corresponds to the type's i-th loop
+  int64_t l_m_loops_sizes[m_max_loops]        = { 0 };
+  int64_t l_m_loops_strides_s[m_max_loops]    = { 0 };
+  int64_t l_m_loops_strides_u[m_max_loops]    = { 0 };
+  int64_t l_m_loops_strides_bias[m_max_loops] = { 0 };
+
+  int64_t l_n_loops_sizes[m_max_loops]        = { 0 };
+  int64_t l_n_loops_strides_t[m_max_loops]    = { 0 };
+  int64_t l_n_loops_strides_u[m_max_loops]    = { 0 };
+  int64_t l_n_loops_strides_bias[m_max_loops] = { 0 };
+
+  int64_t l_k_loops_sizes[m_max_loops]     = { 0 };
+  int64_t l_k_loops_strides_s[m_max_loops] = { 0 };
+  int64_t l_k_loops_strides_t[m_max_loops] = { 0 };
+
+  int64_t l_b_loops_sizes[m_max_loops]        = { 0 };
+  int64_t l_b_loops_strides_s[m_max_loops]    = { 0 };
+  int64_t l_b_loops_strides_t[m_max_loops]    = { 0 };
+  int64_t l_b_loops_strides_u[m_max_loops]    = { 0 };
+  int64_t l_b_loops_strides_bias[m_max_loops] = { 0 };
+
+  // configuration of the M loops
+  int64_t l_num_m_loops = loop_configs( i_n_dims_s,
+                                        i_n_dims_u,
+                                        0,
+                                        0,
+                                        i_types_s,
+                                        i_types_u,
+                                        i_sizes_s,
+                                        i_strides_s,
+                                        i_strides_u,
+                                        l_m_loops_sizes,
+                                        l_m_loops_strides_s,
+                                        l_m_loops_strides_u );
+
+  // configuration of the N loops
+  int64_t l_num_n_loops = loop_configs( i_n_dims_t,
+                                        i_n_dims_u,
+                                        0,
+                                        1,
+                                        i_types_t,
+                                        i_types_u,
+                                        i_sizes_t,
+                                        i_strides_t,
+                                        i_strides_u,
+                                        l_n_loops_sizes,
+                                        l_n_loops_strides_t,
+                                        l_n_loops_strides_u );
+
+  // configuration of the K loops
+  int64_t l_num_k_loops = loop_configs( i_n_dims_s,
+                                        i_n_dims_t,
+                                        1,
+                                        1,
+                                        i_types_s,
+                                        i_types_t,
+                                        i_sizes_s,
+                                        i_strides_s,
+                                        i_strides_t,
+                                        l_k_loops_sizes,
+                                        l_k_loops_strides_s,
+                                        l_k_loops_strides_t );
+
+  // configuration of the B loops
+  int64_t l_num_b_loops = loop_configs( i_n_dims_s,
+                                        i_n_dims_u,
+                                        2,
+                                        2,
+                                        i_types_s,
+                                        i_types_u,
+                                        i_sizes_s,
+                                        i_strides_s,
+                                        i_strides_u,
+                                        l_b_loops_sizes,
+                                        l_b_loops_strides_s,
+                                        l_b_loops_strides_u );
+
+  int64_t l_num_b_loops_t = filter_attributes( i_n_dims_t,
+                                               2,
+                                               i_types_t,
+                                               i_strides_t,
+                                               l_b_loops_strides_t );
+  assert( l_num_b_loops == l_num_b_loops_t );
+
+  // contractions without M, N or K dimensions (e.g., matrix-vector or outer products) use a GEMM dimension with a single entry
+  if( l_num_m_loops == 0 ) {
+    l_m_loops_sizes[0] = 1;
+    l_num_m_loops = 1;
+  }
+  if( l_num_n_loops == 0 ) {
+    l_n_loops_sizes[0] = 1;
+    l_num_n_loops = 1;
+  }
+  if( l_num_k_loops == 0 ) {
+    l_k_loops_sizes[0] = 1;
+    l_num_k_loops = 1;
+  }
+
+  // strides of the bias
+  m_bias = i_epilogue.strides_bias != nullptr;
+  if( m_bias ) {
+    filter_attributes( i_n_dims_u,
+                       0,
+                       i_types_u,
+                       i_epilogue.strides_bias,
+                       l_m_loops_strides_bias );
+    filter_attributes( i_n_dims_u,
+                       1,
+                       i_types_u,
+                       i_epilogue.strides_bias,
+                       l_n_loops_strides_bias );
+    filter_attributes( i_n_dims_u,
+                       2,
+                       i_types_u,
+                       i_epilogue.strides_bias,
+                       l_b_loops_strides_bias );
+  }
+
+  // block and order the loops
+  std::vector< LoopOptimizer::Loop > l_loops;
+  for( int64_t l_lo = 0; l_lo < l_num_b_loops; l_lo++ ) {
+    l_loops.push_back( { LoopOptimizer::loop_t::b,
+                         l_b_loops_sizes[l_lo],
+                         l_b_loops_strides_s[l_lo],
+                         l_b_loops_strides_t[l_lo],
+                         l_b_loops_strides_u[l_lo],
+                         l_b_loops_strides_bias[l_lo] } );
+  }
+  for( int64_t l_lo = 0; l_lo < l_num_m_loops; l_lo++ ) {
+    l_loops.push_back( { LoopOptimizer::loop_t::m,
+                         l_m_loops_sizes[l_lo],
+                         l_m_loops_strides_s[l_lo],
+                         0,
+                         l_m_loops_strides_u[l_lo],
+                         l_m_loops_strides_bias[l_lo] } );
+  }
+  for( int64_t l_lo = 0; l_lo < l_num_n_loops; l_lo++ ) {
+    l_loops.push_back( { LoopOptimizer::loop_t::n,
+                         l_n_loops_sizes[l_lo],
+                         0,
+                         l_n_loops_strides_t[l_lo],
+                         l_n_loops_strides_u[l_lo],
+                         l_n_loops_strides_bias[l_lo] } );
+  }
+  for( int64_t l_lo = 0; l_lo < l_num_k_loops; l_lo++ ) {
+    l_loops.push_back( { LoopOptimizer::loop_t::k,
+                         l_k_loops_sizes[l_lo],
+                         l_k_loops_strides_s[l_lo],
+                         l_k_loops_strides_t[l_lo],
+                         0,
+                         0 } );
+  }
+
+  // low precision kernels might require A in VNNI format, K blocks have to be multiples of the packing factor
+  int l_vnni = libxsmm_cpuid_dot_pack_factor( dtype_libxsmm( i_dtype_in ) );
+
+  // cache sizes of the system are queried once, sysconf returns 0 or -1 if a size is unknown
+  static int64_t const l_size_l1 = []() {
+    int64_t l_size = sysconf( _SC_LEVEL1_DCACHE_SIZE );
+    return ( l_size > 0 ) ? l_size : (int64_t) 32 * 1024;
+  }();
+  static int64_t const l_size_l2 = []() {
+    int64_t l_size = sysconf( _SC_LEVEL2_CACHE_SIZE );
+    return ( l_size > 0 ) ? l_size : (int64_t) 1024 * 1024;
+  }();
+
+  m_n_threads = ( i_n_threads > 0 ) ? i_n_threads : omp_get_max_threads();
+  LoopOptimizer l_optimizer( m_n_threads,
+                             l_size_l1,
+                             l_size_l2 );
+  l_optimizer.optimize( m_dtype_size_in,
+                        m_dtype_size_out,
+                        l_vnni,
+                        l_loops );
+
+  // the last three loops are covered by the GEMM
+  LoopOptimizer::Loop l_loop_gemm_m = l_loops[ l_loops.size()-3 ];
+  LoopOptimizer::Loop l_loop_gemm_n = l_loops[ l_loops.size()-2 ];
+  LoopOptimizer::Loop l_loop_gemm_k = l_loops[ l_loops.size()-1 ];
+  assert( l_loop_gemm_m.type == LoopOptimizer::loop_t::m );
+  assert( l_loop_gemm_n.type == LoopOptimizer::loop_t::n );
+  assert( l_loop_gemm_k.type == LoopOptimizer::loop_t::k );
+
+  m_num_outer_loops = 0;
+  m_num_k_loops = 0;
+  for( std::size_t l_lo = 0; l_lo < l_loops.size()-3; l_lo++ ) {
+    if( l_loops[l_lo].type == LoopOptimizer::loop_t::k ) {
+      m_k_loops_sizes[m_num_k_loops]     = l_loops[l_lo].size;
+      m_k_loops_strides_s[m_num_k_loops] = l_loops[l_lo].stride_s;
+      m_k_loops_strides_t[m_num_k_loops] = l_loops[l_lo].stride_t;
+      m_num_k_loops++;
+    }
+    else {
+      m_outer_loops_sizes[m_num_outer_loops]        = l_loops[l_lo].size;
+      m_outer_loops_strides_s[m_num_outer_loops]    = l_loops[l_lo].stride_s;
+      m_outer_loops_strides_t[m_num_outer_loops]    = l_loops[l_lo].stride_t;
+      m_outer_loops_strides_u[m_num_outer_loops]    = l_loops[l_lo].stride_u;
+      m_outer_loops_strides_bias[m_num_outer_loops] = l_loops[l_lo].stride_bias;
+      m_num_outer_loops++;
+    }
+  }
+  m_k_loops_sizes[m_num_k_loops]     = l_loop_gemm_k.size;
+  m_k_loops_strides_s[m_num_k_loops] = l_loop_gemm_k.stride_s;
+  m_k_loops_strides_t[m_num_k_loops] = l_loop_gemm_k.stride_t;
+  m_num_k_loops++;
+
+  assert( m_num_outer_loops <= m_max_loops );
+  assert( m_num_k_loops <= m_max_loops );
+
+  // the GEMM covers the last M, N and K loop
+  libxsmm_blasint l_gemm_m = l_loop_gemm_m.size;
+  libxsmm_blasint l_gemm_n = l_loop_gemm_n.size;
+  libxsmm_blasint l_gemm_k = l_loop_gemm_k.size;
+
+  // strides of GEMM dimensions with a single entry are arbitrary, they are set such that the other dimension's layout is kept
+  if( l_gemm_m == 1 ) {
+    l_loop_gemm_m.stride_s = 1;
+    l_loop_gemm_m.stride_u = 1;
+  }
+  if( l_gemm_n == 1 ) {
+    l_loop_gemm_n.stride_t = ( l_loop_gemm_k.stride_t == 1 ) ? l_gemm_k : 1;
+    l_loop_gemm_n.stride_u = l_gemm_m;
+  }
+  if( l_gemm_k == 1 ) {
+    l_loop_gemm_k.stride_s = ( l_loop_gemm_m.stride_s == 1 ) ? l_gemm_m : 1;
+    l_loop_gemm_k.stride_t = ( l_loop_gemm_n.stride_t == 1 ) ? l_gemm_n : 1;
+  }
+
+  // layouts of the GEMM's operands are derived from the strides, unsupported layouts are packed
+  bool l_col_major_a = l_loop_gemm_m.stride_s == 1 && l_loop_gemm_k.stride_s >= l_gemm_m;
+  bool l_row_major_a = l_loop_gemm_k.stride_s == 1 && l_loop_gemm_m.stride_s >= l_gemm_k && !l_col_major_a;
+  bool l_col_major_b = l_loop_gemm_k.stride_t == 1 && l_loop_gemm_n.stride_t >= l_gemm_k;
+  bool l_row_major_b = l_loop_gemm_n.stride_t == 1 && l_loop_gemm_k.stride_t >= l_gemm_n && !l_col_major_b;
+  bool l_col_major_c = l_loop_gemm_m.stride_u == 1 && l_loop_gemm_n.stride_u >= l_gemm_m;
+
+  libxsmm_blasint l_gemm_lda = l_gemm_m;
+  libxsmm_blasint l_gemm_ldb = l_gemm_k;
+  libxsmm_blasint l_gemm_ldc = l_gemm_m;
+
+  char l_trans_a = 'N';
+  char l_trans_b = 'N';
+
+  if(      l_col_major_a ) l_gemm_lda = l_loop_gemm_k.stride_s;
+  else if( l_row_major_a ) {
+    l_gemm_lda = l_loop_gemm_m.stride_s;
+    l_trans_a = 'T';
+  }
+
+  if(      l_col_major_b ) l_gemm_ldb = l_loop_gemm_n.stride_t;
+  else if( l_row_major_b ) {
+    l_gemm_ldb = l_loop_gemm_k.stride_t;
+    l_trans_b = 'T';
+  }
+
+  if( l_col_major_c ) l_gemm_ldc = l_loop_gemm_n.stride_u;
+
+  libxsmm_bitfield l_gemm_flags = LIBXSMM_GEMM_FLAGS( l_trans_a, l_trans_b );
+  libxsmm_bitfield l_gemm_prefetch_flags = 0;
+
+  // copy A blocks to column-major tiles if neither A nor A^T is supported by the kernel
+  m_pack_a_copy = !l_col_major_a && !l_row_major_a;
+  m_pack_a = m_pack_a_copy;
+  m_pack_vnni = nullptr;
+
+  // the kernel's K: an odd K block is padded with zeros to the VNNI packing factor
+  libxsmm_blasint l_gemm_k_pad = l_gemm_k;
+  m_pad_k = 0;
+
+  // pack A blocks for low precision kernels requiring the VNNI format
+  if( l_vnni > 1 ) {
+    assert( l_vnni == 2 );
+    l_gemm_k_pad = ( l_gemm_k + l_vnni - 1 ) / l_vnni * l_vnni;
+    m_pad_k = l_gemm_k_pad - l_gemm_k;
+
+    // A is transposed before the transform if it is row-major, padded A blocks are copied to a zero-padded tile
+    m_pack_a = true;
+    m_pack_a_copy = !l_col_major_a || m_pad_k > 0;
+
+    libxsmm_meltw_unary_shape l_shape_vnni = libxsmm_create_meltw_unary_shape( l_gemm_m,
+                                                                               l_gemm_k_pad,
+                                                                               m_pack_a_copy ? l_gemm_m : l_gemm_lda,
+                                                                               l_gemm_m,
+                                                                               dtype_libxsmm( i_dtype_in ),
+                                                                               dtype_libxsmm( i_dtype_in ),
+                                                                               dtype_libxsmm( i_dtype_in ) );
+    m_pack_vnni = libxsmm_dispatch_meltw_unary_v2( LIBXSMM_MELTW_TYPE_UNARY_TRANSFORM_NORM_TO_VNNI2,
+                                                   l_shape_vnni,
+                                                   LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    assert( m_pack_vnni != nullptr );
+
+    l_gemm_flags |= LIBXSMM_GEMM_FLAG_VNNI_A;
+  }
+
+  if( m_pack_a ) {
+    if( m_pack_a_copy ) {
+      m_packer_a.init( l_gemm_m,
+                       l_gemm_k,
+                       l_loop_gemm_m.stride_s,
+                       l_loop_gemm_k.stride_s,
+                       dtype_libxsmm( i_dtype_in ) );
+    }
+    m_pack_a_block_size = l_gemm_m * l_gemm_k_pad * m_dtype_size_in;
+
+    // the kernel reads packed, column-major A blocks
+    l_gemm_flags &= ~LIBXSMM_GEMM_FLAG_TRANS_A;
+    l_gemm_lda = l_gemm_m;
+  }
+
+  // copy B blocks to column-major tiles if neither B nor B^T is supported by the kernel or K is padded
+  m_pack_b = ( !l_col_major_b && !l_row_major_b ) || m_pad_k > 0;
+  m_pack_b_block_size = 0;
+  m_pack_b_ld = 0;
+  if( m_pack_b ) {
+    m_packer_b.init( l_gemm_k,
+                     l_gemm_n,
+                     l_loop_gemm_k.stride_t,
+                     l_loop_gemm_n.stride_t,
+                     dtype_libxsmm( i_dtype_in ),
+                     l_gemm_k_pad );
+    m_pack_b_block_size = m_packer_b.size();
+    m_pack_b_ld = l_gemm_k_pad * m_dtype_size_in;
+
+    // the kernel reads packed, column-major B blocks
+    l_gemm_flags &= ~LIBXSMM_GEMM_FLAG_TRANS_B;
+    l_gemm_ldb = l_gemm_k_pad;
+  }
+
+  // compute the C block in a column-major tile if U's M dimension doesn't have unit stride
+  m_pack_c = !l_col_major_c;
+  m_zero_u = i_epilogue.zero_u;
+  m_pack_c_load = m_pack_c && !m_zero_u;
+  if( m_pack_c ) {
+    m_packer_c.init( l_gemm_m,
+                     l_gemm_n,
+                     l_loop_gemm_m.stride_u,
+                     l_loop_gemm_n.stride_u,
+                     dtype_libxsmm( i_dtype_out ) );
+  }
+
+  // the first touch of U zeroes the C blocks in place, tiles are zeroed and written back
+  m_zero_c = nullptr;
+  if( !m_pack_c ) {
+    libxsmm_meltw_unary_shape l_shape_zero = libxsmm_create_meltw_unary_shape( l_gemm_m,
+                                                                               l_gemm_n,
+                                                                               l_gemm_ldc,
+                                                                               l_gemm_ldc,
+                                                                               dtype_libxsmm( i_dtype_out ),
+                                                                               dtype_libxsmm( i_dtype_out ),
+                                                                               dtype_libxsmm( i_dtype_out ) );
+    m_zero_c = libxsmm_dispatch_meltw_unary_v2( LIBXSMM_MELTW_TYPE_UNARY_XOR,
+                                                l_shape_zero,
+                                                LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    assert( m_zero_c != nullptr );
+  }
+
+  // beta=0 is applied by the kernel before the reduction starts
+  if( i_epilogue.zero_u ) {
+    l_gemm_flags |= LIBXSMM_GEMM_FLAG_BETA_0;
+  }
+
+  l_gemm_flags |= LIBXSMM_GEMM_FLAG_USE_XGEMM_ABI;
+
+  libxsmm_gemm_shape l_gemm_shape = libxsmm_create_gemm_shape( l_gemm_m,
+                                                               l_gemm_n,
+                                                               l_gemm_k_pad,
+                                                               l_gemm_lda,
+                                                               l_gemm_ldb,
+                                                               l_gemm_ldc,
+                                                               dtype_libxsmm( i_dtype_in ),
+                                                               dtype_libxsmm( i_dtype_in ),
+                                                               dtype_libxsmm( i_dtype_out ),
+                                                               l_dtype_comp );
+
+  // the outer K loops are folded into the kernel through a batch-reduce GEMM
+  m_n_k_iters = 1;
+  for( int64_t l_loop_id_k = 0; l_loop_id_k < m_num_k_loops-1; l_loop_id_k++ ) {
+    m_n_k_iters *= m_k_loops_sizes[l_loop_id_k];
+  }
+
+  // byte offsets of the outer K iterations w.r.t. S and T
+  std::vector< int64_t > l_k_offsets_s( m_n_k_iters );
+  std::vector< int64_t > l_k_offsets_t( m_n_k_iters );
+
+  int64_t l_k_loops_ctrs[m_max_loops] = { 0 };
+  for( int64_t l_it = 0; l_it < m_n_k_iters; l_it++ ) {
+    int64_t l_offset_s = 0;
+    int64_t l_offset_t = 0;
+    for( int64_t l_loop_id_k = 0; l_loop_id_k < m_num_k_loops-1; l_loop_id_k++ ) {
+      l_offset_s += l_k_loops_ctrs[l_loop_id_k] * m_k_loops_strides_s[l_loop_id_k];
+      l_offset_t += l_k_loops_ctrs[l_loop_id_k] * m_k_loops_strides_t[l_loop_id_k];
+    }
+    l_k_offsets_s[l_it] = l_offset_s * m_dtype_size_in;
+    l_k_offsets_t[l_it] = l_offset_t * m_dtype_size_in;
+
+    advance_loop( m_num_k_loops-2,
+                  m_k_loops_sizes,
+                  l_k_loops_ctrs );
+  }
+
+  // number of C blocks, the last M and N loops are covered by the GEMM
+  m_n_blocks = 1;
+  for( int64_t l_loop_id = 0; l_loop_id < m_num_outer_loops; l_loop_id++ ) {
+    m_n_blocks *= m_outer_loops_sizes[l_loop_id];
+  }
+
+  // split-K if the C blocks can't keep all threads busy, the partial C blocks are accumulated in U's datatype
+  m_n_splits = 1;
+  if(    m_n_blocks < m_n_threads
+      && m_n_k_iters > 1
+      && dtype_libxsmm( i_dtype_out ) == l_dtype_comp ) {
+    m_n_splits = std::min( ( m_n_threads + m_n_blocks - 1 ) / m_n_blocks,
+                           m_n_k_iters );
+  }
+
+  // packed blocks are stored one after another
+  if( m_pack_a ) {
+    m_pack_offsets_s = l_k_offsets_s;
+    for( int64_t l_it = 0; l_it < m_n_k_iters; l_it++ ) {
+      l_k_offsets_s[l_it] = l_it * m_pack_a_block_size;
+    }
+  }
+  if( m_pack_b ) {
+    m_pack_offsets_t = l_k_offsets_t;
+    for( int64_t l_it = 0; l_it < m_n_k_iters; l_it++ ) {
+      l_k_offsets_t[l_it] = l_it * m_pack_b_block_size;
+    }
+  }
+
+  libxsmm_gemm_batch_reduce_config l_brgemm_config;
+  l_brgemm_config.br_unroll_hint = 0;
+  l_brgemm_config.br_stride_a_hint = 0;
+  l_brgemm_config.br_stride_b_hint = 0;
+
+  if( m_num_k_loops <= 2 ) {
+    // at most a single outer K loop: constant strides
+    l_brgemm_config.br_type = LIBXSMM_GEMM_BATCH_REDUCE_STRIDE;
+
+    if( m_n_k_iters > 1 ) {
+      l_brgemm_config.br_stride_a_hint = l_k_offsets_s[1];
+      l_brgemm_config.br_stride_b_hint = l_k_offsets_t[1];
+    }
+  }
+  else {
+    // multiple outer K loops: precomputed offsets
+    l_brgemm_config.br_type = LIBXSMM_GEMM_BATCH_REDUCE_OFFSET;
+  }
+
+  // the offsets are also used by the split-K kernel, which starts at arbitrary K iterations
+  m_br_offsets_a.resize( 0 );
+  m_br_offsets_b.resize( 0 );
+  if( l_brgemm_config.br_type == LIBXSMM_GEMM_BATCH_REDUCE_OFFSET || m_n_splits > 1 ) {
+    m_br_offsets_a.assign( l_k_offsets_s.begin(), l_k_offsets_s.end() );
+    m_br_offsets_b.assign( l_k_offsets_t.begin(), l_k_offsets_t.end() );
+  }
+
+  m_gemm = libxsmm_dispatch_brgemm_v2( l_gemm_shape,
+                                       l_gemm_flags,
+                                       l_gemm_prefetch_flags,
+                                       l_brgemm_config );
+
+  // split-K: partial C blocks are column-major tiles, they are reduced and stored in U afterwards
+  m_gemm_split = nullptr;
+  m_split_add = nullptr;
+  m_split_store = nullptr;
+  m_split_store_add = nullptr;
+  m_split_tile_size = 0;
+  if( m_n_splits > 1 ) {
+    m_split_tile_size = l_gemm_m * l_gemm_n * m_dtype_size_out;
+
+    libxsmm_gemm_shape l_shape_split = libxsmm_create_gemm_shape( l_gemm_m,
+                                                                  l_gemm_n,
+                                                                  l_gemm_k_pad,
+                                                                  l_gemm_lda,
+                                                                  l_gemm_ldb,
+                                                                  l_gemm_m,
+                                                                  dtype_libxsmm( i_dtype_in ),
+                                                                  dtype_libxsmm( i_dtype_in ),
+                                                                  dtype_libxsmm( i_dtype_out ),
+                                                                  l_dtype_comp );
+
+    libxsmm_gemm_batch_reduce_config l_brgemm_config_split = l_brgemm_config;
+    l_brgemm_config_split.br_type = LIBXSMM_GEMM_BATCH_REDUCE_OFFSET;
+    l_brgemm_config_split.br_stride_a_hint = 0;
+    l_brgemm_config_split.br_stride_b_hint = 0;
+
+    m_gemm_split = libxsmm_dispatch_brgemm_v2( l_shape_split,
+                                               l_gemm_flags | LIBXSMM_GEMM_FLAG_BETA_0,
+                                               l_gemm_prefetch_flags,
+                                               l_brgemm_config_split );
+    assert( m_gemm_split != nullptr );
+
+    libxsmm_meltw_binary_shape l_shape_add = libxsmm_create_meltw_binary_shape( l_gemm_m,
+                                                                                l_gemm_n,
+                                                                                l_gemm_m,
+                                                                                l_gemm_m,
+                                                                                l_gemm_m,
+                                                                                l_dtype_comp,
+                                                                                l_dtype_comp,
+                                                                                l_dtype_comp,
+                                                                                l_dtype_comp );
+    m_split_add = libxsmm_dispatch_meltw_binary_v2( LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                                    l_shape_add,
+                                                    LIBXSMM_MELTW_FLAG_BINARY_NONE );
+    assert( m_split_add != nullptr );
+
+    if( !m_pack_c ) {
+      libxsmm_meltw_unary_shape l_shape_store = libxsmm_create_meltw_unary_shape( l_gemm_m,
+                                                                                  l_gemm_n,
+                                                                                  l_gemm_m,
+                                                                                  l_gemm_ldc,
+                                                                                  l_dtype_comp,
+                                                                                  l_dtype_comp,
+                                                                                  l_dtype_comp );
+      m_split_store = libxsmm_dispatch_meltw_unary_v2( LIBXSMM_MELTW_TYPE_UNARY_IDENTITY,
+                                                       l_shape_store,
+                                                       LIBXSMM_MELTW_FLAG_UNARY_NONE );
+      assert( m_split_store != nullptr );
+
+      libxsmm_meltw_binary_shape l_shape_store_add = libxsmm_create_meltw_binary_shape( l_gemm_m,
+                                                                                        l_gemm_n,
+                                                                                        l_gemm_ldc,
+                                                                                        l_gemm_m,
+                                                                                        l_gemm_ldc,
+                                                                                        l_dtype_comp,
+                                                                                        l_dtype_comp,
+                                                                                        l_dtype_comp,
+                                                                                        l_dtype_comp );
+      m_split_store_add = libxsmm_dispatch_meltw_binary_v2( LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                                            l_shape_store_add,
+                                                            LIBXSMM_MELTW_FLAG_BINARY_NONE );
+      assert( m_split_store_add != nullptr );
+    }
+  }
+
+  // epilogue kernels operating in-place on a C block
+  libxsmm_datatype l_dtype_out = dtype_libxsmm( i_dtype_out );
+  m_epi_scale = nullptr;
+  m_epi_bias = nullptr;
+  m_epi_act = nullptr;
+
+  if( i_epilogue.alpha != 1.0 ) {
+    // convert the scaling factor to U's datatype
+    m_alpha.resize( m_dtype_size_out );
+    double l_alpha_f64 = i_epilogue.alpha;
+    float  l_alpha_f32 = i_epilogue.alpha;
+
+    libxsmm_meltw_unary_shape l_shape_cvt = libxsmm_create_meltw_unary_shape( 1,
+                                                                              1,
+                                                                              1,
+                                                                              1,
+                                                                              l_dtype_comp,
+                                                                              l_dtype_out,
+                                                                              l_dtype_comp );
+    libxsmm_meltwfunction_unary l_cvt = libxsmm_dispatch_meltw_unary_v2( LIBXSMM_MELTW_TYPE_UNARY_IDENTITY,
+                                                                         l_shape_cvt,
+                                                                         LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    assert( l_cvt != nullptr );
+
+    libxsmm_meltw_unary_param l_param_cvt;
+    l_param_cvt.in.primary = ( l_dtype_comp == LIBXSMM_DATATYPE_F64 ) ? (void *) &l_alpha_f64 : (void *) &l_alpha_f32;
+    l_param_cvt.out.primary = m_alpha.data();
+    l_cvt( &l_param_cvt );
+
+    libxsmm_meltw_binary_shape l_shape_scale = libxsmm_create_meltw_binary_shape( l_gemm_m,
+                                                                                  l_gemm_n,
+                                                                                  l_gemm_ldc,
+                                                                                  1,
+                                                                                  l_gemm_ldc,
+                                                                                  l_dtype_out,
+                                                                                  l_dtype_out,
+                                                                                  l_dtype_out,
+                                                                                  l_dtype_comp );
+    m_epi_scale = libxsmm_dispatch_meltw_binary_v2( LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                                    l_shape_scale,
+                                                    LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+    assert( m_epi_scale != nullptr );
+  }
+
+  if( m_bias ) {
+    // the bias' block is a column vector, a row vector, a scalar or a matrix
+    int64_t l_bias_stride_m = l_loop_gemm_m.stride_bias;
+    int64_t l_bias_stride_n = l_loop_gemm_n.stride_bias;
+
+    libxsmm_bitfield l_bias_flags = LIBXSMM_MELTW_FLAG_BINARY_NONE;
+    libxsmm_blasint l_bias_ld = l_gemm_m;
+
+    if(      l_bias_stride_m == 1 && l_bias_stride_n == 0 ) l_bias_flags = LIBXSMM_MELTW_FLAG_BINARY_BCAST_COL_IN_1;
+    else if( l_bias_stride_m == 0 && l_bias_stride_n == 1 ) l_bias_flags = LIBXSMM_MELTW_FLAG_BINARY_BCAST_ROW_IN_1;
+    else if( l_bias_stride_m == 0 && l_bias_stride_n == 0 ) l_bias_flags = LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1;
+    else {
+      assert( l_bias_stride_m == 1 );
+      l_bias_ld = l_bias_stride_n;
+    }
+
+    libxsmm_meltw_binary_shape l_shape_bias = libxsmm_create_meltw_binary_shape( l_gemm_m,
+                                                                                 l_gemm_n,
+                                                                                 l_gemm_ldc,
+                                                                                 l_bias_ld,
+                                                                                 l_gemm_ldc,
+                                                                                 l_dtype_out,
+                                                                                 l_dtype_out,
+                                                                                 l_dtype_out,
+                                                                                 l_dtype_comp );
+    m_epi_bias = libxsmm_dispatch_meltw_binary_v2( LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                                   l_shape_bias,
+                                                   l_bias_flags );
+    assert( m_epi_bias != nullptr );
+  }
+
+  if( i_epilogue.act != act_t::none ) {
+    libxsmm_meltw_unary_type l_act_type = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+    if( i_epilogue.act == act_t::gelu ) {
+      l_act_type = LIBXSMM_MELTW_TYPE_UNARY_GELU;
+    }
+
+    libxsmm_meltw_unary_shape l_shape_act = libxsmm_create_meltw_unary_shape( l_gemm_m,
+                                                                              l_gemm_n,
+                                                                              l_gemm_ldc,
+                                                                              l_gemm_ldc,
+                                                                              l_dtype_out,
+                                                                              l_dtype_out,
+                                                                              l_dtype_comp );
+    m_epi_act = libxsmm_dispatch_meltw_unary_v2( l_act_type,
+                                                 l_shape_act,
+                                                 LIBXSMM_MELTW_FLAG_UNARY_NONE );
+    assert( m_epi_act != nullptr );
+  }
+}
+
+template< typename T >
+void tpp_nets::backend::ContractionPlan::parallel( ThreadPool * io_pool,
+                                                   T    const & i_fn ) const {
+  if( io_pool != nullptr ) {
+    int64_t l_n_threads = io_pool->n_threads();
+    io_pool->run( [&]( int64_t i_tid ) {
+      i_fn( i_tid,
+            l_n_threads );
+    } );
+  }
+  else {
+    // the team might be smaller than requested, e.g., in nested regions or with OMP_DYNAMIC
+#pragma omp parallel num_threads( m_n_threads )
+    {
+      i_fn( omp_get_thread_num(),
+            omp_get_num_threads() );
+    }
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::barrier( ThreadPool * io_pool ) {
+  if( io_pool != nullptr ) {
+    io_pool->barrier();
+  }
+  else {
+#pragma omp barrier
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::execute( void const * i_s,
+                                                  void const * i_t,
+                                                  void       * o_u,
+                                                  void const * i_bias,
+                                                  double     * io_busy,
+                                                  ThreadPool * io_pool ) const {
+  if( m_n_splits > 1 ) {
+    execute_split( i_s,
+                   i_t,
+                   o_u,
+                   i_bias,
+                   io_busy,
+                   io_pool );
+    return;
+  }
+
+  // the batch (B) loops and the free (M and N) outer loops are collapsed into a single iteration space of C blocks,
+  // every thread starts with its own contiguous range of blocks and steals chunks of the other ranges once it's done
+  int64_t l_n_threads = ( io_pool != nullptr ) ? io_pool->n_threads() : m_n_threads;
+  BlockScheduler l_scheduler( l_n_threads,
+                              m_n_blocks );
+
+  parallel( io_pool,
+            [&]( int64_t i_tid,
+                 int64_t ) {
+    double l_time_start = ( io_busy != nullptr ) ? omp_get_wtime() : 0;
+
+    int64_t l_first = 0;
+    int64_t l_last = 0;
+    while( l_scheduler.next( i_tid,
+                             l_first,
+                             l_last ) ) {
+      execute_blocks( i_s,
+                      i_t,
+                      o_u,
+                      i_bias,
+                      l_first,
+                      l_last );
+    }
+
+    if( io_busy != nullptr ) {
+      io_busy[i_tid] += omp_get_wtime() - l_time_start;
+    }
+  } );
+}
+
+void tpp_nets::backend::ContractionPlan::block_range( int64_t   i_tid,
+                                                      int64_t & o_first,
+                                                      int64_t & o_last ) const {
+  assert( 0 <= i_tid && i_tid < m_n_threads );
+
+  o_first = m_n_blocks * i_tid / m_n_threads;
+  o_last  = m_n_blocks * ( i_tid + 1 ) / m_n_threads;
+}
+
+void tpp_nets::backend::ContractionPlan::first_touch( void       * o_u,
+                                                      ThreadPool * io_pool ) const {
+  assert( m_gemm != nullptr );
+
+  // same initial ranges as the scheduler of execute if the team has the expected size,
+  // smaller teams (e.g., in nested regions) still touch all blocks
+  parallel( io_pool,
+            [&]( int64_t i_tid,
+                 int64_t i_n_threads ) {
+    int64_t l_first = m_n_blocks * i_tid / i_n_threads;
+    int64_t l_last  = m_n_blocks * ( i_tid + 1 ) / i_n_threads;
+
+    thread_local std::vector< char > l_zero_c;
+    if( m_pack_c ) l_zero_c.assign( m_packer_c.size(), 0 );
+
+    for( int64_t l_bl = l_first; l_bl < l_last; l_bl++ ) {
+      int64_t l_offset_s = 0;
+      int64_t l_offset_t = 0;
+      int64_t l_offset_u = 0;
+      int64_t l_offset_bias = 0;
+      block_offsets( l_bl,
+                     l_offset_s,
+                     l_offset_t,
+                     l_offset_u,
+                     l_offset_bias );
+      char * l_block_u = (char *) o_u + l_offset_u * m_dtype_size_out;
+
+      if( m_pack_c ) {
+        m_packer_c.unpack( l_zero_c.data(),
+                           l_block_u );
+      }
+      else {
+        libxsmm_meltw_unary_param l_param_zero;
+        l_param_zero.in.primary = l_block_u;
+        l_param_zero.out.primary = l_block_u;
+        m_zero_c( &l_param_zero );
+      }
+    }
+  } );
+}
+
+void tpp_nets::backend::ContractionPlan::execute_blocks( void const * i_s,
+                                                         void const * i_t,
+                                                         void       * o_u,
+                                                         void const * i_bias,
+                                                         int64_t      i_first,
+                                                         int64_t      i_last ) const {
+  assert( m_gemm != nullptr );
+  assert( !m_bias || i_bias != nullptr );
+  assert( 0 <= i_first && i_last <= m_n_blocks );
+
+  if( m_swap_operands ) {
+    std::swap( i_s, i_t );
+  }
+
+  // packed blocks and scratch of the thread
+  thread_local std::vector< char > l_packed_a;
+  thread_local std::vector< char > l_packed_b;
+  thread_local std::vector< char > l_packed_c;
+  if( m_pack_a ) l_packed_a.resize( ( m_n_k_iters + 1 ) * m_pack_a_block_size );
+  if( m_pack_b ) l_packed_b.resize( m_n_k_iters * m_pack_b_block_size );
+  if( m_pack_c ) l_packed_c.resize( m_packer_c.size() );
+
+  // offsets of the packed blocks, the blocks are reused if the offsets don't change
+  int64_t l_packed_offset_s = -1;
+  int64_t l_packed_offset_t = -1;
+
+  // the K loops of each block are covered by a single call of the batch-reduce kernel
+  for( int64_t l_bl = i_first; l_bl < i_last; l_bl++ ) {
+    int64_t l_offset_s = 0;
+    int64_t l_offset_t = 0;
+    int64_t l_offset_u = 0;
+    int64_t l_offset_bias = 0;
+    block_offsets( l_bl,
+                   l_offset_s,
+                   l_offset_t,
+                   l_offset_u,
+                   l_offset_bias );
+
+    // K loops, executed sequentially by the batch-reduce kernel
+    unsigned long long l_n_k_iters = m_n_k_iters;
+
+    libxsmm_gemm_param l_param;
+    l_param.op.tertiary = &l_n_k_iters;
+    l_param.a.primary = (char *) i_s + l_offset_s * m_dtype_size_in;
+    l_param.b.primary = (char *) i_t + l_offset_t * m_dtype_size_in;
+    l_param.c.primary = (char *) o_u + l_offset_u * m_dtype_size_out;
+    l_param.a.secondary = (void *) m_br_offsets_a.data();
+    l_param.b.secondary = (void *) m_br_offsets_b.data();
+
+    if( m_pack_a ) {
+      if( l_offset_s != l_packed_offset_s ) {
+        pack_a( (char const *) l_param.a.primary,
+                0,
+                m_n_k_iters,
+                l_packed_a.data() );
+        l_packed_offset_s = l_offset_s;
+      }
+      l_param.a.primary = l_packed_a.data();
+    }
+
+    if( m_pack_b ) {
+      if( l_offset_t != l_packed_offset_t ) {
+        pack_b( (char const *) l_param.b.primary,
+                0,
+                m_n_k_iters,
+                l_packed_b.data() );
+        l_packed_offset_t = l_offset_t;
+      }
+      l_param.b.primary = l_packed_b.data();
+    }
+
+    void * l_block_u = l_param.c.primary;
+    if( m_pack_c ) {
+      if( m_pack_c_load ) {
+        m_packer_c.pack( l_block_u,
+                         l_packed_c.data() );
+      }
+      l_param.c.primary = l_packed_c.data();
+    }
+
+    m_gemm( &l_param );
+
+    // epilogue on the hot C block
+    epilogue( l_param.c.primary,
+              (char const *) i_bias + l_offset_bias * m_dtype_size_out );
+
+    if( m_pack_c ) {
+      m_packer_c.unpack( l_packed_c.data(),
+                         l_block_u );
+    }
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::block_offsets( int64_t   i_bl,
+                                                        int64_t & o_offset_s,
+                                                        int64_t & o_offset_t,
+                                                        int64_t & o_offset_u,
+                                                        int64_t & o_offset_bias ) const {
+  o_offset_s = 0;
+  o_offset_t = 0;
+  o_offset_u = 0;
+  o_offset_bias = 0;
+
+  // derive counters of the outer loops, the last loop is the fastest
+  int64_t l_id = i_bl;
+  for( int64_t l_loop_id = m_num_outer_loops-1; l_loop_id >= 0; l_loop_id-- ) {
+    int64_t l_ctr = l_id % m_outer_loops_sizes[l_loop_id];
+    l_id /= m_outer_loops_sizes[l_loop_id];
+
+    o_offset_s    += l_ctr * m_outer_loops_strides_s[l_loop_id];
+    o_offset_t    += l_ctr * m_outer_loops_strides_t[l_loop_id];
+    o_offset_u    += l_ctr * m_outer_loops_strides_u[l_loop_id];
+    o_offset_bias += l_ctr * m_outer_loops_strides_bias[l_loop_id];
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::epilogue( void       * io_c,
+                                                   void const * i_bias ) const {
+  if( m_epi_scale != nullptr ) {
+    libxsmm_meltw_binary_param l_param_scale;
+    l_param_scale.in0.primary = io_c;
+    l_param_scale.in1.primary = (void *) m_alpha.data();
+    l_param_scale.out.primary = io_c;
+    m_epi_scale( &l_param_scale );
+  }
+  if( m_epi_bias != nullptr ) {
+    libxsmm_meltw_binary_param l_param_bias;
+    l_param_bias.in0.primary = io_c;
+    l_param_bias.in1.primary = (void *) i_bias;
+    l_param_bias.out.primary = io_c;
+    m_epi_bias( &l_param_bias );
+  }
+  if( m_epi_act != nullptr ) {
+    libxsmm_meltw_unary_param l_param_act;
+    l_param_act.in.primary = io_c;
+    l_param_act.out.primary = io_c;
+    m_epi_act( &l_param_act );
+  }
+}
+
+void tpp_nets::backend::ContractionPlan::execute_split( void const * i_s,
+                                                        void const * i_t,
+                                                        void       * o_u,
+                                                        void const * i_bias,
+                                                        double     * io_busy,
+                                                        ThreadPool * io_pool ) const {
+  assert( m_gemm_split != nullptr );
+  assert( !m_bias || i_bias != nullptr );
+
+  if( m_swap_operands ) {
+    std::swap( i_s, i_t );
+  }
+
+  // partial C blocks of the calling thread, shared by the team: block-major, i.e., the partial blocks of a C block are adjacent
+  thread_local std::vector< char > l_partials;
+  l_partials.resize( m_n_blocks * m_n_splits * m_split_tile_size );
+  char * l_partials_data = l_partials.data();
+
+  // the work is partitioned by the team's actual size since the partial blocks of missing threads would never be computed
+  parallel( io_pool,
+            [&]( int64_t i_tid,
+                 int64_t i_n_threads ) {
+    double l_time_start = ( io_busy != nullptr ) ? omp_get_wtime() : 0;
+
+    thread_local std::vector< char > l_packed_a;
+    thread_local std::vector< char > l_packed_b;
+    thread_local std::vector< char > l_packed_c;
+    if( m_pack_a ) l_packed_a.resize( ( m_n_k_iters + 1 ) * m_pack_a_block_size );
+    if( m_pack_b ) l_packed_b.resize( m_n_k_iters * m_pack_b_block_size );
+    if( m_pack_c ) l_packed_c.resize( m_packer_c.size() );
+
+    // 1) partial C blocks: contiguous ranges of (C block, K range) items per thread
+    int64_t l_n_items = m_n_blocks * m_n_splits;
+    for( int64_t l_it = l_n_items * i_tid / i_n_threads; l_it < l_n_items * ( i_tid + 1 ) / i_n_threads; l_it++ ) {
+      int64_t l_bl = l_it / m_n_splits;
+      int64_t l_sp = l_it % m_n_splits;
+      int64_t l_first_iter = m_n_k_iters * l_sp / m_n_splits;
+      int64_t l_last_iter  = m_n_k_iters * ( l_sp + 1 ) / m_n_splits;
+
+      int64_t l_offset_s = 0;
+      int64_t l_offset_t = 0;
+      int64_t l_offset_u = 0;
+      int64_t l_offset_bias = 0;
+      block_offsets( l_bl,
+                     l_offset_s,
+                     l_offset_t,
+                     l_offset_u,
+                     l_offset_bias );
+
+      unsigned long long l_n_k_iters = l_last_iter - l_first_iter;
+
+      libxsmm_gemm_param l_param;
+      l_param.op.tertiary = &l_n_k_iters;
+      l_param.a.primary = (char *) i_s + l_offset_s * m_dtype_size_in;
+      l_param.b.primary = (char *) i_t + l_offset_t * m_dtype_size_in;
+      l_param.c.primary = l_partials_data + l_it * m_split_tile_size;
+      l_param.a.secondary = (void *) ( m_br_offsets_a.data() + l_first_iter );
+      l_param.b.secondary = (void *) ( m_br_offsets_b.data() + l_first_iter );
+
+      if( m_pack_a ) {
+        pack_a( (char const *) l_param.a.primary,
+                l_first_iter,
+                l_last_iter,
+                l_packed_a.data() );
+        l_param.a.primary = l_packed_a.data();
+      }
+      if( m_pack_b ) {
+        pack_b( (char const *) l_param.b.primary,
+                l_first_iter,
+                l_last_iter,
+                l_packed_b.data() );
+        l_param.b.primary = l_packed_b.data();
+      }
+
+      m_gemm_split( &l_param );
+    }
+
+    barrier( io_pool );
+
+    // 2) reduction of the partial C blocks, storage in U and epilogue
+    for( int64_t l_bl = m_n_blocks * i_tid / i_n_threads; l_bl < m_n_blocks * ( i_tid + 1 ) / i_n_threads; l_bl++ ) {
+      int64_t l_offset_s = 0;
+      int64_t l_offset_t = 0;
+      int64_t l_offset_u = 0;
+      int64_t l_offset_bias = 0;
+      block_offsets( l_bl,
+                     l_offset_s,
+                     l_offset_t,
+                     l_offset_u,
+                     l_offset_bias );
+
+      char * l_block_u = (char *) o_u + l_offset_u * m_dtype_size_out;
+      char * l_partial = l_partials_data + l_bl * m_n_splits * m_split_tile_size;
+
+      libxsmm_meltw_binary_param l_param_add;
+      for( int64_t l_sp = 1; l_sp < m_n_splits; l_sp++ ) {
+        l_param_add.in0.primary = l_partial;
+        l_param_add.in1.primary = l_partial + l_sp * m_split_tile_size;
+        l_param_add.out.primary = l_partial;
+        m_split_add( &l_param_add );
+      }
+
+      void * l_block_c = l_block_u;
+      if( m_pack_c ) {
+        // the C block is finished in a tile which is written back to U
+        l_block_c = l_partial;
+        if( m_pack_c_load ) {
+          m_packer_c.pack( l_block_u,
+                           l_packed_c.data() );
+
+          l_param_add.in0.primary = l_packed_c.data();
+          l_param_add.in1.primary = l_partial;
+          l_param_add.out.primary = l_packed_c.data();
+          m_split_add( &l_param_add );
+          l_block_c = l_packed_c.data();
+        }
+      }
+      else if( !m_zero_u ) {
+        libxsmm_meltw_binary_param l_param_store;
+        l_param_store.in0.primary = l_block_u;
+        l_param_store.in1.primary = l_partial;
+        l_param_store.out.primary = l_block_u;
+        m_split_store_add( &l_param_store );
+      }
+      else {
+        libxsmm_meltw_unary_param l_param_store;
+        l_param_store.in.primary = l_partial;
+        l_param_store.out.primary = l_block_u;
+        m_split_store( &l_param_store );
+      }
+
+      epilogue( l_block_c,
+                (char const *) i_bias + l_offset_bias * m_dtype_size_out );
+
+      if( m_pack_c ) {
+        m_packer_c.unpack( l_block_c,
+                           l_block_u );
+      }
+    }
+
+    if( io_busy != nullptr ) {
+      io_busy[i_tid] += omp_get_wtime() - l_time_start;
+    }
+  } );
+}
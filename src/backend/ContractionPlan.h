@@ -0,0 +1,452 @@
+#ifndef TPP_NETS_BACKEND_CONTRACTION_PLAN
+#define TPP_NETS_BACKEND_CONTRACTION_PLAN
+
+#include <cstdint>
+#include <vector>
+#include <libxsmm.h>
+#include "DataType.h"
+#include "Epilogue.h"
+#include "ThreadPool.h"
+#include "TilePacker.h"
+
+namespace tpp_nets {
+  namespace backend {
+    class ContractionPlan;
+  }
+}
+
+/**
+ * Plan of a binary tensor contraction.
+ *
+ * All shape-dependent work (selection of the GEMM case, JIT-compilation of the LIBXSMM kernel,
+ * derivation of the loop configurations) is done once in init.
+ * Afterwards, execute only runs the loop nest and calls the kernel.
+ *
+ * The loop nest is blocked and ordered by the LoopOptimizer's cost model.
+ * The B loops and the outer M and N loops are collapsed and parallelized through OpenMP or a persistent ThreadPool.
+ * The B loops are the slowest in the collapsed iteration space, i.e., batches are distributed first.
+ * If U's fastest dimension (smallest stride) has type N, S and T swap roles and the plan computes C^T = B^T A^T.
+ * The K loops of a C block are folded into a single call of a LIBXSMM batch-reduce GEMM,
+ * i.e., the C block stays in registers while reducing over K.
+ *
+ * Operands don't have to be contiguous.
+ * If the GEMM's dimensions of A or B don't have a unit stride, the blocks consumed by a C block are packed
+ * into thread-local column-major tiles right before the kernel is called.
+ * A packed block is reused by the thread's following C blocks as long as the outer loops don't change it.
+ * A C block without unit stride is computed in a tile which is written back to U after the epilogue.
+ *
+ * BF16 and FP16 inputs are accumulated in FP32.
+ * If the target's dot-product instructions require it, the A blocks are packed to the VNNI format.
+ * A K block which isn't a multiple of the VNNI packing factor is padded with zeros in the packed A and B blocks.
+ *
+ * The initialization of U (beta=0) is fused into the kernel,
+ * the epilogue (scaling, bias, activation) is applied through eltwise TPPs while the C block is hot.
+ *
+ * If there are fewer C blocks than threads and U's datatype is the accumulation datatype,
+ * the outer K iterations are split into ranges (split-K).
+ * Every range is reduced into a private, partial C block, the partial blocks are summed up and stored in U afterwards.
+ **/
+class tpp_nets::backend::ContractionPlan {
+    static constexpr int64_t m_max_loops = 25;
+
+    //! true if the roles of S and T are swapped to support row-major C (N is U's fastest dimension)
+    bool m_swap_operands = false;
+
+    //! size of a single element of S and T in bytes
+    int64_t m_dtype_size_in = 0;
+    //! size of a single element of U in bytes
+    int64_t m_dtype_size_out = 0;
+
+    //! LIBXSMM batch-reduce kernel covering all K loops of a C block
+    libxsmm_gemmfunction m_gemm = nullptr;
+
+    //! number of iterations of the outer K loops, i.e., the batch-reduce count
+    int64_t m_n_k_iters = 0;
+
+    //! offsets (in bytes) of the batch-reduce's A blocks, used if there is more than one outer K loop
+    std::vector< unsigned long long > m_br_offsets_a;
+    //! offsets (in bytes) of the batch-reduce's B blocks, used if there is more than one outer K loop
+    std::vector< unsigned long long > m_br_offsets_b;
+
+    //! true if the A blocks are packed before calling the kernel
+    bool m_pack_a = false;
+    //! true if the A blocks are copied to column-major tiles, i.e., S's strides aren't supported by the kernel
+    bool m_pack_a_copy = false;
+    //! size (in bytes) of a single packed A block
+    int64_t m_pack_a_block_size = 0;
+    //! offsets (in bytes) of S's blocks which are packed
+    std::vector< int64_t > m_pack_offsets_s;
+    //! copies an A block to a column-major tile
+    TilePacker m_packer_a;
+    //! kernel which transforms an A block to the VNNI format, nullptr if not required
+    libxsmm_meltwfunction_unary m_pack_vnni = nullptr;
+
+    //! true if the B blocks are copied to column-major tiles before calling the kernel
+    bool m_pack_b = false;
+    //! offsets (in bytes) of T's blocks which are packed
+    std::vector< int64_t > m_pack_offsets_t;
+    //! copies a B block to a column-major tile
+    TilePacker m_packer_b;
+    //! size (in bytes) of a single packed B block
+    int64_t m_pack_b_block_size = 0;
+    //! leading dimension (in bytes) of the packed B blocks
+    int64_t m_pack_b_ld = 0;
+
+    //! number of zero entries which pad the K dimension of the packed A and B blocks to the VNNI packing factor
+    int64_t m_pad_k = 0;
+
+    //! true if the C block is computed in a column-major tile which is written back to U
+    bool m_pack_c = false;
+    //! true if U is loaded into the tile before the contraction, i.e., U is accumulated into
+    bool m_pack_c_load = false;
+    //! true if U is overwritten, false if the contraction is accumulated into U
+    bool m_zero_u = false;
+    //! copies a C block from U to a column-major tile and back
+    TilePacker m_packer_c;
+
+    //! scaling factor in U's datatype, used by the epilogue's scaling kernel
+    std::vector< char > m_alpha;
+    //! true if a bias is added in the epilogue
+    bool m_bias = false;
+    //! epilogue kernel scaling the C block, nullptr if not required
+    libxsmm_meltwfunction_binary m_epi_scale = nullptr;
+    //! epilogue kernel adding the bias to the C block, nullptr if not required
+    libxsmm_meltwfunction_binary m_epi_bias = nullptr;
+    //! epilogue kernel applying the activation function to the C block, nullptr if not required
+    libxsmm_meltwfunction_unary m_epi_act = nullptr;
+
+    //! number of outer loops, i.e., B loops and the M and N loops which are not covered by the GEMM
+    int64_t m_num_outer_loops = 0;
+    //! number of K loops
+    int64_t m_num_k_loops = 0;
+
+    //! number of C blocks, i.e., iterations of the outer loops
+    int64_t m_n_blocks = 0;
+
+    //! number of threads executing the plan, every thread owns a fixed, contiguous range of C blocks
+    int64_t m_n_threads = 1;
+
+    //! kernel zeroing a C block in U, used for the first touch of U if the C block isn't computed in a tile
+    libxsmm_meltwfunction_unary m_zero_c = nullptr;
+
+    //! number of ranges of K iterations computed independently (split-K), one if the K iterations aren't split
+    int64_t m_n_splits = 1;
+    //! size (in bytes) of a partial C block, i.e., a column-major tile in U's datatype
+    int64_t m_split_tile_size = 0;
+    //! batch-reduce kernel computing a partial C block of a range of K iterations in a tile (beta=0)
+    libxsmm_gemmfunction m_gemm_split = nullptr;
+    //! kernel adding a partial C block to another tile
+    libxsmm_meltwfunction_binary m_split_add = nullptr;
+    //! kernel copying the reduced C block to U, used if the C block isn't computed in a tile
+    libxsmm_meltwfunction_unary m_split_store = nullptr;
+    //! kernel adding the reduced C block to U, used if the C block isn't computed in a tile
+    libxsmm_meltwfunction_binary m_split_store_add = nullptr;
+
+    //! configuration of the outer loops, the first loop is the slowest
+    int64_t m_outer_loops_sizes[m_max_loops]        = { 0 };
+    int64_t m_outer_loops_strides_s[m_max_loops]    = { 0 };
+    int64_t m_outer_loops_strides_t[m_max_loops]    = { 0 };
+    int64_t m_outer_loops_strides_u[m_max_loops]    = { 0 };
+    int64_t m_outer_loops_strides_bias[m_max_loops] = { 0 };
+
+    //! configuration of the K loops, the last K loop is covered by the GEMM
+    int64_t m_k_loops_sizes[m_max_loops]     = { 0 };
+    int64_t m_k_loops_strides_s[m_max_loops] = { 0 };
+    int64_t m_k_loops_strides_t[m_max_loops] = { 0 };
+
+    /**
+     * Filters an array based on the elements' type.
+     *
+     * Given an array with i_size element.
+     * Each element has a type (i_types) and a attribute (i_attributes).
+     *
+     * The routine iterates from [0, i_size-1] through the array.
+     * Whenever the the of an element matches i_type_filter,
+     * the elements' attribute is copied over to o_attribute.
+     *
+     * Copy operations to o_attribute start at position 0.
+     * The position is incremented after every copy operation.
+     *
+     * @param i_size size of the input array holding elements with a type and attribute.
+     * @param i_type_filter type which is filtered.
+     * @param i_types types of the array's elements.
+     * @param i_attributes attributes of the array's elements.
+     * @param o_attributes will be set to filtered attributes.
+     * @return number copy operations, i.e., number of times the filtered type occurred in the input.
+     **/
+    static int64_t filter_attributes( int64_t         i_size,
+                                      int8_t          i_type_filter,
+                                      int8_t  const * i_types,
+                                      int64_t const * i_attributes,
+                                      int64_t       * o_attributes );
+    /**
+     * Derives the configuration of loops iterating over dimension in a binary tensor contraction.
+     *
+     * @param i_n_dims_a number of dimensions of A.
+     * @param i_n_dims_b number of dimensions of B.
+     * @param i_types_a types of A's dimensions.
+     * @param i_types_b types of B's dimensions.
+     * @param i_sizes_a sizes of A's dimensions.
+     * @param i_strides_a strides of A's dimensions.
+     * @param i_strides_b strides of B's dimensions.
+     * @param o_loops_sizes will be set to sizes of the resulting loops.
+     * @param o_loops_strides_a will be set to strides of the resulting loops w.r.t. A.
+     * @param o_loops_strides_b will be set to strides of the resulting loops w.r.t. B.
+     * @return number of loops.
+     **/
+    static int64_t loop_configs( int64_t         i_n_dims_a,
+                                 int64_t         i_n_dims_b,
+                                 int8_t          i_type_filter_a,
+                                 int8_t          i_type_filter_b,
+                                 int8_t  const * i_types_a,
+                                 int8_t  const * i_types_b,
+                                 int64_t const * i_sizes_a,
+                                 int64_t const * i_strides_a,
+                                 int64_t const * i_strides_b,
+                                 int64_t       * o_loops_sizes,
+                                 int64_t       * o_loops_strides_a,
+                                 int64_t       * o_loops_strides_b );
+
+    /**
+     * Advance the given loops if possible.
+     * If not the loop counters are set to zero.
+     *
+     * @param i_num_loops number of loops.
+     * @param i_sizes sizes of the loops.
+     * @param io_counters loop counters.
+     * @return true if the counter have been set to zero, false otherwise.
+     **/
+    static bool advance_loop( int64_t         i_num_loops,
+                              int64_t const * i_sizes,
+                              int64_t       * io_counters );
+
+    /**
+     * Gets the size of a datatype.
+     *
+     * @param i_dtype datatype.
+     * @return size in bytes.
+     **/
+    static int64_t dtype_size( dtype_t i_dtype );
+
+    /**
+     * Gets the LIBXSMM datatype corresponding to the given datatype.
+     *
+     * @param i_dtype datatype.
+     * @return LIBXSMM datatype.
+     **/
+    static libxsmm_datatype dtype_libxsmm( dtype_t i_dtype );
+
+    /**
+     * Packs the A blocks of a range of outer K iterations of a C block.
+     *
+     * @param i_s data pointer of S at the C block's offset.
+     * @param i_first_iter first K iteration.
+     * @param i_last_iter K iteration after the last one.
+     * @param o_packed will be set to the packed blocks, stored one after another at the positions of their K iterations,
+     *                 followed by scratch of a single block.
+     **/
+    void pack_a( char const * i_s,
+                 int64_t      i_first_iter,
+                 int64_t      i_last_iter,
+                 char       * o_packed ) const;
+
+    /**
+     * Packs the B blocks of a range of outer K iterations of a C block.
+     *
+     * @param i_t data pointer of T at the C block's offset.
+     * @param i_first_iter first K iteration.
+     * @param i_last_iter K iteration after the last one.
+     * @param o_packed will be set to the packed blocks, stored one after another at the positions of their K iterations.
+     **/
+    void pack_b( char const * i_t,
+                 int64_t      i_first_iter,
+                 int64_t      i_last_iter,
+                 char       * o_packed ) const;
+
+    /**
+     * Derives the offsets of a C block, i.e., the offsets given by the counters of the outer loops.
+     *
+     * @param i_bl id of the C block.
+     * @param o_offset_s will be set to the offset (in elements) w.r.t. S.
+     * @param o_offset_t will be set to the offset (in elements) w.r.t. T.
+     * @param o_offset_u will be set to the offset (in elements) w.r.t. U.
+     * @param o_offset_bias will be set to the offset (in elements) w.r.t. the bias.
+     **/
+    void block_offsets( int64_t   i_bl,
+                        int64_t & o_offset_s,
+                        int64_t & o_offset_t,
+                        int64_t & o_offset_u,
+                        int64_t & o_offset_bias ) const;
+
+    /**
+     * Applies the epilogue (scaling, bias, activation) to a C block.
+     *
+     * @param io_c C block, either in U or in a tile.
+     * @param i_bias data pointer of the bias at the C block's offset.
+     **/
+    void epilogue( void       * io_c,
+                   void const * i_bias ) const;
+
+    /**
+     * Executes the plan in split-K mode.
+     * First, the partial C blocks of all C blocks and ranges of K iterations are computed in parallel.
+     * Second, the partial blocks are reduced into U in parallel over the C blocks and the epilogue is applied.
+     *
+     * @param i_s data pointer of S.
+     * @param i_t data pointer of T.
+     * @param o_u data pointer of U.
+     * @param i_bias data pointer of the bias, only used if the plan's epilogue adds a bias.
+     * @param io_busy if not nullptr, the time (in seconds) thread i spent executing C blocks is added to io_busy[i].
+     * @param io_pool thread pool executing the plan, nullptr for the plan's OpenMP threads.
+     **/
+    void execute_split( void const * i_s,
+                        void const * i_t,
+                        void       * o_u,
+                        void const * i_bias,
+                        double     * io_busy,
+                        ThreadPool * io_pool ) const;
+
+    /**
+     * Executes a parallel region on the plan's OpenMP threads or on a thread pool.
+     *
+     * @param io_pool thread pool, nullptr for OpenMP.
+     * @param i_fn function called by every thread with the thread's id and the size of the team.
+     **/
+    template< typename T >
+    void parallel( ThreadPool * io_pool,
+                   T    const & i_fn ) const;
+
+    /**
+     * Synchronizes the threads of a parallel region.
+     *
+     * @param io_pool thread pool executing the region, nullptr for OpenMP.
+     **/
+    static void barrier( ThreadPool * io_pool );
+
+  public:
+    /**
+     * Initializes the plan, i.e., derives the LIBXSMM kernel and the loop configurations.
+     * S and T are the input tensors, U is the output tensors.
+     * The loop nest is optimized for the L1 and L2 cache sizes of the system
+     * and the given number of threads, by default the number of OpenMP threads available at initialization.
+     *
+     * @param i_n_dims_s S's number of dimensions.
+     * @param i_n_dims_t T's number of dimensions.
+     * @param i_n_dims_u U's number of dimensions.
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_types_s types of S's dimensions (0: M, 1: K, 2: B).
+     * @param i_types_t types of T's dimensions (0: N, 1: K, 2: B).
+     * @param i_types_u types of U's dimensions (0: M, 1: N, 2: B).
+     * @param i_strides_s strides of S's dimensions.
+     * @param i_strides_t strides of T's dimensions.
+     * @param i_strides_u strides of U's dimensions.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     * @param i_n_threads number of threads executing the plan, 0 for omp_get_max_threads().
+     **/
+    void init( int64_t         i_n_dims_s,
+               int64_t         i_n_dims_t,
+               int64_t         i_n_dims_u,
+               int64_t const * i_sizes_s,
+               int64_t const * i_sizes_t,
+               int8_t  const * i_types_s,
+               int8_t  const * i_types_t,
+               int8_t  const * i_types_u,
+               int64_t const * i_strides_s,
+               int64_t const * i_strides_t,
+               int64_t const * i_strides_u,
+               dtype_t         i_dtype_in  = dtype_t::fp32,
+               dtype_t         i_dtype_out = dtype_t::fp32,
+               Epilogue const& i_epilogue  = Epilogue(),
+               int64_t         i_n_threads = 0 );
+
+    /**
+     * Executes the plan: U += contract(S, T), followed by the epilogue.
+     * The plan has to be initialized before calling this function.
+     * Every thread starts with the C blocks it owns (see block_range),
+     * afterwards it steals chunks of blocks of the other threads (see BlockScheduler).
+     * If the plan splits the K iterations, the partial C blocks are computed in parallel and reduced afterwards.
+     * If a thread pool is given, the pool's threads execute the plan instead of the OpenMP threads.
+     * The C blocks are then distributed over the pool's threads, the loop nest stays the one optimized at initialization.
+     *
+     * @param i_s data pointer of S.
+     * @param i_t data pointer of T.
+     * @param o_u data pointer of U.
+     * @param i_bias data pointer of the bias, only used if the plan's epilogue adds a bias.
+     * @param io_busy if not nullptr, the time (in seconds) thread i spent executing C blocks is added to io_busy[i].
+     * @param io_pool thread pool executing the plan, nullptr for the plan's OpenMP threads.
+     **/
+    void execute( void const * i_s,
+                  void const * i_t,
+                  void       * o_u,
+                  void const * i_bias  = nullptr,
+                  double     * io_busy = nullptr,
+                  ThreadPool * io_pool = nullptr ) const;
+
+    /**
+     * Executes a range of the plan's C blocks on the calling thread, i.e., without spawning OpenMP threads.
+     * Packed blocks are only reused within the range.
+     *
+     * @param i_s data pointer of S.
+     * @param i_t data pointer of T.
+     * @param o_u data pointer of U.
+     * @param i_bias data pointer of the bias, only used if the plan's epilogue adds a bias.
+     * @param i_first first C block.
+     * @param i_last C block after the last one.
+     **/
+    void execute_blocks( void const * i_s,
+                         void const * i_t,
+                         void       * o_u,
+                         void const * i_bias,
+                         int64_t      i_first,
+                         int64_t      i_last ) const;
+
+    /**
+     * Zeroes U with the assignment of C blocks to threads which execute starts from, i.e., only stolen blocks differ.
+     * On NUMA systems, calling this function on freshly allocated memory places U's pages
+     * in the memory of the sockets whose threads write the respective blocks.
+     * Threads should be bound to cores (e.g., OMP_PROC_BIND=close and OMP_PLACES=cores) to keep the placement.
+     * The threads have to match those of the following executions, i.e., the same thread pool or the plan's OpenMP threads.
+     *
+     * @param o_u data pointer of U.
+     * @param io_pool thread pool executing the plan, nullptr for the plan's OpenMP threads.
+     **/
+    void first_touch( void       * o_u,
+                      ThreadPool * io_pool = nullptr ) const;
+
+    /**
+     * Gets the range of C blocks owned by a thread.
+     *
+     * @param i_tid id of the thread.
+     * @param o_first will be set to the thread's first C block.
+     * @param o_last will be set to the C block after the thread's last one.
+     **/
+    void block_range( int64_t   i_tid,
+                      int64_t & o_first,
+                      int64_t & o_last ) const;
+
+    /**
+     * Gets the number of threads executing the plan.
+     *
+     * @return number of threads.
+     **/
+    int64_t n_threads() const { return m_n_threads; }
+
+    /**
+     * Gets the number of C blocks, i.e., the number of iterations of the collapsed outer loops.
+     *
+     * @return number of C blocks.
+     **/
+    int64_t n_blocks() const { return m_n_blocks; }
+
+    /**
+     * Gets the number of ranges into which the K iterations of a C block are split.
+     *
+     * @return number of ranges, one if the plan doesn't use split-K.
+     **/
+    int64_t n_splits() const { return m_n_splits; }
+};
+
+#endif
@@ -0,0 +1,730 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include <omp.h>
+#include "ContractionPlan.h"
+
+TEST_CASE( "Tests repeated executions of a single contraction plan.",
+           "[tpp_nets][ContractionPlan][execute]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0    1   2   3
+  //                       n0   k0  n1  k1
+  //                        e    a   f   c
+  int64_t l_sizes_t[4] = {  8,  17,  7, 22 };
+
+  at::Tensor l_s_0 = at::rand( l_sizes_s );
+  at::Tensor l_t_0 = at::rand( l_sizes_t );
+  at::Tensor l_s_1 = at::rand( l_sizes_s );
+  at::Tensor l_t_1 = at::rand( l_sizes_t );
+  //                              0   1   2   3
+  //                             n0  m0  n1  m1
+  //                              e   b   f   d
+  at::Tensor l_u_0 = at::zeros( { 8,  5,  7, 13 } );
+  at::Tensor l_u_1 = at::zeros( { 8,  5,  7, 13 } );
+
+  std::vector< int64_t > l_strides_s = l_s_0.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t_0.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u_0.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 4,
+               4,
+               4,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data() );
+
+  // accumulate twice into the first output tensor
+  l_plan.execute( l_s_0.data_ptr(),
+                  l_t_0.data_ptr(),
+                  l_u_0.data_ptr() );
+
+  l_plan.execute( l_s_0.data_ptr(),
+                  l_t_0.data_ptr(),
+                  l_u_0.data_ptr() );
+
+  // reuse plan for different data
+  l_plan.execute( l_s_1.data_ptr(),
+                  l_t_1.data_ptr(),
+                  l_u_1.data_ptr() );
+
+  at::Tensor l_ref_0 = at::einsum( "abcd,eafc->ebfd",
+                                   {l_s_0, l_t_0} );
+
+  at::Tensor l_ref_1 = at::einsum( "abcd,eafc->ebfd",
+                                   {l_s_1, l_t_1} );
+
+  REQUIRE( at::allclose( l_u_0,
+                         2 * l_ref_0 ) );
+
+  REQUIRE( at::allclose( l_u_1,
+                         l_ref_1 ) );
+}
+
+TEST_CASE( "Tests a contraction with more C blocks than threads and multiple K loops.",
+           "[tpp_nets][ContractionPlan][execute_parallel]" ) {
+  //                        0   1   2   3   4   5
+  //                       m0  k0  m1  k1  k2  m2
+  //                        a   b   c   d   e   f
+  int64_t l_sizes_s[6] = { 11,  3,  9,  4,  5, 16 };
+
+  //                        0   1   2   3   4
+  //                       n0  k0  k1  n1  k2
+  //                        g   b   d   h   e
+  int64_t l_sizes_t[5] = { 13,  3,  4,  8,  5 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                          0   1   2   3   4
+  //                         n0  m0  m1  n1  m2
+  //                          g   a   c   h   f
+  at::Tensor l_u = at::zeros( { 13, 11, 9, 8, 16 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[6] = { 0, 1, 0, 1, 1, 0 };
+  int8_t l_types_t[5] = { 0, 1, 1, 0, 1 };
+  int8_t l_types_u[5] = { 1, 0, 0, 1, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 6,
+               5,
+               5,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data() );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "abcdef,gbdhe->gachf",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a contraction in FP64.",
+           "[tpp_nets][ContractionPlan][execute_fp64]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0    1   2   3
+  //                       n0   k0  n1  k1
+  //                        e    a   f   c
+  int64_t l_sizes_t[4] = {  8,  17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s, at::kDouble );
+  at::Tensor l_t = at::rand( l_sizes_t, at::kDouble );
+  //                            0   1   2   3
+  //                           n0  m0  n1  m1
+  //                            e   b   f   d
+  at::Tensor l_u = at::zeros( { 8,  5,  7, 13 }, at::kDouble );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 4,
+               4,
+               4,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data(),
+               tpp_nets::backend::dtype_t::fp64,
+               tpp_nets::backend::dtype_t::fp64 );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "abcd,eafc->ebfd",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a contraction with BF16 inputs and FP32 output.",
+           "[tpp_nets][ContractionPlan][execute_bf16]" ) {
+  //                        0   1   2   3   4   5
+  //                       m0  k0  m1  k1  k2  m2
+  //                        a   b   c   d   e   f
+  int64_t l_sizes_s[6] = { 11,  3,  9,  4,  6, 16 };
+
+  //                        0   1   2   3   4
+  //                       n0  k0  k1  n1  k2
+  //                        g   b   d   h   e
+  int64_t l_sizes_t[5] = { 13,  3,  4,  8,  6 };
+
+  at::Tensor l_s = at::rand( l_sizes_s, at::kBFloat16 );
+  at::Tensor l_t = at::rand( l_sizes_t, at::kBFloat16 );
+  //                          0   1   2   3   4
+  //                         n0  m0  m1  n1  m2
+  //                          g   a   c   h   f
+  at::Tensor l_u = at::zeros( { 13, 11, 9, 8, 16 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[6] = { 0, 1, 0, 1, 1, 0 };
+  int8_t l_types_t[5] = { 0, 1, 1, 0, 1 };
+  int8_t l_types_u[5] = { 1, 0, 0, 1, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 6,
+               5,
+               5,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data(),
+               tpp_nets::backend::dtype_t::bf16,
+               tpp_nets::backend::dtype_t::fp32 );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  // the inputs are exactly representable in FP32, only the order of the accumulation differs
+  at::Tensor l_ref = at::einsum( "abcdef,gbdhe->gachf",
+                                 {l_s.to( at::kFloat ), l_t.to( at::kFloat )} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a BF16 contraction with an odd K.",
+           "[tpp_nets][ContractionPlan][execute_bf16_odd_k]" ) {
+  //                        0   1
+  //                       m0  k0
+  //                        a   b
+  int64_t l_sizes_s[2] = { 16, 15 };
+
+  //                        0   1
+  //                       k0  n0
+  //                        b   c
+  int64_t l_sizes_t[2] = { 15,  8 };
+
+  at::Tensor l_s = at::rand( l_sizes_s, at::kBFloat16 );
+  at::Tensor l_t = at::rand( l_sizes_t, at::kBFloat16 );
+  //                          0   1
+  //                         n0  m0
+  //                          c   a
+  at::Tensor l_u = at::zeros( { 8, 16 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[2] = { 0, 1 };
+  int8_t l_types_t[2] = { 1, 0 };
+  int8_t l_types_u[2] = { 1, 0 };
+
+  // the K block is padded with zeros if the kernel requires the VNNI format
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 2,
+               2,
+               2,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data(),
+               tpp_nets::backend::dtype_t::bf16,
+               tpp_nets::backend::dtype_t::fp32 );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "ab,bc->ca",
+                                 {l_s.to( at::kFloat ), l_t.to( at::kFloat )} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a contraction which overwrites U and applies a fused epilogue.",
+           "[tpp_nets][ContractionPlan][execute_epilogue]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0    1   2   3
+  //                       n0   k0  n1  k1
+  //                        e    a   f   c
+  int64_t l_sizes_t[4] = {  8,  17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s ) - 0.5;
+  at::Tensor l_t = at::rand( l_sizes_t );
+  //                           0   1   2   3
+  //                          n0  m0  n1  m1
+  //                           e   b   f   d
+  at::Tensor l_u = at::rand( { 8,  5,  7, 13 } );
+
+  // bias over the M dimensions, broadcasted along N
+  at::Tensor l_bias = at::rand( { 5, 13 } );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+  int64_t l_strides_bias[4] = { 0, 13, 0, 1 };
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+  l_epilogue.alpha = 0.5;
+  l_epilogue.strides_bias = l_strides_bias;
+  l_epilogue.act = tpp_nets::backend::act_t::relu;
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 4,
+               4,
+               4,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data(),
+               tpp_nets::backend::dtype_t::fp32,
+               tpp_nets::backend::dtype_t::fp32,
+               l_epilogue );
+
+  // U's initial values are ignored
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr(),
+                  l_bias.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "abcd,eafc->ebfd",
+                                 {l_s, l_t} );
+  l_ref = at::relu( 0.5 * l_ref + l_bias.view( { 1, 5, 1, 13 } ) );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a contraction whose dimensions are fused into a single GEMM.",
+           "[tpp_nets][ContractionPlan][execute_fused]" ) {
+  //                               0  1  2  3
+  //                              k0 k1 m0 m1
+  at::Tensor l_s = at::rand( { 8, 8, 8, 8 } );
+  //                               0  1  2  3
+  //                              n0 n1 k0 k1
+  at::Tensor l_t = at::rand( { 8, 8, 8, 8 } );
+  //                               0  1  2  3
+  //                              n0 n1 m0 m1
+  at::Tensor l_u = at::zeros( { 8, 8, 8, 8 } );
+
+  std::vector< int64_t > l_sizes_s = l_s.sizes().vec();
+  std::vector< int64_t > l_sizes_t = l_t.sizes().vec();
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 1, 0, 0 };
+  int8_t l_types_t[4] = { 0, 0, 1, 1 };
+  int8_t l_types_u[4] = { 1, 1, 0, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 4,
+               4,
+               4,
+               l_sizes_s.data(),
+               l_sizes_t.data(),
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data() );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "abcd,efab->efcd",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests a contraction of permuted and sliced tensors without unit strides.",
+           "[tpp_nets][ContractionPlan][execute_strided]" ) {
+  //                                      0   1   2
+  //                                     m0  k0  m1
+  at::Tensor l_s = at::rand( { 6, 24, 8, 2 } ).select( 3, 1 );
+  //                                     n0  k0
+  at::Tensor l_t = at::rand( { 24, 20 } ).t();
+  //                                     m0  m1  n0
+  at::Tensor l_u = at::zeros( { 6, 8, 20, 2 } ).select( 3, 0 ).permute( { 2, 0, 1 } );
+
+  std::vector< int64_t > l_sizes_s = l_s.sizes().vec();
+  std::vector< int64_t > l_sizes_t = l_t.sizes().vec();
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  int8_t l_types_s[3] = { 0, 1, 0 };
+  int8_t l_types_t[2] = { 0, 1 };
+  int8_t l_types_u[3] = { 1, 0, 0 };
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 3,
+               2,
+               3,
+               l_sizes_s.data(),
+               l_sizes_t.data(),
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data() );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr() );
+
+  at::Tensor l_ref = at::einsum( "abc,db->dac",
+                                 {l_s, l_t} );
+
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the first touch of U and the assignment of C blocks to threads.",
+           "[tpp_nets][ContractionPlan][first_touch]" ) {
+  //                        0   1   2   3
+  //                       k0  m0  k1  m1
+  //                        a   b   c   d
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+
+  //                        0    1   2   3
+  //                       n0   k0  n1  k1
+  //                        e    a   f   c
+  int64_t l_sizes_t[4] = {  8,  17,  7, 22 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+
+  //                                      0   1   2   3
+  //                                     n0  m0  n1  m1
+  //                                      e   b   f   d
+  at::Tensor l_u_contiguous = at::rand( { 8,  5,  7, 13 } );
+  at::Tensor l_u_permuted   = at::rand( { 7, 13,  8,  5 } ).permute( { 2, 3, 0, 1 } );
+
+  for( at::Tensor l_u : { l_u_contiguous, l_u_permuted } ) {
+    std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+    tpp_nets::backend::ContractionPlan l_plan;
+    l_plan.init( 4,
+                 4,
+                 4,
+                 l_sizes_s,
+                 l_sizes_t,
+                 l_types_s,
+                 l_types_t,
+                 l_types_u,
+                 l_strides_s.data(),
+                 l_strides_t.data(),
+                 l_strides_u.data() );
+
+    // the threads own contiguous, disjoint ranges covering all C blocks
+    int64_t l_first = 0;
+    int64_t l_last = 0;
+    int64_t l_next = 0;
+    for( int64_t l_tid = 0; l_tid < l_plan.n_threads(); l_tid++ ) {
+      l_plan.block_range( l_tid,
+                          l_first,
+                          l_last );
+      REQUIRE( l_first == l_next );
+      REQUIRE( l_first <= l_last );
+      l_next = l_last;
+    }
+    REQUIRE( l_next == l_plan.n_blocks() );
+
+    l_plan.first_touch( l_u.data_ptr() );
+    REQUIRE( at::equal( l_u,
+                        at::zeros_like( l_u ) ) );
+
+    l_plan.execute( l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+    at::Tensor l_ref = at::einsum( "abcd,eafc->ebfd",
+                                   {l_s, l_t} );
+    REQUIRE( at::allclose( l_u,
+                           l_ref ) );
+  }
+
+  // first touch and execution through the same thread pool
+  tpp_nets::backend::ThreadPool l_pool( 3 );
+  at::Tensor l_u = at::rand( { 8, 5, 7, 13 } );
+  std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 4,
+               4,
+               4,
+               l_sizes_s,
+               l_sizes_t,
+               l_types_s,
+               l_types_t,
+               l_types_u,
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data() );
+
+  l_plan.first_touch( l_u.data_ptr(),
+                      &l_pool );
+  REQUIRE( at::equal( l_u,
+                      at::zeros_like( l_u ) ) );
+
+  l_plan.execute( l_s.data_ptr(),
+                  l_t.data_ptr(),
+                  l_u.data_ptr(),
+                  nullptr,
+                  nullptr,
+                  &l_pool );
+
+  at::Tensor l_ref = at::einsum( "abcd,eafc->ebfd",
+                                 {l_s, l_t} );
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+
+  // first touch inside an enclosing parallel region, whose nested teams may be smaller than the plan's
+  at::Tensor l_u_nested[2] = { at::rand( { 8, 5, 7, 13 } ),
+                               at::rand( { 8, 5, 7, 13 } ) };
+  int l_n_outer = 0;
+#pragma omp parallel num_threads( 2 )
+  {
+    int l_tid = omp_get_thread_num();
+    if( l_tid == 0 ) l_n_outer = omp_get_num_threads();
+    l_plan.first_touch( l_u_nested[l_tid].data_ptr() );
+  }
+
+  for( int l_ou = 0; l_ou < l_n_outer; l_ou++ ) {
+    REQUIRE( at::equal( l_u_nested[l_ou],
+                        at::zeros_like( l_u_nested[l_ou] ) ) );
+  }
+}
+
+TEST_CASE( "Tests a contraction with a small output and a large K (split-K).",
+           "[tpp_nets][ContractionPlan][split_k]" ) {
+  //                        0     1     2
+  //                       k0    m0    k1
+  //                        a     b     c
+  int64_t l_sizes_s[3] = { 64,    5,   96 };
+
+  //                        0     1     2
+  //                       n0    k0    k1
+  //                        d     a     c
+  int64_t l_sizes_t[3] = {  3,   64,   96 };
+
+  at::Tensor l_s = at::rand( l_sizes_s );
+  at::Tensor l_t = at::rand( l_sizes_t );
+
+  std::vector< int64_t > l_strides_s = l_s.strides().vec();
+  std::vector< int64_t > l_strides_t = l_t.strides().vec();
+
+  int8_t l_types_s[3] = { 1, 0, 1 };
+  int8_t l_types_t[3] = { 0, 1, 1 };
+  int8_t l_types_u[2] = { 1, 0 };
+
+  at::Tensor l_ref = at::einsum( "abc,dac->db",
+                                 {l_s, l_t} );
+
+  for( bool l_zero_u : { false, true } ) {
+    //                      0  1
+    //                     n0 m0
+    //                      d  b
+    at::Tensor l_u = at::rand( { 3, 5 } );
+    at::Tensor l_u_init = l_u.clone();
+    std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+    tpp_nets::backend::Epilogue l_epilogue;
+    l_epilogue.zero_u = l_zero_u;
+
+    tpp_nets::backend::ContractionPlan l_plan;
+    l_plan.init( 3,
+                 3,
+                 2,
+                 l_sizes_s,
+                 l_sizes_t,
+                 l_types_s,
+                 l_types_t,
+                 l_types_u,
+                 l_strides_s.data(),
+                 l_strides_t.data(),
+                 l_strides_u.data(),
+                 tpp_nets::backend::dtype_t::fp32,
+                 tpp_nets::backend::dtype_t::fp32,
+                 l_epilogue );
+
+    // a single C block, the K iterations are split among the threads
+    REQUIRE( l_plan.n_blocks() == 1 );
+    if( l_plan.n_threads() > 1 ) {
+      REQUIRE( l_plan.n_splits() > 1 );
+    }
+
+    l_plan.execute( l_s.data_ptr(),
+                    l_t.data_ptr(),
+                    l_u.data_ptr() );
+
+    REQUIRE( at::allclose( l_u,
+                           l_zero_u ? l_ref : l_ref + l_u_init,
+                           1E-4,
+                           1E-5 ) );
+
+    // executions inside an enclosing parallel region, whose nested teams may be smaller than the plan's
+    at::Tensor l_u_nested[2] = { at::zeros( { 3, 5 } ),
+                                 at::zeros( { 3, 5 } ) };
+    int l_n_outer = 0;
+#pragma omp parallel num_threads( 2 )
+    {
+      int l_tid = omp_get_thread_num();
+      if( l_tid == 0 ) l_n_outer = omp_get_num_threads();
+      l_plan.execute( l_s.data_ptr(),
+                      l_t.data_ptr(),
+                      l_u_nested[l_tid].data_ptr() );
+    }
+
+    for( int l_ou = 0; l_ou < l_n_outer; l_ou++ ) {
+      REQUIRE( at::allclose( l_u_nested[l_ou],
+                             l_ref,
+                             1E-4,
+                             1E-5 ) );
+    }
+  }
+}
+
+TEST_CASE( "Tests the execution of plans through thread pools.",
+           "[tpp_nets][ContractionPlan][thread_pool]" ) {
+  // many C blocks and a single C block (split-K)
+  //                                     0     1     2
+  //                                    k0    m0    k1
+  //                                     a     b     c
+  std::vector< int64_t > l_sizes_s[2] = { { 16,  256,   24 },
+                                          { 64,    5,   96 } };
+
+  //                                     0     1     2
+  //                                    n0    k0    k1
+  //                                     d     a     c
+  std::vector< int64_t > l_sizes_t[2] = { { 96,   16,   24 },
+                                          {  3,   64,   96 } };
+
+  int8_t l_types_s[3] = { 1, 0, 1 };
+  int8_t l_types_t[3] = { 0, 1, 1 };
+  int8_t l_types_u[2] = { 1, 0 };
+
+  // pools with fewer, as many and more threads than the plan
+  for( int64_t l_n_threads : { (int64_t) 1, (int64_t) 3, (int64_t) omp_get_max_threads() + 1 } ) {
+    tpp_nets::backend::ThreadPool l_pool( l_n_threads );
+
+    for( int64_t l_ge = 0; l_ge < 2; l_ge++ ) {
+      at::Tensor l_s = at::rand( l_sizes_s[l_ge] );
+      at::Tensor l_t = at::rand( l_sizes_t[l_ge] );
+      at::Tensor l_u = at::rand( { l_sizes_t[l_ge][0], l_sizes_s[l_ge][1] } );
+
+      std::vector< int64_t > l_strides_s = l_s.strides().vec();
+      std::vector< int64_t > l_strides_t = l_t.strides().vec();
+      std::vector< int64_t > l_strides_u = l_u.strides().vec();
+
+      tpp_nets::backend::Epilogue l_epilogue;
+      l_epilogue.zero_u = true;
+
+      tpp_nets::backend::ContractionPlan l_plan;
+      l_plan.init( 3,
+                   3,
+                   2,
+                   l_sizes_s[l_ge].data(),
+                   l_sizes_t[l_ge].data(),
+                   l_types_s,
+                   l_types_t,
+                   l_types_u,
+                   l_strides_s.data(),
+                   l_strides_t.data(),
+                   l_strides_u.data(),
+                   tpp_nets::backend::dtype_t::fp32,
+                   tpp_nets::backend::dtype_t::fp32,
+                   l_epilogue );
+
+      // repeated regions of the same pool
+      std::vector< double > l_busy( l_n_threads, 0 );
+      for( int64_t l_re = 0; l_re < 3; l_re++ ) {
+        l_plan.execute( l_s.data_ptr(),
+                        l_t.data_ptr(),
+                        l_u.data_ptr(),
+                        nullptr,
+                        l_busy.data(),
+                        &l_pool );
+      }
+
+      at::Tensor l_ref = at::einsum( "abc,dac->db",
+                                     {l_s, l_t} );
+      REQUIRE( at::allclose( l_u,
+                             l_ref,
+                             1E-4,
+                             1E-5 ) );
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef TPP_NETS_BACKEND_DATA_TYPE
+#define TPP_NETS_BACKEND_DATA_TYPE
+
+#include <cstdint>
+
+namespace tpp_nets {
+  namespace backend {
+    /**
+     * Datatypes of the tensors in a contraction.
+     *
+     * FP32 and FP64 contractions use the same datatype for the inputs and the output.
+     * BF16 and FP16 inputs are accumulated in FP32, the output is either FP32 or has the inputs' datatype.
+     **/
+    enum class dtype_t : int8_t {
+      fp32 = 0,
+      fp64 = 1,
+      bf16 = 2,
+      fp16 = 3
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TPP_NETS_BACKEND_EPILOGUE
+#define TPP_NETS_BACKEND_EPILOGUE
+
+#include <cstdint>
+
+namespace tpp_nets {
+  namespace backend {
+    /**
+     * Activation functions which might be applied in the epilogue of a contraction.
+     **/
+    enum class act_t : int8_t {
+      none = 0,
+      relu = 1,
+      gelu = 2
+    };
+
+    struct Epilogue;
+  }
+}
+
+/**
+ * Fused initialization and epilogue of a contraction's output tensor U.
+ *
+ * The epilogue is applied to a block of U right after the block's contraction finished, i.e., while the block is hot:
+ *   U = act( alpha * U + bias )
+ * If zero_u is set, U is overwritten (beta=0) instead of accumulated into before the epilogue is applied.
+ *
+ * The bias has U's dimensions, a stride of zero broadcasts the bias along the respective dimension.
+ * Along the two fastest M and N dimensions, the bias has to be a vector (stride 1 in one and 0 in the other),
+ * a scalar (0 in both) or a matrix (stride 1 in the fastest dimension).
+ **/
+struct tpp_nets::backend::Epilogue {
+  //! true if U is overwritten, false if the contraction is accumulated into U
+  bool zero_u = false;
+
+  //! scaling factor applied to U
+  double alpha = 1.0;
+
+  //! strides of the bias w.r.t. U's dimensions, nullptr if no bias is added
+  int64_t const * strides_bias = nullptr;
+
+  //! activation function applied last
+  act_t act = act_t::none;
+};
+
+#endif
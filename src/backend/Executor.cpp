@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cassert>
+#include <omp.h>
+#include "Executor.h"
+
+tpp_nets::backend::Executor::Executor( int64_t i_n_workers,
+                                       int64_t i_n_threads_per_worker ) {
+  assert( i_n_workers > 0 );
+  assert( i_n_threads_per_worker > 0 );
+
+  m_n_threads_per_worker = i_n_threads_per_worker;
+  for( int64_t l_wo = 0; l_wo < i_n_workers; l_wo++ ) {
+    m_workers.emplace_back( &Executor::work,
+                            this );
+  }
+}
+
+tpp_nets::backend::Executor::~Executor() {
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_stop = true;
+  }
+  m_cv.notify_all();
+
+  for( std::size_t l_wo = 0; l_wo < m_workers.size(); l_wo++ ) {
+    m_workers[l_wo].join();
+  }
+}
+
+tpp_nets::backend::Executor & tpp_nets::backend::Executor::instance() {
+  static Executor l_executor( m_n_workers_default,
+                              std::max( omp_get_max_threads() / m_n_workers_default,
+                                        (int64_t) 1 ) );
+  return l_executor;
+}
+
+void tpp_nets::backend::Executor::work() {
+  // the worker's contractions use their own team of threads
+  omp_set_num_threads( m_n_threads_per_worker );
+
+  while( true ) {
+    handle_t l_task;
+    {
+      std::unique_lock< std::mutex > l_lock( m_mutex );
+      m_cv.wait( l_lock,
+                 [this]() { return m_stop || !m_ready.empty(); } );
+
+      // submitted tasks are finished before shutting down
+      if( m_ready.empty() ) return;
+
+      l_task = m_ready.front();
+      m_ready.pop_front();
+    }
+
+    // tasks with a failed dependency are skipped, the exception of a failing task is kept
+    std::exception_ptr l_error = l_task->m_error;
+    if( l_error == nullptr ) {
+      try {
+        l_task->m_fn();
+      }
+      catch( ... ) {
+        l_error = std::current_exception();
+      }
+    }
+    l_task->m_fn = nullptr;
+
+    // release the successors, a failure is passed on
+    int64_t l_n_released = 0;
+    {
+      std::lock_guard< std::mutex > l_lock( m_mutex );
+      l_task->m_done = true;
+      l_task->m_error = l_error;
+
+      for( std::size_t l_su = 0; l_su < l_task->m_successors.size(); l_su++ ) {
+        handle_t const & l_successor = l_task->m_successors[l_su];
+        if( l_error != nullptr && l_successor->m_error == nullptr ) {
+          l_successor->m_error = l_error;
+        }
+        l_successor->m_n_pending--;
+        if( l_successor->m_n_pending == 0 ) {
+          m_ready.push_back( l_successor );
+          l_n_released++;
+        }
+      }
+      l_task->m_successors.clear();
+    }
+    if( l_n_released > 1 ) m_cv.notify_all();
+    else if( l_n_released == 1 ) m_cv.notify_one();
+
+    if( l_error != nullptr ) l_task->m_promise.set_exception( l_error );
+    else                     l_task->m_promise.set_value();
+  }
+}
+
+tpp_nets::backend::Executor::handle_t tpp_nets::backend::Executor::submit( std::function< void() >         i_fn,
+                                                                          std::vector< handle_t > const & i_deps ) {
+  handle_t l_task = std::make_shared< Task >();
+  l_task->m_fn = std::move( i_fn );
+
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    assert( !m_stop );
+
+    for( std::size_t l_de = 0; l_de < i_deps.size(); l_de++ ) {
+      if( i_deps[l_de] == nullptr ) continue;
+
+      if( !i_deps[l_de]->m_done ) {
+        i_deps[l_de]->m_successors.push_back( l_task );
+        l_task->m_n_pending++;
+      }
+      else if( i_deps[l_de]->m_error != nullptr && l_task->m_error == nullptr ) {
+        l_task->m_error = i_deps[l_de]->m_error;
+      }
+    }
+
+    if( l_task->m_n_pending == 0 ) {
+      m_ready.push_back( l_task );
+    }
+  }
+  m_cv.notify_one();
+
+  return l_task;
+}
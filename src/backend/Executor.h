@@ -0,0 +1,160 @@
+#ifndef TPP_NETS_BACKEND_EXECUTOR
+#define TPP_NETS_BACKEND_EXECUTOR
+
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tpp_nets {
+  namespace backend {
+    class Executor;
+  }
+}
+
+/**
+ * Persistent pool of workers which execute submitted tasks asynchronously.
+ *
+ * A task may depend on previously submitted tasks and becomes ready once all of them finished.
+ * Ready tasks are executed in submission order by the next idle worker,
+ * i.e., independent tasks run concurrently on different workers.
+ * If a task throws, the exception is stored in the task's future.
+ * The task's successors are skipped and their futures get the same exception, i.e., the failure propagates through the graph.
+ *
+ * Every worker runs the OpenMP-parallel contractions of its tasks with its own team of threads.
+ * The number of threads per worker is set on the worker through omp_set_num_threads,
+ * thus plans constructed by a worker are optimized (and cached) for the worker's team size.
+ * Typically, the number of workers times the number of threads per worker matches the number of cores.
+ **/
+class tpp_nets::backend::Executor {
+  public:
+    //! submitted task
+    class Task {
+      friend class Executor;
+
+      private:
+        //! function executed by the task
+        std::function< void() > m_fn;
+
+        //! number of dependencies which didn't finish yet
+        int64_t m_n_pending = 0;
+
+        //! true if the task finished
+        bool m_done = false;
+
+        //! exception thrown by the task or one of its dependencies, nullptr if none was thrown
+        std::exception_ptr m_error = nullptr;
+
+        //! tasks depending on this task
+        std::vector< std::shared_ptr< Task > > m_successors;
+
+        //! promise fulfilled once the task finished
+        std::promise< void > m_promise;
+
+        //! future of the promise
+        std::shared_future< void > m_future = m_promise.get_future().share();
+
+      public:
+        /**
+         * Gets the task's future, which becomes ready once the task finished.
+         *
+         * @return future.
+         **/
+        std::shared_future< void > const & future() const { return m_future; }
+
+        /**
+         * Blocks until the task finished.
+         **/
+        void wait() const { m_future.wait(); }
+
+        /**
+         * Blocks until the task finished and rethrows the exception of the task or a failed dependency.
+         **/
+        void get() const { m_future.get(); }
+    };
+
+    //! handle of a submitted task
+    typedef std::shared_ptr< Task > handle_t;
+
+  private:
+    //! default number of workers
+    static constexpr int64_t m_n_workers_default = 2;
+
+    //! number of OpenMP threads of every worker
+    int64_t m_n_threads_per_worker = 1;
+
+    //! mutex protecting the tasks' states and the queue
+    std::mutex m_mutex;
+
+    //! signals ready tasks and shutdown to the workers
+    std::condition_variable m_cv;
+
+    //! tasks whose dependencies finished
+    std::deque< handle_t > m_ready;
+
+    //! true if the workers shut down
+    bool m_stop = false;
+
+    //! worker threads
+    std::vector< std::thread > m_workers;
+
+    /**
+     * Loop of a worker, executes ready tasks until shutdown.
+     **/
+    void work();
+
+  public:
+    /**
+     * Constructor, launches the workers.
+     *
+     * @param i_n_workers number of workers.
+     * @param i_n_threads_per_worker number of OpenMP threads of every worker.
+     **/
+    Executor( int64_t i_n_workers,
+              int64_t i_n_threads_per_worker );
+
+    /**
+     * Destructor, finishes all submitted tasks and joins the workers.
+     **/
+    ~Executor();
+
+    /**
+     * Gets the process-wide executor.
+     * The executor has two workers, which share the OpenMP threads available at first use.
+     *
+     * @return executor.
+     **/
+    static Executor & instance();
+
+    /**
+     * Submits a task.
+     *
+     * @param i_fn function executed by the task.
+     * @param i_deps tasks which have to finish before the task is executed.
+     * @return handle of the task.
+     **/
+    handle_t submit( std::function< void() >         i_fn,
+                     std::vector< handle_t > const & i_deps = {} );
+
+    /**
+     * Gets the number of workers.
+     *
+     * @return number of workers.
+     **/
+    int64_t n_workers() const { return m_workers.size(); }
+
+    /**
+     * Gets the number of OpenMP threads of every worker.
+     *
+     * @return number of threads.
+     **/
+    int64_t n_threads_per_worker() const { return m_n_threads_per_worker; }
+};
+
+#endif
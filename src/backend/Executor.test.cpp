@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#include "Executor.h"
+
+TEST_CASE( "Tests the execution order of dependent tasks.",
+           "[tpp_nets][Executor][submit]" ) {
+  tpp_nets::backend::Executor l_executor( 3,
+                                          2 );
+  REQUIRE( l_executor.n_workers() == 3 );
+  REQUIRE( l_executor.n_threads_per_worker() == 2 );
+
+  std::mutex l_mutex;
+  std::vector< int64_t > l_order;
+  auto l_record = [&]( int64_t i_id ) {
+    return [&, i_id]() {
+      std::lock_guard< std::mutex > l_lock( l_mutex );
+      l_order.push_back( i_id );
+    };
+  };
+  auto l_pos = [&]( int64_t i_id ) {
+    for( std::size_t l_po = 0; l_po < l_order.size(); l_po++ ) {
+      if( l_order[l_po] == i_id ) return (int64_t) l_po;
+    }
+    return (int64_t) -1;
+  };
+
+  // diamond: 0 -> {1, 2} -> 3, the root is delayed to submit the others while it runs
+  tpp_nets::backend::Executor::handle_t l_task_0 = l_executor.submit( [&]() {
+                                                                        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+                                                                        l_record( 0 )();
+                                                                      } );
+  tpp_nets::backend::Executor::handle_t l_task_1 = l_executor.submit( l_record( 1 ), { l_task_0 } );
+  tpp_nets::backend::Executor::handle_t l_task_2 = l_executor.submit( l_record( 2 ), { l_task_0 } );
+  tpp_nets::backend::Executor::handle_t l_task_3 = l_executor.submit( l_record( 3 ), { l_task_1, l_task_2 } );
+
+  // dependency on a finished task
+  l_task_3->wait();
+  tpp_nets::backend::Executor::handle_t l_task_4 = l_executor.submit( l_record( 4 ), { l_task_3 } );
+  l_task_4->future().wait();
+
+  REQUIRE( l_order.size() == 5 );
+  REQUIRE( l_pos( 0 ) == 0 );
+  REQUIRE( l_pos( 1 ) < l_pos( 3 ) );
+  REQUIRE( l_pos( 2 ) < l_pos( 3 ) );
+  REQUIRE( l_pos( 3 ) == 3 );
+  REQUIRE( l_pos( 4 ) == 4 );
+}
+
+TEST_CASE( "Tests the concurrent execution of independent tasks.",
+           "[tpp_nets][Executor][concurrent]" ) {
+  tpp_nets::backend::Executor l_executor( 2,
+                                          3 );
+
+  // both tasks only finish if they run at the same time
+  std::atomic< int64_t > l_arrived = 0;
+  std::atomic< int64_t > l_n_threads = 0;
+  auto l_meet = [&]() {
+    l_n_threads += omp_get_max_threads();
+    l_arrived++;
+    while( l_arrived.load() < 2 ) {
+      std::this_thread::yield();
+    }
+  };
+
+  std::vector< tpp_nets::backend::Executor::handle_t > l_tasks;
+  l_tasks.push_back( l_executor.submit( l_meet ) );
+  l_tasks.push_back( l_executor.submit( l_meet ) );
+
+  for( std::size_t l_ta = 0; l_ta < l_tasks.size(); l_ta++ ) {
+    l_tasks[l_ta]->wait();
+  }
+  REQUIRE( l_arrived.load() == 2 );
+
+  // every worker uses its own number of threads
+  REQUIRE( l_n_threads.load() == 6 );
+}
+
+TEST_CASE( "Tests the propagation of exceptions through dependent tasks.",
+           "[tpp_nets][Executor][exception]" ) {
+  tpp_nets::backend::Executor l_executor( 2,
+                                          1 );
+
+  std::atomic< int64_t > l_n_runs = 0;
+  auto l_run = [&]() { l_n_runs++; };
+
+  // 0 throws, 1 depends on 0 and 2 on 1, 3 is independent
+  tpp_nets::backend::Executor::handle_t l_task_0 = l_executor.submit( [&]() {
+                                                                        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+                                                                        throw std::runtime_error( "task 0 failed" );
+                                                                      } );
+  tpp_nets::backend::Executor::handle_t l_task_1 = l_executor.submit( l_run, { l_task_0 } );
+  tpp_nets::backend::Executor::handle_t l_task_2 = l_executor.submit( l_run, { l_task_1 } );
+  tpp_nets::backend::Executor::handle_t l_task_3 = l_executor.submit( l_run );
+
+  REQUIRE_THROWS_AS( l_task_0->get(), std::runtime_error );
+  REQUIRE_THROWS_AS( l_task_1->get(), std::runtime_error );
+  REQUIRE_THROWS_AS( l_task_2->get(), std::runtime_error );
+  REQUIRE_NOTHROW( l_task_3->get() );
+
+  // dependency on a finished, failed task
+  tpp_nets::backend::Executor::handle_t l_task_4 = l_executor.submit( l_run, { l_task_0 } );
+  REQUIRE_THROWS_AS( l_task_4->get(), std::runtime_error );
+
+  // the successors were skipped, the workers keep running
+  REQUIRE( l_n_runs.load() == 1 );
+  tpp_nets::backend::Executor::handle_t l_task_5 = l_executor.submit( l_run );
+  l_task_5->wait();
+  REQUIRE( l_n_runs.load() == 2 );
+}
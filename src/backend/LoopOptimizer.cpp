@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cassert>
+#include "LoopOptimizer.h"
+
+int64_t tpp_nets::backend::LoopOptimizer::next_block( int64_t i_size,
+                                                      int64_t i_block,
+                                                      int64_t i_multiple ) {
+  for( int64_t l_block = i_block-1; l_block >= m_min_block; l_block-- ) {
+    if(    i_size  % l_block    == 0
+        && l_block % i_multiple == 0 ) {
+      return l_block;
+    }
+  }
+
+  return i_block;
+}
+
+void tpp_nets::backend::LoopOptimizer::fuse( std::vector< Loop > & io_loops ) {
+  for( std::size_t l_lo = io_loops.size(); l_lo > 1; l_lo-- ) {
+    Loop const & l_outer = io_loops[l_lo-2];
+    Loop       & l_inner = io_loops[l_lo-1];
+
+    if(    l_outer.stride_s    == l_inner.stride_s    * l_inner.size
+        && l_outer.stride_t    == l_inner.stride_t    * l_inner.size
+        && l_outer.stride_u    == l_inner.stride_u    * l_inner.size
+        && l_outer.stride_bias == l_inner.stride_bias * l_inner.size ) {
+      l_inner.size *= l_outer.size;
+      io_loops.erase( io_loops.begin() + (l_lo-2) );
+    }
+  }
+}
+
+void tpp_nets::backend::LoopOptimizer::split( Loop      i_loop,
+                                              int64_t   i_block,
+                                              Loop    & o_outer,
+                                              Loop    & o_inner ) {
+  assert( i_loop.size % i_block == 0 );
+
+  o_inner = i_loop;
+  o_inner.size = i_block;
+
+  o_outer = i_loop;
+  o_outer.size = i_loop.size / i_block;
+  o_outer.stride_s    *= i_block;
+  o_outer.stride_t    *= i_block;
+  o_outer.stride_u    *= i_block;
+  o_outer.stride_bias *= i_block;
+}
+
+tpp_nets::backend::LoopOptimizer::LoopOptimizer( int64_t i_n_threads,
+                                                 int64_t i_size_l1,
+                                                 int64_t i_size_l2 ) {
+  assert( i_n_threads > 0 );
+  m_n_threads = i_n_threads;
+  m_size_l1 = i_size_l1;
+  m_size_l2 = i_size_l2;
+}
+
+void tpp_nets::backend::LoopOptimizer::optimize( int64_t             i_dtype_size_in,
+                                                 int64_t             i_dtype_size_out,
+                                                 int64_t             i_k_multiple,
+                                                 std::vector< Loop > & io_loops ) const {
+  // group the loops by type
+  std::vector< Loop > l_loops_b;
+  std::vector< Loop > l_loops_m;
+  std::vector< Loop > l_loops_n;
+  std::vector< Loop > l_loops_k;
+
+  for( std::size_t l_lo = 0; l_lo < io_loops.size(); l_lo++ ) {
+    if(      io_loops[l_lo].type == loop_t::b ) l_loops_b.push_back( io_loops[l_lo] );
+    else if( io_loops[l_lo].type == loop_t::m ) l_loops_m.push_back( io_loops[l_lo] );
+    else if( io_loops[l_lo].type == loop_t::n ) l_loops_n.push_back( io_loops[l_lo] );
+    else if( io_loops[l_lo].type == loop_t::k ) l_loops_k.push_back( io_loops[l_lo] );
+  }
+  assert( l_loops_m.size() > 0 );
+  assert( l_loops_n.size() > 0 );
+  assert( l_loops_k.size() > 0 );
+
+  // 0) order the loops of each type by their strides, the fastest loops are covered by the GEMM
+  auto l_cmp_mb = []( Loop const & i_a, Loop const & i_b ) {
+    if( i_a.stride_u != i_b.stride_u ) return i_a.stride_u > i_b.stride_u;
+    return i_a.stride_s > i_b.stride_s;
+  };
+  auto l_cmp_n = []( Loop const & i_a, Loop const & i_b ) {
+    if( i_a.stride_u != i_b.stride_u ) return i_a.stride_u > i_b.stride_u;
+    return i_a.stride_t > i_b.stride_t;
+  };
+  auto l_cmp_k = []( Loop const & i_a, Loop const & i_b ) {
+    if( i_a.stride_t != i_b.stride_t ) return i_a.stride_t > i_b.stride_t;
+    return i_a.stride_s > i_b.stride_s;
+  };
+  std::stable_sort( l_loops_b.begin(), l_loops_b.end(), l_cmp_mb );
+  std::stable_sort( l_loops_m.begin(), l_loops_m.end(), l_cmp_mb );
+  std::stable_sort( l_loops_n.begin(), l_loops_n.end(), l_cmp_n );
+  std::stable_sort( l_loops_k.begin(), l_loops_k.end(), l_cmp_k );
+
+  // 0) fuse dimensions
+  fuse( l_loops_b );
+  fuse( l_loops_m );
+  fuse( l_loops_n );
+  fuse( l_loops_k );
+
+  Loop l_gemm_m = l_loops_m.back();
+  Loop l_gemm_n = l_loops_n.back();
+  Loop l_gemm_k = l_loops_k.back();
+  l_loops_m.pop_back();
+  l_loops_n.pop_back();
+  l_loops_k.pop_back();
+
+  // number of C blocks without blocking the GEMM
+  int64_t l_n_blocks = 1;
+  for( std::size_t l_lo = 0; l_lo < l_loops_b.size(); l_lo++ ) l_n_blocks *= l_loops_b[l_lo].size;
+  for( std::size_t l_lo = 0; l_lo < l_loops_m.size(); l_lo++ ) l_n_blocks *= l_loops_m[l_lo].size;
+  for( std::size_t l_lo = 0; l_lo < l_loops_n.size(); l_lo++ ) l_n_blocks *= l_loops_n[l_lo].size;
+
+  int64_t l_block_m = l_gemm_m.size;
+  int64_t l_block_n = l_gemm_n.size;
+  int64_t l_block_k = l_gemm_k.size;
+
+  // 1) L1: panel of B used for a column of microkernels
+  while( l_block_k * std::min( l_block_n, m_min_block ) * i_dtype_size_in > m_size_l1 / 2 ) {
+    int64_t l_next = next_block( l_gemm_k.size, l_block_k, i_k_multiple );
+    if( l_next == l_block_k ) break;
+    l_block_k = l_next;
+  }
+
+  // 1) L2: working set of a batch-reduce step, the largest block is reduced first
+  while(   ( l_block_m * l_block_k + l_block_k * l_block_n ) * i_dtype_size_in
+         + l_block_m * l_block_n * i_dtype_size_out > m_size_l2 / 2 ) {
+    int64_t l_next_m = next_block( l_gemm_m.size, l_block_m, 1 );
+    int64_t l_next_n = next_block( l_gemm_n.size, l_block_n, 1 );
+    int64_t l_next_k = next_block( l_gemm_k.size, l_block_k, i_k_multiple );
+
+    if(      l_next_m != l_block_m && l_block_m >= l_block_n && l_block_m >= l_block_k ) l_block_m = l_next_m;
+    else if( l_next_n != l_block_n && l_block_n >= l_block_k )                            l_block_n = l_next_n;
+    else if( l_next_k != l_block_k )                                                      l_block_k = l_next_k;
+    else if( l_next_m != l_block_m )                                                      l_block_m = l_next_m;
+    else if( l_next_n != l_block_n )                                                      l_block_n = l_next_n;
+    else break;
+  }
+
+  // 2) parallel granularity
+  while(   l_n_blocks * ( l_gemm_m.size / l_block_m ) * ( l_gemm_n.size / l_block_n )
+         < m_n_threads * m_min_blocks_per_thread ) {
+    int64_t l_next_m = next_block( l_gemm_m.size, l_block_m, 1 );
+    int64_t l_next_n = next_block( l_gemm_n.size, l_block_n, 1 );
+
+    if(      l_next_m != l_block_m && l_block_m >= l_block_n ) l_block_m = l_next_m;
+    else if( l_next_n != l_block_n )                           l_block_n = l_next_n;
+    else if( l_next_m != l_block_m )                           l_block_m = l_next_m;
+    else break;
+  }
+
+  // 2) split-K: if the C blocks can't keep all threads busy, the K block is reduced such that the K iterations can be split
+  int64_t l_n_blocks_c = l_n_blocks * ( l_gemm_m.size / l_block_m ) * ( l_gemm_n.size / l_block_n );
+  if( l_n_blocks_c < m_n_threads ) {
+    int64_t l_iters_k = 1;
+    for( std::size_t l_lo = 0; l_lo < l_loops_k.size(); l_lo++ ) l_iters_k *= l_loops_k[l_lo].size;
+
+    while( l_n_blocks_c * l_iters_k * ( l_gemm_k.size / l_block_k ) < m_n_threads ) {
+      int64_t l_next = next_block( l_gemm_k.size, l_block_k, i_k_multiple );
+      if( l_next == l_block_k ) break;
+      l_block_k = l_next;
+    }
+  }
+
+  // split the GEMM's loops, the outer loops become the innermost ones of their groups
+  Loop l_outer;
+  if( l_block_m < l_gemm_m.size ) {
+    split( l_gemm_m, l_block_m, l_outer, l_gemm_m );
+    l_loops_m.push_back( l_outer );
+  }
+  if( l_block_n < l_gemm_n.size ) {
+    split( l_gemm_n, l_block_n, l_outer, l_gemm_n );
+    l_loops_n.push_back( l_outer );
+  }
+  if( l_block_k < l_gemm_k.size ) {
+    split( l_gemm_k, l_block_k, l_outer, l_gemm_k );
+    l_loops_k.push_back( l_outer );
+  }
+
+  // 3) stride locality: large strides in U outside
+  auto l_cmp_u = []( Loop const & i_a, Loop const & i_b ) { return i_a.stride_u > i_b.stride_u; };
+  std::stable_sort( l_loops_m.begin(), l_loops_m.end(), l_cmp_u );
+  std::stable_sort( l_loops_n.begin(), l_loops_n.end(), l_cmp_u );
+
+  // 3) traffic of A and B for both orders of the M and N groups
+  double l_size_k = l_gemm_k.size;
+  for( std::size_t l_lo = 0; l_lo < l_loops_k.size(); l_lo++ ) l_size_k *= l_loops_k[l_lo].size;
+
+  double l_size_a = l_gemm_m.size * l_size_k * i_dtype_size_in;
+  double l_size_b = l_gemm_n.size * l_size_k * i_dtype_size_in;
+
+  double l_iters_m = 1;
+  double l_iters_n = 1;
+  for( std::size_t l_lo = 0; l_lo < l_loops_m.size(); l_lo++ ) l_iters_m *= l_loops_m[l_lo].size;
+  for( std::size_t l_lo = 0; l_lo < l_loops_n.size(); l_lo++ ) l_iters_n *= l_loops_n[l_lo].size;
+
+  double l_traffic_m_outer =   l_size_a * l_iters_m * ( ( l_size_a <= m_size_l2 ) ? 1 : l_iters_n )
+                             + l_size_b * l_iters_m * l_iters_n;
+  double l_traffic_n_outer =   l_size_b * l_iters_n * ( ( l_size_b <= m_size_l2 ) ? 1 : l_iters_m )
+                             + l_size_a * l_iters_m * l_iters_n;
+
+  // assemble the optimized loop nest
+  io_loops.resize( 0 );
+  io_loops.insert( io_loops.end(), l_loops_b.begin(), l_loops_b.end() );
+
+  if( l_traffic_n_outer < l_traffic_m_outer ) {
+    io_loops.insert( io_loops.end(), l_loops_n.begin(), l_loops_n.end() );
+    io_loops.insert( io_loops.end(), l_loops_m.begin(), l_loops_m.end() );
+  }
+  else {
+    io_loops.insert( io_loops.end(), l_loops_m.begin(), l_loops_m.end() );
+    io_loops.insert( io_loops.end(), l_loops_n.begin(), l_loops_n.end() );
+  }
+
+  io_loops.insert( io_loops.end(), l_loops_k.begin(), l_loops_k.end() );
+  io_loops.push_back( l_gemm_m );
+  io_loops.push_back( l_gemm_n );
+  io_loops.push_back( l_gemm_k );
+}
@@ -0,0 +1,136 @@
+#ifndef TPP_NETS_BACKEND_LOOP_OPTIMIZER
+#define TPP_NETS_BACKEND_LOOP_OPTIMIZER
+
+#include <cstdint>
+#include <vector>
+
+namespace tpp_nets {
+  namespace backend {
+    class LoopOptimizer;
+  }
+}
+
+/**
+ * Cost model based optimizer of a contraction's loop nest.
+ *
+ * The optimizer fuses loops, blocks the loops covered by the GEMM and orders the remaining loops:
+ *   0) The loops of each type are ordered by descending strides (U first for M and N, T first for K),
+ *      i.e., the GEMM covers the fastest M, N and K loops, also if a tensor's dimensions are permuted.
+ *      Adjacent loops of the same type are fused if their strides are compatible,
+ *      i.e., the outer stride is the inner stride times the inner size in all tensors.
+ *      This allows the GEMM to cover multiple dimensions.
+ *   1) The GEMM's K block is limited such that a panel of B fits into L1,
+ *      the working set of a batch-reduce step (A, B and C blocks) has to fit into L2.
+ *   2) The GEMM's M and N blocks are reduced further until there are enough C blocks for all threads.
+ *      If there still are fewer C blocks than threads, the K block is reduced such that the K iterations can be split (split-K).
+ *   3) The outer M and N loops are ordered such that the estimated traffic of A and B is minimized,
+ *      where a block is only reused across the innermost loops if it fits into L2.
+ *      Inside the M and N groups, loops with large strides in U are placed outside.
+ *
+ * Blocks always divide the size of the blocked loop, i.e., there are no remainder blocks.
+ **/
+class tpp_nets::backend::LoopOptimizer {
+  public:
+    //! types of the loops
+    enum class loop_t : int8_t {
+      m = 0,
+      n = 1,
+      k = 2,
+      b = 3
+    };
+
+    //! single loop of a loop nest
+    struct Loop {
+      //! type of the loop
+      loop_t type;
+      //! number of iterations
+      int64_t size;
+      //! stride w.r.t. S
+      int64_t stride_s;
+      //! stride w.r.t. T
+      int64_t stride_t;
+      //! stride w.r.t. U
+      int64_t stride_u;
+      //! stride w.r.t. the bias of U
+      int64_t stride_bias;
+    };
+
+  private:
+    //! number of threads executing the loop nest
+    int64_t m_n_threads = 1;
+
+    //! size of the L1 cache in bytes
+    int64_t m_size_l1 = 0;
+
+    //! size of the L2 cache in bytes
+    int64_t m_size_l2 = 0;
+
+    //! minimum size of a block, smaller loops are not blocked
+    static constexpr int64_t m_min_block = 16;
+
+    //! targeted minimum number of C blocks per thread
+    static constexpr int64_t m_min_blocks_per_thread = 4;
+
+    /**
+     * Derives the next smaller block size of a loop.
+     *
+     * @param i_size size of the loop.
+     * @param i_block current block size.
+     * @param i_multiple the block size has to be a multiple of this value.
+     * @return largest divisor of i_size which is smaller than i_block, i_block if no such divisor exists.
+     **/
+    static int64_t next_block( int64_t i_size,
+                               int64_t i_block,
+                               int64_t i_multiple );
+
+    /**
+     * Fuses adjacent loops with compatible strides.
+     *
+     * @param io_loops loops of a single type, the first loop is the outermost one.
+     **/
+    static void fuse( std::vector< Loop > & io_loops );
+
+    /**
+     * Splits a loop into an outer and an inner loop.
+     *
+     * @param i_loop loop which is split.
+     * @param i_block size of the inner loop.
+     * @param o_outer will be set to the outer loop.
+     * @param o_inner will be set to the inner loop.
+     **/
+    static void split( Loop      i_loop,
+                       int64_t   i_block,
+                       Loop    & o_outer,
+                       Loop    & o_inner );
+
+  public:
+    /**
+     * Constructor.
+     *
+     * @param i_n_threads number of threads executing the loop nest.
+     * @param i_size_l1 size of the L1 cache in bytes.
+     * @param i_size_l2 size of the L2 cache in bytes.
+     **/
+    LoopOptimizer( int64_t i_n_threads,
+                   int64_t i_size_l1 = 32 * 1024,
+                   int64_t i_size_l2 = 1024 * 1024 );
+
+    /**
+     * Optimizes a loop nest.
+     *
+     * On input, the loops might be given in any order.
+     * On output, the loops are ordered as follows:
+     *   B loops, outer M and N loops (slowest first), outer K loops, GEMM's M loop, GEMM's N loop, GEMM's K loop.
+     *
+     * @param i_dtype_size_in size of an element of S and T in bytes.
+     * @param i_dtype_size_out size of an element of U in bytes.
+     * @param i_k_multiple the GEMM's K block has to be a multiple of this value.
+     * @param io_loops loops which are optimized.
+     **/
+    void optimize( int64_t             i_dtype_size_in,
+                   int64_t             i_dtype_size_out,
+                   int64_t             i_k_multiple,
+                   std::vector< Loop > & io_loops ) const;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include <catch2/catch.hpp>
+#include "LoopOptimizer.h"
+
+TEST_CASE( "Tests the loop optimizer for a contraction which doesn't require blocking.",
+           "[tpp_nets][LoopOptimizer][no_blocking]" ) {
+  typedef tpp_nets::backend::LoopOptimizer::loop_t loop_t;
+
+  // column-major A, B and C
+  //                                                                     type    size    s     t     u  bias
+  std::vector< tpp_nets::backend::LoopOptimizer::Loop > l_loops = { { loop_t::m,    8, 256,    0, 1024, 0 },
+                                                                    { loop_t::n,   16,   0, 1024, 8192, 0 },
+                                                                    { loop_t::m,   16,   1,    0,    1, 0 },
+                                                                    { loop_t::n,   64,   0,   16,   16, 0 },
+                                                                    { loop_t::k,   16,  16,    1,    0, 0 } };
+
+  tpp_nets::backend::LoopOptimizer l_opt( 4 );
+  l_opt.optimize( 4,
+                  4,
+                  1,
+                  l_loops );
+
+  REQUIRE( l_loops.size() == 5 );
+
+  // GEMM
+  REQUIRE( l_loops[2].type == loop_t::m );
+  REQUIRE( l_loops[2].size == 16 );
+  REQUIRE( l_loops[3].type == loop_t::n );
+  REQUIRE( l_loops[3].size == 64 );
+  REQUIRE( l_loops[4].type == loop_t::k );
+  REQUIRE( l_loops[4].size == 16 );
+
+  // A is smaller than B: B is reused, i.e., the N loop is the outer one
+  REQUIRE( l_loops[0].type == loop_t::n );
+  REQUIRE( l_loops[1].type == loop_t::m );
+}
+
+TEST_CASE( "Tests the loop optimizer's fusion of dimensions.",
+           "[tpp_nets][LoopOptimizer][fusion]" ) {
+  typedef tpp_nets::backend::LoopOptimizer::loop_t loop_t;
+
+  // S: k0 k1 m0 m1, T: n0 n1 k0 k1, U: n0 n1 m0 m1, all dimensions have size 8
+  //                                                                     type    size    s    t    u  bias
+  std::vector< tpp_nets::backend::LoopOptimizer::Loop > l_loops = { { loop_t::m,    8,   8,   0,   8, 0 },
+                                                                    { loop_t::m,    8,   1,   0,   1, 0 },
+                                                                    { loop_t::n,    8,   0, 512, 512, 0 },
+                                                                    { loop_t::n,    8,   0,  64,  64, 0 },
+                                                                    { loop_t::k,    8, 512,   8,   0, 0 },
+                                                                    { loop_t::k,    8,  64,   1,   0, 0 } };
+
+  tpp_nets::backend::LoopOptimizer l_opt( 1 );
+  l_opt.optimize( 4,
+                  4,
+                  1,
+                  l_loops );
+
+  // a single 64x64x64 GEMM, which is blocked for the parallelization
+  REQUIRE( l_loops.size() == 5 );
+
+  REQUIRE( l_loops[0].size * l_loops[1].size * l_loops[2].size * l_loops[3].size == 64 * 64 );
+  REQUIRE( l_loops[2].size >= 32 );
+  REQUIRE( l_loops[3].size >= 32 );
+
+  REQUIRE( l_loops[4].type     == loop_t::k );
+  REQUIRE( l_loops[4].size     == 64 );
+  REQUIRE( l_loops[4].stride_s == 64 );
+  REQUIRE( l_loops[4].stride_t == 1 );
+}
+
+TEST_CASE( "Tests the loop optimizer's blocking for caches and threads.",
+           "[tpp_nets][LoopOptimizer][blocking]" ) {
+  typedef tpp_nets::backend::LoopOptimizer::loop_t loop_t;
+
+  //                                                                     type    size      s      t     u  bias
+  std::vector< tpp_nets::backend::LoopOptimizer::Loop > l_loops = { { loop_t::b,    2, 32768, 65536, 8192, 0 },
+                                                                    { loop_t::m,   64,     1,     0,    1, 1 },
+                                                                    { loop_t::n,  128,     0,   512,   64, 0 },
+                                                                    { loop_t::k,  512,    64,     1,    0, 0 } };
+
+  // 8KiB L1 and 64KiB L2
+  tpp_nets::backend::LoopOptimizer l_opt( 8,
+                                          8 * 1024,
+                                          64 * 1024 );
+  l_opt.optimize( 2,
+                  4,
+                  2,
+                  l_loops );
+
+  // B loop stays outermost
+  REQUIRE( l_loops[0].type == loop_t::b );
+
+  // blocks divide the original sizes, the K block is a multiple of two
+  tpp_nets::backend::LoopOptimizer::Loop l_gemm_m = l_loops[ l_loops.size()-3 ];
+  tpp_nets::backend::LoopOptimizer::Loop l_gemm_n = l_loops[ l_loops.size()-2 ];
+  tpp_nets::backend::LoopOptimizer::Loop l_gemm_k = l_loops[ l_loops.size()-1 ];
+
+  REQUIRE( 64  % l_gemm_m.size == 0 );
+  REQUIRE( 128 % l_gemm_n.size == 0 );
+  REQUIRE( 512 % l_gemm_k.size == 0 );
+  REQUIRE( l_gemm_k.size % 2 == 0 );
+
+  // working set of a batch-reduce step fits into half of L2
+  int64_t l_ws =   ( l_gemm_m.size * l_gemm_k.size + l_gemm_k.size * l_gemm_n.size ) * 2
+                 + l_gemm_m.size * l_gemm_n.size * 4;
+  REQUIRE( l_ws <= 32 * 1024 );
+
+  // the inner loops keep their strides, the outer loops iterate over blocks
+  int64_t l_size[4] = { 1, 1, 1, 1 };
+  int64_t l_n_blocks = 1;
+  for( std::size_t l_lo = 0; l_lo < l_loops.size(); l_lo++ ) {
+    l_size[ (int) l_loops[l_lo].type ] *= l_loops[l_lo].size;
+
+    if(    l_lo < l_loops.size()-3
+        && l_loops[l_lo].type != loop_t::k ) {
+      l_n_blocks *= l_loops[l_lo].size;
+    }
+
+    if( l_loops[l_lo].type == loop_t::m && l_lo != l_loops.size()-3 ) {
+      REQUIRE( l_loops[l_lo].stride_s    == l_gemm_m.size );
+      REQUIRE( l_loops[l_lo].stride_bias == l_gemm_m.size );
+    }
+  }
+  REQUIRE( l_size[0] == 64 );
+  REQUIRE( l_size[1] == 128 );
+  REQUIRE( l_size[2] == 512 );
+  REQUIRE( l_size[3] == 2 );
+
+  // enough blocks for all threads
+  REQUIRE( l_n_blocks >= 4 * 8 );
+}
+
+TEST_CASE( "Tests the loop optimizer's blocking of K if there are fewer C blocks than threads.",
+           "[tpp_nets][LoopOptimizer][split_k]" ) {
+  typedef tpp_nets::backend::LoopOptimizer::loop_t loop_t;
+
+  //                                                                     type    size     s     t   u  bias
+  std::vector< tpp_nets::backend::LoopOptimizer::Loop > l_loops = { { loop_t::m,    4,    1,    0,  1, 0 },
+                                                                    { loop_t::n,    3,    0, 1024,  4, 0 },
+                                                                    { loop_t::k, 1024,    4,    1,  0, 0 } };
+
+  // 32KiB L1 and 1MiB L2
+  tpp_nets::backend::LoopOptimizer l_opt( 8,
+                                          32 * 1024,
+                                          1024 * 1024 );
+  l_opt.optimize( 4,
+                  4,
+                  1,
+                  l_loops );
+
+  // a single C block, the K loop is blocked such that every thread gets a K iteration
+  REQUIRE( l_loops.size() == 4 );
+  REQUIRE( l_loops[0].type     == loop_t::k );
+  REQUIRE( l_loops[0].size     == 8 );
+  REQUIRE( l_loops[0].stride_s == 4 * 128 );
+  REQUIRE( l_loops[0].stride_t == 128 );
+
+  REQUIRE( l_loops[1].size == 4 );
+  REQUIRE( l_loops[2].size == 3 );
+  REQUIRE( l_loops[3].size == 128 );
+}
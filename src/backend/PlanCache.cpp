@@ -0,0 +1,193 @@
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <omp.h>
+#include "PlanCache.h"
+
+std::size_t tpp_nets::backend::PlanCache::KeyHash::operator()( std::vector< int64_t > const & i_key ) const {
+  // FNV-1a like combination of the entries
+  std::size_t l_hash = 14695981039346656037ull;
+  for( std::size_t l_en = 0; l_en < i_key.size(); l_en++ ) {
+    l_hash ^= std::hash< int64_t >{}( i_key[l_en] );
+    l_hash *= 1099511628211ull;
+  }
+  return l_hash;
+}
+
+void tpp_nets::backend::PlanCache::key( int64_t                  i_n_dims_s,
+                                        int64_t                  i_n_dims_t,
+                                        int64_t                  i_n_dims_u,
+                                        int64_t          const * i_sizes_s,
+                                        int64_t          const * i_sizes_t,
+                                        int8_t           const * i_types_s,
+                                        int8_t           const * i_types_t,
+                                        int8_t           const * i_types_u,
+                                        int64_t          const * i_strides_s,
+                                        int64_t          const * i_strides_t,
+                                        int64_t          const * i_strides_u,
+                                        dtype_t                  i_dtype_in,
+                                        dtype_t                  i_dtype_out,
+                                        Epilogue         const & i_epilogue,
+                                        int64_t                  i_n_threads,
+                                        std::vector< int64_t > & o_key ) {
+  o_key.resize( 0 );
+
+  o_key.push_back( (int64_t) i_dtype_in );
+  o_key.push_back( (int64_t) i_dtype_out );
+
+  // the loop nest is optimized for the number of threads
+  o_key.push_back( i_n_threads );
+
+  o_key.push_back( i_n_dims_s );
+  o_key.push_back( i_n_dims_t );
+  o_key.push_back( i_n_dims_u );
+
+  for( int64_t l_di = 0; l_di < i_n_dims_s; l_di++ ) {
+    o_key.push_back( i_sizes_s[l_di] );
+    o_key.push_back( i_types_s[l_di] );
+    o_key.push_back( i_strides_s[l_di] );
+  }
+  for( int64_t l_di = 0; l_di < i_n_dims_t; l_di++ ) {
+    o_key.push_back( i_sizes_t[l_di] );
+    o_key.push_back( i_types_t[l_di] );
+    o_key.push_back( i_strides_t[l_di] );
+  }
+  for( int64_t l_di = 0; l_di < i_n_dims_u; l_di++ ) {
+    o_key.push_back( i_types_u[l_di] );
+    o_key.push_back( i_strides_u[l_di] );
+  }
+
+  // epilogue, the scaling factor is stored bitwise
+  int64_t l_alpha = 0;
+  std::memcpy( &l_alpha, &i_epilogue.alpha, sizeof(double) );
+
+  o_key.push_back( i_epilogue.zero_u );
+  o_key.push_back( l_alpha );
+  o_key.push_back( (int64_t) i_epilogue.act );
+  o_key.push_back( i_epilogue.strides_bias != nullptr );
+  if( i_epilogue.strides_bias != nullptr ) {
+    for( int64_t l_di = 0; l_di < i_n_dims_u; l_di++ ) {
+      o_key.push_back( i_epilogue.strides_bias[l_di] );
+    }
+  }
+}
+
+tpp_nets::backend::PlanCache::PlanCache( std::size_t i_capacity ) {
+  assert( i_capacity > 0 );
+  m_capacity = i_capacity;
+}
+
+tpp_nets::backend::PlanCache & tpp_nets::backend::PlanCache::instance() {
+  static PlanCache l_cache;
+  return l_cache;
+}
+
+std::shared_ptr< tpp_nets::backend::ContractionPlan const > tpp_nets::backend::PlanCache::get( int64_t         i_n_dims_s,
+                                                                                               int64_t         i_n_dims_t,
+                                                                                               int64_t         i_n_dims_u,
+                                                                                               int64_t const * i_sizes_s,
+                                                                                               int64_t const * i_sizes_t,
+                                                                                               int8_t  const * i_types_s,
+                                                                                               int8_t  const * i_types_t,
+                                                                                               int8_t  const * i_types_u,
+                                                                                               int64_t const * i_strides_s,
+                                                                                               int64_t const * i_strides_t,
+                                                                                               int64_t const * i_strides_u,
+                                                                                               dtype_t         i_dtype_in,
+                                                                                               dtype_t         i_dtype_out,
+                                                                                               Epilogue const& i_epilogue,
+                                                                                               int64_t         i_n_threads ) {
+  int64_t l_n_threads = ( i_n_threads > 0 ) ? i_n_threads : omp_get_max_threads();
+
+  // the key's buffer is reused to avoid allocations on the hot path
+  thread_local std::vector< int64_t > l_key;
+  key( i_n_dims_s,
+       i_n_dims_t,
+       i_n_dims_u,
+       i_sizes_s,
+       i_sizes_t,
+       i_types_s,
+       i_types_t,
+       i_types_u,
+       i_strides_s,
+       i_strides_t,
+       i_strides_u,
+       i_dtype_in,
+       i_dtype_out,
+       i_epilogue,
+       l_n_threads,
+       l_key );
+
+  // lookup
+  {
+    std::shared_lock< std::shared_mutex > l_lock( m_mutex );
+    auto l_it = m_plans.find( l_key );
+    if( l_it != m_plans.end() ) {
+      m_n_hits.fetch_add( 1, std::memory_order_relaxed );
+      return l_it->second;
+    }
+  }
+  m_n_misses.fetch_add( 1, std::memory_order_relaxed );
+
+  // construct plan outside of the lock
+  std::shared_ptr< ContractionPlan > l_plan = std::make_shared< ContractionPlan >();
+  l_plan->init( i_n_dims_s,
+                i_n_dims_t,
+                i_n_dims_u,
+                i_sizes_s,
+                i_sizes_t,
+                i_types_s,
+                i_types_t,
+                i_types_u,
+                i_strides_s,
+                i_strides_t,
+                i_strides_u,
+                i_dtype_in,
+                i_dtype_out,
+                i_epilogue,
+                l_n_threads );
+
+  // insert plan, another thread might have been faster
+  std::unique_lock< std::shared_mutex > l_lock( m_mutex );
+  auto l_ins = m_plans.emplace( l_key,
+                                l_plan );
+  if( l_ins.second ) {
+    m_keys.push_back( l_key );
+
+    while( m_plans.size() > m_capacity ) {
+      m_plans.erase( m_keys.front() );
+      m_keys.pop_front();
+      m_n_evictions.fetch_add( 1, std::memory_order_relaxed );
+    }
+  }
+
+  return l_ins.first->second;
+}
+
+void tpp_nets::backend::PlanCache::set_capacity( std::size_t i_capacity ) {
+  assert( i_capacity > 0 );
+
+  std::unique_lock< std::shared_mutex > l_lock( m_mutex );
+  m_capacity = i_capacity;
+
+  while( m_plans.size() > m_capacity ) {
+    m_plans.erase( m_keys.front() );
+    m_keys.pop_front();
+    m_n_evictions.fetch_add( 1, std::memory_order_relaxed );
+  }
+}
+
+void tpp_nets::backend::PlanCache::clear() {
+  std::unique_lock< std::shared_mutex > l_lock( m_mutex );
+  m_plans.clear();
+  m_keys.clear();
+
+  m_n_hits = 0;
+  m_n_misses = 0;
+  m_n_evictions = 0;
+}
+
+std::size_t tpp_nets::backend::PlanCache::size() const {
+  std::shared_lock< std::shared_mutex > l_lock( m_mutex );
+  return m_plans.size();
+}
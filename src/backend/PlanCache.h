@@ -0,0 +1,187 @@
+#ifndef TPP_NETS_BACKEND_PLAN_CACHE
+#define TPP_NETS_BACKEND_PLAN_CACHE
+
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "ContractionPlan.h"
+
+namespace tpp_nets {
+  namespace backend {
+    class PlanCache;
+  }
+}
+
+/**
+ * Thread-safe cache of contraction plans.
+ *
+ * Plans are keyed by the geometry of the contraction (number of dimensions, sizes, types, strides), the datatypes, the epilogue
+ * and the number of threads executing the plan.
+ * Lookups only acquire a shared lock, plans are constructed outside of the lock on a miss.
+ * If the number of cached plans exceeds the capacity, the oldest plans are evicted (FIFO).
+ * Evicted plans stay valid as long as a caller holds a reference.
+ **/
+class tpp_nets::backend::PlanCache {
+  private:
+    //! hash of a key
+    struct KeyHash {
+      std::size_t operator()( std::vector< int64_t > const & i_key ) const;
+    };
+
+    //! maximum number of cached plans
+    std::size_t m_capacity = 0;
+
+    //! mutex protecting the map and the eviction queue
+    mutable std::shared_mutex m_mutex;
+
+    //! cached plans
+    std::unordered_map< std::vector< int64_t >,
+                        std::shared_ptr< ContractionPlan const >,
+                        KeyHash > m_plans;
+
+    //! keys in insertion order, used for eviction
+    std::deque< std::vector< int64_t > > m_keys;
+
+    //! number of hits
+    std::atomic< uint64_t > m_n_hits = 0;
+    //! number of misses
+    std::atomic< uint64_t > m_n_misses = 0;
+    //! number of evictions
+    std::atomic< uint64_t > m_n_evictions = 0;
+
+    /**
+     * Derives the key of a contraction.
+     *
+     * @param i_n_dims_s S's number of dimensions.
+     * @param i_n_dims_t T's number of dimensions.
+     * @param i_n_dims_u U's number of dimensions.
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_types_s types of S's dimensions.
+     * @param i_types_t types of T's dimensions.
+     * @param i_types_u types of U's dimensions.
+     * @param i_strides_s strides of S's dimensions.
+     * @param i_strides_t strides of T's dimensions.
+     * @param i_strides_u strides of U's dimensions.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     * @param i_n_threads number of threads executing the plan.
+     * @param o_key will be set to the key.
+     **/
+    static void key( int64_t                  i_n_dims_s,
+                     int64_t                  i_n_dims_t,
+                     int64_t                  i_n_dims_u,
+                     int64_t          const * i_sizes_s,
+                     int64_t          const * i_sizes_t,
+                     int8_t           const * i_types_s,
+                     int8_t           const * i_types_t,
+                     int8_t           const * i_types_u,
+                     int64_t          const * i_strides_s,
+                     int64_t          const * i_strides_t,
+                     int64_t          const * i_strides_u,
+                     dtype_t                  i_dtype_in,
+                     dtype_t                  i_dtype_out,
+                     Epilogue         const & i_epilogue,
+                     int64_t                  i_n_threads,
+                     std::vector< int64_t > & o_key );
+
+  public:
+    /**
+     * Constructor.
+     *
+     * @param i_capacity maximum number of cached plans.
+     **/
+    PlanCache( std::size_t i_capacity = 1024 );
+
+    /**
+     * Gets the process-wide plan cache.
+     *
+     * @return plan cache.
+     **/
+    static PlanCache & instance();
+
+    /**
+     * Gets the plan of the given contraction.
+     * The plan is constructed and inserted into the cache on a miss.
+     *
+     * @param i_n_dims_s S's number of dimensions.
+     * @param i_n_dims_t T's number of dimensions.
+     * @param i_n_dims_u U's number of dimensions.
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_types_s types of S's dimensions (0: M, 1: K, 2: B).
+     * @param i_types_t types of T's dimensions (0: N, 1: K, 2: B).
+     * @param i_types_u types of U's dimensions (0: M, 1: N, 2: B).
+     * @param i_strides_s strides of S's dimensions.
+     * @param i_strides_t strides of T's dimensions.
+     * @param i_strides_u strides of U's dimensions.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_epilogue initialization of U and epilogue applied to U.
+     * @param i_n_threads number of threads executing the plan, 0 for omp_get_max_threads().
+     * @return contraction plan.
+     **/
+    std::shared_ptr< ContractionPlan const > get( int64_t         i_n_dims_s,
+                                                  int64_t         i_n_dims_t,
+                                                  int64_t         i_n_dims_u,
+                                                  int64_t const * i_sizes_s,
+                                                  int64_t const * i_sizes_t,
+                                                  int8_t  const * i_types_s,
+                                                  int8_t  const * i_types_t,
+                                                  int8_t  const * i_types_u,
+                                                  int64_t const * i_strides_s,
+                                                  int64_t const * i_strides_t,
+                                                  int64_t const * i_strides_u,
+                                                  dtype_t         i_dtype_in  = dtype_t::fp32,
+                                                  dtype_t         i_dtype_out = dtype_t::fp32,
+                                                  Epilogue const& i_epilogue  = Epilogue(),
+                                                  int64_t         i_n_threads = 0 );
+
+    /**
+     * Sets the capacity of the cache.
+     * Evicts plans if the new capacity is smaller than the number of cached plans.
+     *
+     * @param i_capacity maximum number of cached plans.
+     **/
+    void set_capacity( std::size_t i_capacity );
+
+    /**
+     * Removes all plans from the cache and resets the counters.
+     **/
+    void clear();
+
+    /**
+     * Gets the number of cached plans.
+     *
+     * @return number of cached plans.
+     **/
+    std::size_t size() const;
+
+    /**
+     * Gets the number of hits.
+     *
+     * @return number of hits.
+     **/
+    uint64_t n_hits() const { return m_n_hits.load( std::memory_order_relaxed ); }
+
+    /**
+     * Gets the number of misses.
+     *
+     * @return number of misses.
+     **/
+    uint64_t n_misses() const { return m_n_misses.load( std::memory_order_relaxed ); }
+
+    /**
+     * Gets the number of evictions.
+     *
+     * @return number of evictions.
+     **/
+    uint64_t n_evictions() const { return m_n_evictions.load( std::memory_order_relaxed ); }
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include <omp.h>
+#include "PlanCache.h"
+
+TEST_CASE( "Tests hits, misses and evictions of the plan cache.",
+           "[tpp_nets][PlanCache][get]" ) {
+  //                          k0  m0  k1  m1
+  int64_t l_sizes_s_0[4] = { 17,  5, 22, 13 };
+  //                          n0  k0  n1  k1
+  int64_t l_sizes_t_0[4] = {  8, 17,  7, 22 };
+  //                          k0  m0  k1  m1
+  int64_t l_sizes_s_1[4] = {  3,  4,  5,  6 };
+  //                          n0  k0  n1  k1
+  int64_t l_sizes_t_1[4] = {  7,  3,  8,  5 };
+
+  at::Tensor l_s_0 = at::rand( l_sizes_s_0 );
+  at::Tensor l_t_0 = at::rand( l_sizes_t_0 );
+  at::Tensor l_u_0 = at::zeros( { 8, 5, 7, 13 } );
+
+  at::Tensor l_s_1 = at::rand( l_sizes_s_1 );
+  at::Tensor l_t_1 = at::rand( l_sizes_t_1 );
+  at::Tensor l_u_1 = at::zeros( { 7, 4, 8, 6 } );
+
+  std::vector< int64_t > l_strides_s_0 = l_s_0.strides().vec();
+  std::vector< int64_t > l_strides_t_0 = l_t_0.strides().vec();
+  std::vector< int64_t > l_strides_u_0 = l_u_0.strides().vec();
+
+  std::vector< int64_t > l_strides_s_1 = l_s_1.strides().vec();
+  std::vector< int64_t > l_strides_t_1 = l_t_1.strides().vec();
+  std::vector< int64_t > l_strides_u_1 = l_u_1.strides().vec();
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::PlanCache l_cache( 1 );
+
+  // first geometry: miss, hit
+  std::shared_ptr< tpp_nets::backend::ContractionPlan const > l_plan_0 = nullptr;
+  for( int l_re = 0; l_re < 2; l_re++ ) {
+    l_plan_0 = l_cache.get( 4,
+                            4,
+                            4,
+                            l_sizes_s_0,
+                            l_sizes_t_0,
+                            l_types_s,
+                            l_types_t,
+                            l_types_u,
+                            l_strides_s_0.data(),
+                            l_strides_t_0.data(),
+                            l_strides_u_0.data() );
+  }
+  REQUIRE( l_cache.n_misses()    == 1 );
+  REQUIRE( l_cache.n_hits()      == 1 );
+  REQUIRE( l_cache.n_evictions() == 0 );
+  REQUIRE( l_cache.size()        == 1 );
+
+  // second geometry: miss which evicts the first plan
+  std::shared_ptr< tpp_nets::backend::ContractionPlan const > l_plan_1 = l_cache.get( 4,
+                                                                                      4,
+                                                                                      4,
+                                                                                      l_sizes_s_1,
+                                                                                      l_sizes_t_1,
+                                                                                      l_types_s,
+                                                                                      l_types_t,
+                                                                                      l_types_u,
+                                                                                      l_strides_s_1.data(),
+                                                                                      l_strides_t_1.data(),
+                                                                                      l_strides_u_1.data() );
+  REQUIRE( l_cache.n_misses()    == 2 );
+  REQUIRE( l_cache.n_hits()      == 1 );
+  REQUIRE( l_cache.n_evictions() == 1 );
+  REQUIRE( l_cache.size()        == 1 );
+
+  // evicted plans stay valid
+  l_plan_0->execute( l_s_0.data_ptr(),
+                     l_t_0.data_ptr(),
+                     l_u_0.data_ptr() );
+
+  l_plan_1->execute( l_s_1.data_ptr(),
+                     l_t_1.data_ptr(),
+                     l_u_1.data_ptr() );
+
+  at::Tensor l_ref_0 = at::einsum( "abcd,eafc->ebfd",
+                                   {l_s_0, l_t_0} );
+
+  at::Tensor l_ref_1 = at::einsum( "abcd,eafc->ebfd",
+                                   {l_s_1, l_t_1} );
+
+  REQUIRE( at::allclose( l_u_0,
+                         l_ref_0 ) );
+
+  REQUIRE( at::allclose( l_u_1,
+                         l_ref_1 ) );
+
+  l_cache.clear();
+  REQUIRE( l_cache.size()     == 0 );
+  REQUIRE( l_cache.n_misses() == 0 );
+}
+TEST_CASE( "Tests plans of the plan cache for different numbers of threads.",
+           "[tpp_nets][PlanCache][n_threads]" ) {
+  //                        k0  m0  k1  m1
+  int64_t l_sizes_s[4] = { 17,  5, 22, 13 };
+  //                        n0  k0  n1  k1
+  int64_t l_sizes_t[4] = {  8, 17,  7, 22 };
+
+  int64_t l_strides_s[4] = { 5*22*13, 22*13, 13, 1 };
+  int64_t l_strides_t[4] = { 17*7*22,  7*22, 22, 1 };
+  int64_t l_strides_u[4] = {  5*7*13,  7*13, 13, 1 };
+
+  int8_t l_types_s[4] = { 1, 0, 1, 0 };
+  int8_t l_types_t[4] = { 0, 1, 0, 1 };
+  int8_t l_types_u[4] = { 1, 0, 1, 0 };
+
+  tpp_nets::backend::PlanCache l_cache;
+
+  // the plans are optimized for the number of executing threads, which is part of the key
+  std::shared_ptr< tpp_nets::backend::ContractionPlan const > l_plans[3];
+  int64_t l_n_threads[3] = { 0, 3, 3 };
+  for( int64_t l_pl = 0; l_pl < 3; l_pl++ ) {
+    l_plans[l_pl] = l_cache.get( 4,
+                                 4,
+                                 4,
+                                 l_sizes_s,
+                                 l_sizes_t,
+                                 l_types_s,
+                                 l_types_t,
+                                 l_types_u,
+                                 l_strides_s,
+                                 l_strides_t,
+                                 l_strides_u,
+                                 tpp_nets::backend::dtype_t::fp32,
+                                 tpp_nets::backend::dtype_t::fp32,
+                                 tpp_nets::backend::Epilogue(),
+                                 l_n_threads[l_pl] );
+  }
+
+  REQUIRE( l_plans[0]->n_threads() == omp_get_max_threads() );
+  REQUIRE( l_plans[1]->n_threads() == 3 );
+  REQUIRE( l_plans[2] == l_plans[1] );
+
+  std::size_t l_n_plans = ( omp_get_max_threads() == 3 ) ? 1 : 2;
+  REQUIRE( l_cache.size()   == l_n_plans );
+  REQUIRE( l_cache.n_hits() == 3 - l_n_plans );
+}
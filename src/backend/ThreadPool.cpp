@@ -0,0 +1,128 @@
+#include <cassert>
+#include <chrono>
+#include <omp.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ThreadPool.h"
+
+namespace {
+  /**
+   * Hints the core that the calling thread spins.
+   **/
+  inline void spin_pause() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile( "yield" );
+#endif
+  }
+}
+
+tpp_nets::backend::ThreadPool::ThreadPool( int64_t                        i_n_threads,
+                                           int64_t                        i_spin_us,
+                                           std::vector< int64_t > const & i_cpus ) {
+  assert( i_n_threads > 0 );
+  assert( i_cpus.empty() || (int64_t) i_cpus.size() == i_n_threads - 1 );
+
+  m_n_threads = i_n_threads;
+  m_spin_us = i_spin_us;
+
+  for( int64_t l_tid = 1; l_tid < m_n_threads; l_tid++ ) {
+    m_workers.emplace_back( &ThreadPool::work,
+                            this,
+                            l_tid,
+                            i_cpus.empty() ? -1 : i_cpus[l_tid-1] );
+  }
+}
+
+tpp_nets::backend::ThreadPool::~ThreadPool() {
+  m_stop.store( true, std::memory_order_relaxed );
+  m_epoch.fetch_add( 1, std::memory_order_release );
+  m_epoch.notify_all();
+
+  for( std::size_t l_wo = 0; l_wo < m_workers.size(); l_wo++ ) {
+    m_workers[l_wo].join();
+  }
+}
+
+tpp_nets::backend::ThreadPool & tpp_nets::backend::ThreadPool::instance() {
+  static ThreadPool l_pool( omp_get_max_threads() );
+  return l_pool;
+}
+
+void tpp_nets::backend::ThreadPool::work( int64_t i_tid,
+                                          int64_t i_cpu ) {
+  if( i_cpu >= 0 ) {
+    cpu_set_t l_cpus;
+    CPU_ZERO( &l_cpus );
+    CPU_SET( i_cpu, &l_cpus );
+    pthread_setaffinity_np( pthread_self(),
+                            sizeof( cpu_set_t ),
+                            &l_cpus );
+  }
+
+  uint64_t l_epoch = 0;
+  while( true ) {
+    // spin, the clock is only read every few iterations
+    std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+    int64_t l_spin_us = m_spin_us.load( std::memory_order_relaxed );
+    int64_t l_it = 0;
+
+    while( m_epoch.load( std::memory_order_acquire ) == l_epoch ) {
+      l_it++;
+      if(    ( l_it & 255 ) == 0
+          && std::chrono::steady_clock::now() - l_start > std::chrono::microseconds( l_spin_us ) ) {
+        // park until the next region starts
+        m_epoch.wait( l_epoch,
+                      std::memory_order_acquire );
+      }
+      else {
+        spin_pause();
+      }
+    }
+    l_epoch = m_epoch.load( std::memory_order_acquire );
+
+    if( m_stop.load( std::memory_order_relaxed ) ) return;
+
+    m_fn( m_arg,
+          i_tid );
+    m_n_done.fetch_add( 1, std::memory_order_release );
+  }
+}
+
+void tpp_nets::backend::ThreadPool::run( void (* i_fn)( void const *, int64_t ),
+                                         void const * i_arg ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  if( m_n_threads > 1 ) {
+    m_fn = i_fn;
+    m_arg = i_arg;
+    m_n_done.store( 0, std::memory_order_relaxed );
+
+    // start the region and wake the parked workers
+    m_epoch.fetch_add( 1, std::memory_order_release );
+    m_epoch.notify_all();
+  }
+
+  i_fn( i_arg,
+        0 );
+
+  while( m_n_done.load( std::memory_order_acquire ) < m_n_threads - 1 ) {
+    spin_pause();
+  }
+}
+
+void tpp_nets::backend::ThreadPool::barrier() {
+  uint64_t l_barrier_epoch = m_barrier_epoch.load( std::memory_order_acquire );
+
+  if( m_n_arrived.fetch_add( 1, std::memory_order_acq_rel ) == m_n_threads - 1 ) {
+    // last thread: release the others
+    m_n_arrived.store( 0, std::memory_order_relaxed );
+    m_barrier_epoch.fetch_add( 1, std::memory_order_release );
+  }
+  else {
+    while( m_barrier_epoch.load( std::memory_order_acquire ) == l_barrier_epoch ) {
+      spin_pause();
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#ifndef TPP_NETS_BACKEND_THREAD_POOL
+#define TPP_NETS_BACKEND_THREAD_POOL
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tpp_nets {
+  namespace backend {
+    class ThreadPool;
+  }
+}
+
+/**
+ * Persistent team of threads which executes parallel regions without per-call thread startup.
+ *
+ * The calling thread of run executes thread 0, the pool's workers execute threads 1, ..., n-1.
+ * Between two regions, a worker spins on the region counter for the spin duration and parks afterwards,
+ * i.e., back-to-back regions are dispatched without waking sleeping threads,
+ * while idle workers don't occupy their cores.
+ * The workers keep their thread-local scratch (e.g., the packing buffers of the contraction plans) across regions.
+ *
+ * Regions of a pool are serialized, a region must not start another region of the same pool.
+ **/
+class tpp_nets::backend::ThreadPool {
+  private:
+    //! default duration (in microseconds) a worker spins before it parks
+    static constexpr int64_t m_spin_us_default = 200;
+
+    //! number of threads, including the calling thread
+    int64_t m_n_threads = 1;
+
+    //! duration (in microseconds) a worker spins before it parks
+    std::atomic< int64_t > m_spin_us = m_spin_us_default;
+
+    //! function of the current region
+    void (* m_fn)( void const *, int64_t ) = nullptr;
+
+    //! argument of the current region's function
+    void const * m_arg = nullptr;
+
+    //! number of started regions, workers wait (spin or park) for this counter to change
+    alignas(64) std::atomic< uint64_t > m_epoch = 0;
+
+    //! number of workers which finished the current region
+    alignas(64) std::atomic< int64_t > m_n_done = 0;
+
+    //! number of threads which arrived at the current barrier
+    alignas(64) std::atomic< int64_t > m_n_arrived = 0;
+
+    //! number of completed barriers
+    alignas(64) std::atomic< uint64_t > m_barrier_epoch = 0;
+
+    //! true if the workers shut down
+    std::atomic< bool > m_stop = false;
+
+    //! serializes the regions
+    std::mutex m_mutex;
+
+    //! worker threads
+    std::vector< std::thread > m_workers;
+
+    /**
+     * Loop of a worker.
+     *
+     * @param i_tid id of the worker's thread.
+     * @param i_cpu core to which the worker is bound, -1 if the worker isn't bound.
+     **/
+    void work( int64_t i_tid,
+               int64_t i_cpu );
+
+    /**
+     * Executes a parallel region.
+     *
+     * @param i_fn function called by every thread with the argument and the thread's id.
+     * @param i_arg argument of the function.
+     **/
+    void run( void (* i_fn)( void const *, int64_t ),
+              void const * i_arg );
+
+  public:
+    /**
+     * Constructor, launches the workers.
+     *
+     * @param i_n_threads number of threads, including the calling thread.
+     * @param i_spin_us duration (in microseconds) a worker spins before it parks.
+     * @param i_cpus cores of the workers, i.e., of threads 1, ..., n-1; empty if the workers aren't bound.
+     **/
+    ThreadPool( int64_t                        i_n_threads,
+                int64_t                        i_spin_us = m_spin_us_default,
+                std::vector< int64_t > const & i_cpus    = {} );
+
+    /**
+     * Destructor, joins the workers.
+     **/
+    ~ThreadPool();
+
+    /**
+     * Gets the process-wide pool, which has as many threads as OpenMP at first use and unbound workers.
+     *
+     * @return thread pool.
+     **/
+    static ThreadPool & instance();
+
+    /**
+     * Executes a parallel region: every thread calls i_fn( tid ), the call returns once all threads finished.
+     *
+     * @param i_fn function called by every thread with the thread's id.
+     **/
+    template< typename T >
+    void run( T const & i_fn ) {
+      run( []( void const * i_arg,
+               int64_t      i_tid ) {
+             ( *(T const *) i_arg )( i_tid );
+           },
+           &i_fn );
+    }
+
+    /**
+     * Synchronizes all threads of the current region, has to be called by every thread of the region.
+     **/
+    void barrier();
+
+    /**
+     * Sets the duration a worker spins before it parks.
+     *
+     * @param i_spin_us duration in microseconds.
+     **/
+    void set_spin( int64_t i_spin_us ) { m_spin_us.store( i_spin_us, std::memory_order_relaxed ); }
+
+    /**
+     * Gets the duration a worker spins before it parks.
+     *
+     * @return duration in microseconds.
+     **/
+    int64_t spin() const { return m_spin_us.load( std::memory_order_relaxed ); }
+
+    /**
+     * Gets the number of threads, including the calling thread.
+     *
+     * @return number of threads.
+     **/
+    int64_t n_threads() const { return m_n_threads; }
+};
+
+#endif
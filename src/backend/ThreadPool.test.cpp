@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "ThreadPool.h"
+
+TEST_CASE( "Tests the parallel regions of a thread pool.",
+           "[tpp_nets][ThreadPool][run]" ) {
+  tpp_nets::backend::ThreadPool l_pool( 4,
+                                        50 );
+  REQUIRE( l_pool.n_threads() == 4 );
+  REQUIRE( l_pool.spin() == 50 );
+
+  std::vector< int64_t > l_counts( 4, 0 );
+  std::thread::id l_caller = std::this_thread::get_id();
+  bool l_caller_is_0 = false;
+
+  for( int64_t l_re = 0; l_re < 100; l_re++ ) {
+    l_pool.run( [&]( int64_t i_tid ) {
+      l_counts[i_tid]++;
+      if( i_tid == 0 ) l_caller_is_0 = std::this_thread::get_id() == l_caller;
+    } );
+  }
+  for( int64_t l_th = 0; l_th < 4; l_th++ ) {
+    REQUIRE( l_counts[l_th] == 100 );
+  }
+  REQUIRE( l_caller_is_0 );
+
+  // regions after the workers parked
+  l_pool.set_spin( 0 );
+  std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  std::atomic< int64_t > l_sum = 0;
+  l_pool.run( [&]( int64_t i_tid ) {
+    l_sum += i_tid;
+  } );
+  REQUIRE( l_sum.load() == 6 );
+}
+
+TEST_CASE( "Tests the barrier of a thread pool.",
+           "[tpp_nets][ThreadPool][barrier]" ) {
+  tpp_nets::backend::ThreadPool l_pool( 3 );
+
+  std::atomic< int64_t > l_arrived = 0;
+  std::vector< int64_t > l_seen( 3, 0 );
+
+  for( int64_t l_re = 0; l_re < 10; l_re++ ) {
+    l_pool.run( [&]( int64_t i_tid ) {
+      l_arrived++;
+      l_pool.barrier();
+      l_seen[i_tid] = l_arrived.load();
+      l_pool.barrier();
+      // reset by a single thread after all threads read the counter
+      if( i_tid == 0 ) l_arrived = 0;
+    } );
+
+    for( int64_t l_th = 0; l_th < 3; l_th++ ) {
+      REQUIRE( l_seen[l_th] == 3 );
+    }
+  }
+}
@@ -0,0 +1,115 @@
+#include <cassert>
+#include "TilePacker.h"
+
+void tpp_nets::backend::TilePacker::init( int64_t          i_rows,
+                                          int64_t          i_cols,
+                                          int64_t          i_stride_rows,
+                                          int64_t          i_stride_cols,
+                                          libxsmm_datatype i_dtype,
+                                          int64_t          i_ld_tile ) {
+  int64_t l_ld_tile = ( i_ld_tile == 0 ) ? i_rows : i_ld_tile;
+  assert( l_ld_tile >= i_rows );
+
+  int64_t l_dtype_size = LIBXSMM_TYPESIZE( i_dtype );
+  m_size = l_ld_tile * i_cols * l_dtype_size;
+
+  // strides of dimensions with a single entry are arbitrary
+  if( i_cols == 1 ) i_stride_cols = i_rows;
+  if( i_rows == 1 ) i_stride_rows = 1;
+
+  libxsmm_meltw_unary_type l_type = LIBXSMM_MELTW_TYPE_UNARY_IDENTITY;
+  libxsmm_meltw_unary_shape l_shape_pack;
+  libxsmm_meltw_unary_shape l_shape_unpack;
+
+  m_n_calls = 1;
+  m_stride_calls_tensor = 0;
+  m_stride_calls_tile = 0;
+
+  if( i_stride_rows == 1 ) {
+    // columns are contiguous
+    l_shape_pack = libxsmm_create_meltw_unary_shape( i_rows,
+                                                     i_cols,
+                                                     i_stride_cols,
+                                                     l_ld_tile,
+                                                     i_dtype,
+                                                     i_dtype,
+                                                     i_dtype );
+    l_shape_unpack = libxsmm_create_meltw_unary_shape( i_rows,
+                                                       i_cols,
+                                                       l_ld_tile,
+                                                       i_stride_cols,
+                                                       i_dtype,
+                                                       i_dtype,
+                                                       i_dtype );
+  }
+  else if( i_stride_cols == 1 ) {
+    // rows are contiguous
+    l_type = LIBXSMM_MELTW_TYPE_UNARY_TRANSFORM_NORM_TO_NORMT;
+    l_shape_pack = libxsmm_create_meltw_unary_shape( i_cols,
+                                                     i_rows,
+                                                     i_stride_rows,
+                                                     l_ld_tile,
+                                                     i_dtype,
+                                                     i_dtype,
+                                                     i_dtype );
+    l_shape_unpack = libxsmm_create_meltw_unary_shape( i_rows,
+                                                       i_cols,
+                                                       l_ld_tile,
+                                                       i_stride_rows,
+                                                       i_dtype,
+                                                       i_dtype,
+                                                       i_dtype );
+  }
+  else {
+    // no contiguous dimension: every column is copied separately
+    l_shape_pack = libxsmm_create_meltw_unary_shape( 1,
+                                                     i_rows,
+                                                     i_stride_rows,
+                                                     1,
+                                                     i_dtype,
+                                                     i_dtype,
+                                                     i_dtype );
+    l_shape_unpack = libxsmm_create_meltw_unary_shape( 1,
+                                                       i_rows,
+                                                       1,
+                                                       i_stride_rows,
+                                                       i_dtype,
+                                                       i_dtype,
+                                                       i_dtype );
+
+    m_n_calls = i_cols;
+    m_stride_calls_tensor = i_stride_cols * l_dtype_size;
+    m_stride_calls_tile = l_ld_tile * l_dtype_size;
+  }
+
+  m_pack = libxsmm_dispatch_meltw_unary_v2( l_type,
+                                            l_shape_pack,
+                                            LIBXSMM_MELTW_FLAG_UNARY_NONE );
+  m_unpack = libxsmm_dispatch_meltw_unary_v2( l_type,
+                                              l_shape_unpack,
+                                              LIBXSMM_MELTW_FLAG_UNARY_NONE );
+  assert( m_pack != nullptr );
+  assert( m_unpack != nullptr );
+}
+
+void tpp_nets::backend::TilePacker::pack( void const * i_tensor,
+                                          void       * o_tile ) const {
+  libxsmm_meltw_unary_param l_param;
+
+  for( int64_t l_ca = 0; l_ca < m_n_calls; l_ca++ ) {
+    l_param.in.primary  = (char *) i_tensor + l_ca * m_stride_calls_tensor;
+    l_param.out.primary = (char *) o_tile   + l_ca * m_stride_calls_tile;
+    m_pack( &l_param );
+  }
+}
+
+void tpp_nets::backend::TilePacker::unpack( void const * i_tile,
+                                            void       * o_tensor ) const {
+  libxsmm_meltw_unary_param l_param;
+
+  for( int64_t l_ca = 0; l_ca < m_n_calls; l_ca++ ) {
+    l_param.in.primary  = (char *) i_tile   + l_ca * m_stride_calls_tile;
+    l_param.out.primary = (char *) o_tensor + l_ca * m_stride_calls_tensor;
+    m_unpack( &l_param );
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef TPP_NETS_BACKEND_TILE_PACKER
+#define TPP_NETS_BACKEND_TILE_PACKER
+
+#include <cstdint>
+#include <libxsmm.h>
+
+namespace tpp_nets {
+  namespace backend {
+    class TilePacker;
+  }
+}
+
+/**
+ * Copies a strided two-dimensional block of a tensor to a contiguous, column-major tile and back.
+ *
+ * The copies are done through LIBXSMM TPPs:
+ *   - unit stride in the rows: copy with a leading dimension,
+ *   - unit stride in the columns: transpose,
+ *   - no unit stride: strided copy of every column.
+ **/
+class tpp_nets::backend::TilePacker {
+  private:
+    //! kernel copying the tensor's block to the tile
+    libxsmm_meltwfunction_unary m_pack = nullptr;
+    //! kernel copying the tile to the tensor's block
+    libxsmm_meltwfunction_unary m_unpack = nullptr;
+
+    //! number of kernel calls per copy
+    int64_t m_n_calls = 1;
+    //! offset (in bytes) between two kernel calls w.r.t. the tensor
+    int64_t m_stride_calls_tensor = 0;
+    //! offset (in bytes) between two kernel calls w.r.t. the tile
+    int64_t m_stride_calls_tile = 0;
+
+    //! size of the tile in bytes
+    int64_t m_size = 0;
+
+  public:
+    /**
+     * Initializes the packer, i.e., JIT-compiles the copy kernels.
+     *
+     * @param i_rows number of rows of the block.
+     * @param i_cols number of columns of the block.
+     * @param i_stride_rows stride of the rows in the tensor.
+     * @param i_stride_cols stride of the columns in the tensor.
+     * @param i_dtype datatype of the tensor.
+     * @param i_ld_tile leading dimension of the tile, 0 if the tile's columns are contiguous (i_rows).
+     **/
+    void init( int64_t          i_rows,
+               int64_t          i_cols,
+               int64_t          i_stride_rows,
+               int64_t          i_stride_cols,
+               libxsmm_datatype i_dtype,
+               int64_t          i_ld_tile = 0 );
+
+    /**
+     * Copies a block of the tensor to the tile.
+     *
+     * @param i_tensor data pointer of the block in the tensor.
+     * @param o_tile will be set to the column-major tile.
+     **/
+    void pack( void const * i_tensor,
+               void       * o_tile ) const;
+
+    /**
+     * Copies the tile to a block of the tensor.
+     *
+     * @param i_tile column-major tile.
+     * @param o_tensor data pointer of the block in the tensor.
+     **/
+    void unpack( void const * i_tile,
+                 void       * o_tensor ) const;
+
+    /**
+     * Gets the size of the tile.
+     *
+     * @return size in bytes.
+     **/
+    int64_t size() const { return m_size; }
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include "TilePacker.h"
+
+TEST_CASE( "Tests packing and unpacking of strided blocks.",
+           "[tpp_nets][TilePacker][pack]" ) {
+  // column-major tile of a 5x7 block
+  at::Tensor l_ref = at::rand( { 7, 5 } );
+
+  //                                        rows  cols
+  int64_t l_strides[3][2] = { {  1,  9 },  // contiguous columns
+                              { 11,  1 },  // contiguous rows
+                              {  3, 17 } };// no contiguous dimension
+
+  for( int64_t l_ca = 0; l_ca < 3; l_ca++ ) {
+    at::Tensor l_tensor = at::zeros( { 7 * 17 * 5 } );
+    at::Tensor l_block = l_tensor.as_strided( { 7, 5 },
+                                              { l_strides[l_ca][1], l_strides[l_ca][0] } );
+
+    tpp_nets::backend::TilePacker l_packer;
+    l_packer.init( 5,
+                   7,
+                   l_strides[l_ca][0],
+                   l_strides[l_ca][1],
+                   LIBXSMM_DATATYPE_F32 );
+    REQUIRE( l_packer.size() == 5 * 7 * 4 );
+
+    l_packer.unpack( l_ref.data_ptr(),
+                     l_tensor.data_ptr() );
+    REQUIRE( at::equal( l_block, l_ref ) );
+
+    at::Tensor l_tile = at::zeros( { 7, 5 } );
+    l_packer.pack( l_tensor.data_ptr(),
+                   l_tile.data_ptr() );
+    REQUIRE( at::equal( l_tile, l_ref ) );
+  }
+}
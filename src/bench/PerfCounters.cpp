@@ -0,0 +1,212 @@
+#include "PerfCounters.h"
+#include <cassert>
+#include <cstring>
+#include <omp.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+int tpp_nets::bench::PerfCounters::open_event( event_t i_event ) {
+  perf_event_attr l_attr;
+  std::memset( &l_attr, 0, sizeof(l_attr) );
+  l_attr.size = sizeof(l_attr);
+  l_attr.disabled = 1;
+  l_attr.exclude_kernel = 1;
+  l_attr.exclude_hv = 1;
+  l_attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // generic cache events: cache id | operation << 8 | result << 16
+  uint64_t l_read_miss = ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+
+  if( i_event == event_t::cycles ) {
+    l_attr.type = PERF_TYPE_HARDWARE;
+    l_attr.config = PERF_COUNT_HW_CPU_CYCLES;
+  }
+  else if( i_event == event_t::instructions ) {
+    l_attr.type = PERF_TYPE_HARDWARE;
+    l_attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+  }
+  else if( i_event == event_t::l1d_misses ) {
+    l_attr.type = PERF_TYPE_HW_CACHE;
+    l_attr.config = PERF_COUNT_HW_CACHE_L1D | l_read_miss;
+  }
+  else if( i_event == event_t::llc_misses ) {
+    l_attr.type = PERF_TYPE_HW_CACHE;
+    l_attr.config = PERF_COUNT_HW_CACHE_LL | l_read_miss;
+  }
+  else if( i_event == event_t::dtlb_misses ) {
+    l_attr.type = PERF_TYPE_HW_CACHE;
+    l_attr.config = PERF_COUNT_HW_CACHE_DTLB | l_read_miss;
+  }
+  else if( i_event == event_t::fp_vector_ops ) {
+    // there is no generic event, Intel's FP_ARITH_INST_RETIRED (event 0xc7) with all packed umasks (0xfc) is used
+    bool l_intel = false;
+#if defined(__x86_64__)
+    unsigned int l_regs[4] = { 0 };
+    if( __get_cpuid( 0, &l_regs[0], &l_regs[1], &l_regs[2], &l_regs[3] ) ) {
+      // vendor string in EBX, EDX, ECX
+      l_intel = l_regs[1] == 0x756e6547 && l_regs[3] == 0x49656e69 && l_regs[2] == 0x6c65746e;
+    }
+#endif
+    if( !l_intel ) return -1;
+
+    l_attr.type = PERF_TYPE_RAW;
+    l_attr.config = 0xc7 | ( 0xfc << 8 );
+  }
+  else {
+    assert( false );
+    return -1;
+  }
+
+  // calling thread on any CPU
+  long l_fd = syscall( SYS_perf_event_open,
+                       &l_attr,
+                       0,
+                       -1,
+                       -1,
+                       0 );
+
+  return ( l_fd < 0 ) ? -1 : (int) l_fd;
+}
+
+void tpp_nets::bench::PerfCounters::read_event( int        i_fd,
+                                                 uint64_t & o_value,
+                                                 uint64_t & o_enabled,
+                                                 uint64_t & o_running ) {
+  // value, time enabled, time running
+  uint64_t l_data[3] = { 0 };
+  if( read( i_fd, l_data, sizeof(l_data) ) != sizeof(l_data) ) {
+    l_data[0] = l_data[1] = l_data[2] = 0;
+  }
+
+  o_value   = l_data[0];
+  o_enabled = l_data[1];
+  o_running = l_data[2];
+}
+
+tpp_nets::bench::PerfCounters::PerfCounters() {
+  // the events count the thread which opens them, the team might be smaller than the maximum number of threads
+#pragma omp parallel
+  {
+#pragma omp single
+    {
+      int64_t l_n_threads = omp_get_num_threads();
+      m_fds.resize( l_n_threads );
+      m_enabled.resize( l_n_threads );
+      m_running.resize( l_n_threads );
+    }
+
+    int64_t l_tid = omp_get_thread_num();
+    m_fds[l_tid].resize( m_n_events );
+    m_enabled[l_tid].assign( m_n_events, 0 );
+    m_running[l_tid].assign( m_n_events, 0 );
+    for( int64_t l_ev = 0; l_ev < m_n_events; l_ev++ ) {
+      m_fds[l_tid][l_ev] = open_event( (event_t) l_ev );
+    }
+  }
+
+  // an event is reported only if all threads count it
+  m_available.assign( m_n_events, true );
+  for( std::size_t l_th = 0; l_th < m_fds.size(); l_th++ ) {
+    for( std::size_t l_ev = 0; l_ev < m_fds[l_th].size(); l_ev++ ) {
+      if( m_fds[l_th][l_ev] < 0 ) {
+        m_available[l_ev] = false;
+      }
+    }
+  }
+
+  reset();
+}
+
+tpp_nets::bench::PerfCounters::~PerfCounters() {
+  for( std::size_t l_th = 0; l_th < m_fds.size(); l_th++ ) {
+    for( std::size_t l_ev = 0; l_ev < m_fds[l_th].size(); l_ev++ ) {
+      if( m_fds[l_th][l_ev] >= 0 ) {
+        close( m_fds[l_th][l_ev] );
+      }
+    }
+  }
+}
+
+std::string tpp_nets::bench::PerfCounters::name( event_t i_event ) {
+  if(      i_event == event_t::cycles        ) return "cycles";
+  else if( i_event == event_t::instructions  ) return "instructions";
+  else if( i_event == event_t::l1d_misses    ) return "l1d_misses";
+  else if( i_event == event_t::llc_misses    ) return "llc_misses";
+  else if( i_event == event_t::dtlb_misses   ) return "dtlb_misses";
+  else if( i_event == event_t::fp_vector_ops ) return "fp_vector_ops";
+
+  assert( false );
+  return "";
+}
+
+bool tpp_nets::bench::PerfCounters::available( event_t i_event ) const {
+  return m_available[ (int64_t) i_event ];
+}
+
+bool tpp_nets::bench::PerfCounters::available() const {
+  for( int64_t l_ev = 0; l_ev < m_n_events; l_ev++ ) {
+    if( m_available[l_ev] ) return true;
+  }
+  return false;
+}
+
+void tpp_nets::bench::PerfCounters::start() {
+  for( std::size_t l_th = 0; l_th < m_fds.size(); l_th++ ) {
+    for( std::size_t l_ev = 0; l_ev < m_fds[l_th].size(); l_ev++ ) {
+      if( m_available[l_ev] ) {
+        // the reset only clears the value, the times keep accumulating and are recorded instead
+        uint64_t l_value = 0;
+        ioctl( m_fds[l_th][l_ev], PERF_EVENT_IOC_RESET, 0 );
+        read_event( m_fds[l_th][l_ev],
+                    l_value,
+                    m_enabled[l_th][l_ev],
+                    m_running[l_th][l_ev] );
+        ioctl( m_fds[l_th][l_ev], PERF_EVENT_IOC_ENABLE, 0 );
+      }
+    }
+  }
+}
+
+void tpp_nets::bench::PerfCounters::stop() {
+  for( std::size_t l_th = 0; l_th < m_fds.size(); l_th++ ) {
+    for( std::size_t l_ev = 0; l_ev < m_fds[l_th].size(); l_ev++ ) {
+      if( m_available[l_ev] ) {
+        ioctl( m_fds[l_th][l_ev], PERF_EVENT_IOC_DISABLE, 0 );
+
+        uint64_t l_value = 0;
+        uint64_t l_enabled = 0;
+        uint64_t l_running = 0;
+        read_event( m_fds[l_th][l_ev],
+                    l_value,
+                    l_enabled,
+                    l_running );
+
+        // scale w.r.t. multiplexing since the last start
+        uint64_t l_dur_enabled = l_enabled - m_enabled[l_th][l_ev];
+        uint64_t l_dur_running = l_running - m_running[l_th][l_ev];
+        if( l_dur_running > 0 ) {
+          m_counts[l_ev] += (double) l_value * l_dur_enabled / l_dur_running;
+        }
+      }
+    }
+  }
+}
+
+void tpp_nets::bench::PerfCounters::reset() {
+  m_counts.assign( m_n_events, 0 );
+}
+
+std::vector< double > tpp_nets::bench::PerfCounters::values() const {
+  std::vector< double > l_values( m_n_events, -1 );
+  for( int64_t l_ev = 0; l_ev < m_n_events; l_ev++ ) {
+    if( m_available[l_ev] ) {
+      l_values[l_ev] = m_counts[l_ev];
+    }
+  }
+  return l_values;
+}
@@ -0,0 +1,144 @@
+#ifndef TPP_NETS_BENCH_PERF_COUNTERS
+#define TPP_NETS_BENCH_PERF_COUNTERS
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tpp_nets {
+  namespace bench {
+    class PerfCounters;
+  }
+}
+
+/**
+ * Hardware performance counters of the OpenMP threads, read through Linux' perf_event_open.
+ *
+ * The counters are opened on construction by every thread of an OpenMP parallel region,
+ * i.e., they follow the threads of the OpenMP team which executes tppdot.
+ * Only user-space events are counted. Every event is opened on its own:
+ * events which aren't supported by the CPU or not permitted (e.g., in a container or through perf_event_paranoid) are unavailable,
+ * while the remaining events are still counted.
+ * Multiplexed events are scaled by the ratio of their enabled and running times since the last start.
+ *
+ * Usage around a tppdot region:
+ *   PerfCounters l_counters;
+ *   l_counters.start();
+ *   l_plan.execute( ... );
+ *   l_counters.stop();
+ *   l_counters.values();
+ **/
+class tpp_nets::bench::PerfCounters {
+  public:
+    //! counted events
+    enum class event_t : int8_t {
+      cycles        = 0,
+      instructions  = 1,
+      l1d_misses    = 2,
+      llc_misses    = 3,
+      dtlb_misses   = 4,
+      fp_vector_ops = 5
+    };
+
+    //! number of events
+    static constexpr int64_t m_n_events = 6;
+
+  private:
+    //! file descriptors of the threads' events, -1 if unavailable
+    std::vector< std::vector< int > > m_fds;
+
+    //! enabled times of the threads' events at the last start
+    std::vector< std::vector< uint64_t > > m_enabled;
+
+    //! running times of the threads' events at the last start
+    std::vector< std::vector< uint64_t > > m_running;
+
+    //! true if an event is available on all threads
+    std::vector< bool > m_available;
+
+    //! accumulated (scaled) counts of the events
+    std::vector< double > m_counts;
+
+    /**
+     * Opens an event for the calling thread.
+     *
+     * @param i_event event.
+     * @return file descriptor of the disabled event, -1 if the event is unavailable.
+     **/
+    static int open_event( event_t i_event );
+
+    /**
+     * Reads an event.
+     *
+     * @param i_fd file descriptor of the event.
+     * @param o_value will be set to the count since the last reset, zero if the read failed.
+     * @param o_enabled will be set to the total time (in ns) the event was enabled.
+     * @param o_running will be set to the total time (in ns) the event was counted, i.e., scheduled on the PMU.
+     **/
+    static void read_event( int        i_fd,
+                            uint64_t & o_value,
+                            uint64_t & o_enabled,
+                            uint64_t & o_running );
+
+  public:
+    /**
+     * Constructor, opens the events on all threads of an OpenMP parallel region.
+     * The counters follow the threads of that team, which might be smaller than the maximum number of threads.
+     **/
+    PerfCounters();
+
+    /**
+     * Destructor, closes the events.
+     **/
+    ~PerfCounters();
+
+    PerfCounters( PerfCounters const & ) = delete;
+    PerfCounters & operator=( PerfCounters const & ) = delete;
+
+    /**
+     * Gets the name of an event.
+     *
+     * @param i_event event.
+     * @return name.
+     **/
+    static std::string name( event_t i_event );
+
+    /**
+     * Checks whether an event is available.
+     *
+     * @param i_event event.
+     * @return true if the event is counted, false otherwise.
+     **/
+    bool available( event_t i_event ) const;
+
+    /**
+     * Checks whether any event is available.
+     *
+     * @return true if at least one event is counted, false otherwise.
+     **/
+    bool available() const;
+
+    /**
+     * Resets and enables the events.
+     **/
+    void start();
+
+    /**
+     * Disables the events and adds the counts since the last start to the accumulated counts.
+     **/
+    void stop();
+
+    /**
+     * Resets the accumulated counts.
+     **/
+    void reset();
+
+    /**
+     * Gets the accumulated counts of all threads.
+     *
+     * @return counts of the events (indexed by the events' ids), -1 for unavailable events.
+     **/
+    std::vector< double > values() const;
+};
+
+#endif
@@ -1,28 +1,260 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <ctime>
 #include <fstream>
+#include <omp.h>
+#include <unistd.h>
+#include <libxsmm.h>
 #include "TensorDot.h"
 #include <ATen/ATen.h>
 #include <nlohmann/json.hpp>
 #include "../backend/BinaryContraction.h"
+#include "../backend/ContractionPlan.h"
+#include "../backend/ThreadPool.h"
+#include "PerfCounters.h"
+
+c10::ScalarType tpp_nets::bench::TensorDot::to_aten( backend::dtype_t i_dtype ) {
+  if(      i_dtype == backend::dtype_t::fp32 ) return at::kFloat;
+  else if( i_dtype == backend::dtype_t::fp64 ) return at::kDouble;
+  else if( i_dtype == backend::dtype_t::bf16 ) return at::kBFloat16;
+  else if( i_dtype == backend::dtype_t::fp16 ) return at::kHalf;
+
+  assert( false );
+  return at::kFloat;
+}
+
+tpp_nets::backend::dtype_t tpp_nets::bench::TensorDot::parse_dtype( std::string const & i_name ) {
+  if(      i_name == "fp32" ) return backend::dtype_t::fp32;
+  else if( i_name == "fp64" ) return backend::dtype_t::fp64;
+  else if( i_name == "bf16" ) return backend::dtype_t::bf16;
+  else if( i_name == "fp16" ) return backend::dtype_t::fp16;
+
+  assert( false );
+  return backend::dtype_t::fp32;
+}
+
+std::string tpp_nets::bench::TensorDot::dtype_name( backend::dtype_t i_dtype ) {
+  if(      i_dtype == backend::dtype_t::fp32 ) return "fp32";
+  else if( i_dtype == backend::dtype_t::fp64 ) return "fp64";
+  else if( i_dtype == backend::dtype_t::bf16 ) return "bf16";
+  else if( i_dtype == backend::dtype_t::fp16 ) return "fp16";
+
+  assert( false );
+  return "fp32";
+}
+
+int64_t tpp_nets::bench::TensorDot::n_flops( std::vector< int64_t > const & i_sizes_s,
+                                             std::vector< int64_t > const & i_sizes_u,
+                                             std::vector<  int8_t > const & i_types_s ) {
+  int64_t l_n_flops = 2;
+  for( std::size_t l_di_u = 0; l_di_u < i_sizes_u.size(); l_di_u++ ) {
+    l_n_flops *= i_sizes_u[l_di_u]; // M, N and B
+  }
+  for( std::size_t l_di_s = 0; l_di_s < i_sizes_s.size(); l_di_s++ ) {
+    if( i_types_s[l_di_s] == 1 ) {
+      l_n_flops *= i_sizes_s[l_di_s]; // K
+    }
+  }
+
+  return l_n_flops;
+}
+
+int64_t tpp_nets::bench::TensorDot::n_bytes( std::vector< int64_t > const & i_sizes_s,
+                                             std::vector< int64_t > const & i_sizes_t,
+                                             std::vector< int64_t > const & i_sizes_u,
+                                             backend::dtype_t               i_dtype_in,
+                                             backend::dtype_t               i_dtype_out ) {
+  int64_t l_size_s = c10::elementSize( to_aten( i_dtype_in ) );
+  int64_t l_size_t = l_size_s;
+  int64_t l_size_u = c10::elementSize( to_aten( i_dtype_out ) );
+
+  for( std::size_t l_di_s = 0; l_di_s < i_sizes_s.size(); l_di_s++ ) {
+    l_size_s *= i_sizes_s[l_di_s];
+  }
+  for( std::size_t l_di_t = 0; l_di_t < i_sizes_t.size(); l_di_t++ ) {
+    l_size_t *= i_sizes_t[l_di_t];
+  }
+  for( std::size_t l_di_u = 0; l_di_u < i_sizes_u.size(); l_di_u++ ) {
+    l_size_u *= i_sizes_u[l_di_u];
+  }
+
+  return l_size_s + l_size_t + l_size_u;
+}
+
+void tpp_nets::bench::TensorDot::flush_cache() {
+  // the buffer is larger than the last level cache, at least the minimum size
+  static std::vector< char > l_buffer = []() {
+    int64_t l_size = std::max( (int64_t) 4 * sysconf( _SC_LEVEL3_CACHE_SIZE ),
+                               m_flush_size_min );
+    return std::vector< char >( l_size, 0 );
+  }();
+
+  int64_t l_size = l_buffer.size();
+  char * l_data = l_buffer.data();
+#pragma omp parallel for
+  for( int64_t l_by = 0; l_by < l_size; l_by += 64 ) {
+    l_data[l_by]++;
+  }
+}
+
+std::vector< double > tpp_nets::bench::TensorDot::sample( std::function< void() > const & i_kernel,
+                                                          int64_t                         i_n_repetitions,
+                                                          int64_t                         i_n_samples,
+                                                          bool                            i_cold,
+                                                          int64_t                       & o_n_warmup ) {
+  auto l_sample = [&]() {
+    std::chrono::duration< double > l_dur( 0 );
+
+    if( i_cold ) {
+      for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+        flush_cache();
+
+        std::chrono::high_resolution_clock::time_point l_tp0 = std::chrono::high_resolution_clock::now();
+        i_kernel();
+        std::chrono::high_resolution_clock::time_point l_tp1 = std::chrono::high_resolution_clock::now();
+        l_dur += l_tp1 - l_tp0;
+      }
+    }
+    else {
+      std::chrono::high_resolution_clock::time_point l_tp0 = std::chrono::high_resolution_clock::now();
+      for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+        i_kernel();
+      }
+      std::chrono::high_resolution_clock::time_point l_tp1 = std::chrono::high_resolution_clock::now();
+      l_dur = l_tp1 - l_tp0;
+    }
+
+    return l_dur.count();
+  };
+
+  // warm-up until two consecutive samples are close
+  o_n_warmup = 1;
+  double l_dur_prev = l_sample();
+  while( o_n_warmup < m_max_warmup ) {
+    double l_dur = l_sample();
+    o_n_warmup++;
+
+    bool l_stable = std::abs( l_dur - l_dur_prev ) < m_warmup_tolerance * std::min( l_dur, l_dur_prev );
+    l_dur_prev = l_dur;
+    if( l_stable ) break;
+  }
+
+  std::vector< double > l_samples( i_n_samples );
+  for( int64_t l_sa = 0; l_sa < i_n_samples; l_sa++ ) {
+    l_samples[l_sa] = l_sample();
+  }
+
+  return l_samples;
+}
+
+std::vector< double > tpp_nets::bench::TensorDot::count( std::function< void() > const & i_kernel,
+                                                         int64_t                         i_n_repetitions,
+                                                         bool                            i_cold ) {
+  PerfCounters l_counters;
+  if( !l_counters.available() ) return std::vector< double >();
+
+  if( i_cold ) {
+    for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+      flush_cache();
+
+      l_counters.start();
+      i_kernel();
+      l_counters.stop();
+    }
+  }
+  else {
+    l_counters.start();
+    for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+      i_kernel();
+    }
+    l_counters.stop();
+  }
+
+  std::vector< double > l_values = l_counters.values();
+  for( std::size_t l_ev = 0; l_ev < l_values.size(); l_ev++ ) {
+    if( l_values[l_ev] >= 0 ) {
+      l_values[l_ev] /= i_n_repetitions;
+    }
+  }
+
+  return l_values;
+}
+
+std::string tpp_nets::bench::TensorDot::einsum_expression( std::vector< int8_t > const & i_types_s,
+                                                           std::vector< int8_t > const & i_types_t,
+                                                           std::vector< int8_t > const & i_types_u ) {
+  // letters of the M, N, K and B dimensions
+  std::string l_letters_m;
+  std::string l_letters_n;
+  std::string l_letters_k;
+  std::string l_letters_b;
+
+  char l_letter = 'a';
+  for( std::size_t l_di_s = 0; l_di_s < i_types_s.size(); l_di_s++ ) {
+    if(      i_types_s[l_di_s] == 0 ) l_letters_m += l_letter++;
+    else if( i_types_s[l_di_s] == 1 ) l_letters_k += l_letter++;
+    else if( i_types_s[l_di_s] == 2 ) l_letters_b += l_letter++;
+  }
+  for( std::size_t l_di_t = 0; l_di_t < i_types_t.size(); l_di_t++ ) {
+    if( i_types_t[l_di_t] == 0 ) l_letters_n += l_letter++;
+  }
+
+  // assemble expression, the i-th dimension of a type always maps to the type's i-th letter
+  std::string l_expr;
+  int64_t l_ids[3] = { 0 };
+
+  for( std::size_t l_di_s = 0; l_di_s < i_types_s.size(); l_di_s++ ) {
+    if(      i_types_s[l_di_s] == 0 ) l_expr += l_letters_m[ l_ids[0]++ ];
+    else if( i_types_s[l_di_s] == 1 ) l_expr += l_letters_k[ l_ids[1]++ ];
+    else if( i_types_s[l_di_s] == 2 ) l_expr += l_letters_b[ l_ids[2]++ ];
+  }
+  l_expr += ',';
+
+  l_ids[0] = l_ids[1] = l_ids[2] = 0;
+  for( std::size_t l_di_t = 0; l_di_t < i_types_t.size(); l_di_t++ ) {
+    if(      i_types_t[l_di_t] == 0 ) l_expr += l_letters_n[ l_ids[0]++ ];
+    else if( i_types_t[l_di_t] == 1 ) l_expr += l_letters_k[ l_ids[1]++ ];
+    else if( i_types_t[l_di_t] == 2 ) l_expr += l_letters_b[ l_ids[2]++ ];
+  }
+  l_expr += "->";
+
+  l_ids[0] = l_ids[1] = l_ids[2] = 0;
+  for( std::size_t l_di_u = 0; l_di_u < i_types_u.size(); l_di_u++ ) {
+    if(      i_types_u[l_di_u] == 0 ) l_expr += l_letters_m[ l_ids[0]++ ];
+    else if( i_types_u[l_di_u] == 1 ) l_expr += l_letters_n[ l_ids[1]++ ];
+    else if( i_types_u[l_di_u] == 2 ) l_expr += l_letters_b[ l_ids[2]++ ];
+  }
+
+  return l_expr;
+}
 
 bool tpp_nets::bench::TensorDot::check( std::vector< int64_t > i_sizes_s,
                                         std::vector< int64_t > i_sizes_t,
                                         std::vector< int64_t > i_sizes_u,
                                         std::vector<  int8_t > i_types_s,
                                         std::vector<  int8_t > i_types_t,
-                                        std::vector<  int8_t > i_types_u ) {
+                                        std::vector<  int8_t > i_types_u,
+                                        backend::dtype_t       i_dtype_in,
+                                        backend::dtype_t       i_dtype_out ) {
   // compute solution through tppdot
   int64_t l_n_dims_s = i_sizes_s.size();
   int64_t l_n_dims_t = i_sizes_t.size();
   int64_t l_n_dims_u = i_sizes_u.size();
 
-  at::Tensor l_s = at::rand(  i_sizes_s );
-  at::Tensor l_t = at::rand(  i_sizes_t );
-  at::Tensor l_u = at::zeros( i_sizes_u );
+  at::Tensor l_s = at::rand(  i_sizes_s, at::TensorOptions().dtype( to_aten( i_dtype_in ) ) );
+  at::Tensor l_t = at::rand(  i_sizes_t, at::TensorOptions().dtype( to_aten( i_dtype_in ) ) );
+  at::Tensor l_u = at::empty( i_sizes_u, at::TensorOptions().dtype( to_aten( i_dtype_out ) ) );
 
   std::vector< int64_t > l_strides_s = l_s.strides().vec();
   std::vector< int64_t > l_strides_t = l_t.strides().vec();
   std::vector< int64_t > l_strides_u = l_u.strides().vec();
 
+  // U is overwritten, no zero-initialization required
+  tpp_nets::backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+
   tpp_nets::backend::BinaryContraction l_bin_con;
   l_bin_con.tppdot( l_n_dims_s,
                      l_n_dims_t,
@@ -37,57 +269,49 @@ bool tpp_nets::bench::TensorDot::check( std::vector< int64_t > i_sizes_s,
                      l_strides_u.data(),
                      l_s.data_ptr(),
                      l_t.data_ptr(),
-                     l_u.data_ptr() );
+                     l_u.data_ptr(),
+                     i_dtype_in,
+                     i_dtype_out,
+                     l_epilogue );
 
-  // compute solution through ATen's tensordot
-  std::vector< int64_t > l_dims_reduction_s;
-  std::vector< int64_t > l_dims_reduction_t;
+  // compute solution through ATen's einsum, which also supports batch dimensions
+  std::string l_expr = einsum_expression( i_types_s,
+                                          i_types_t,
+                                          i_types_u );
 
-  for( std::size_t l_di_s = 0; l_di_s < i_types_s.size(); l_di_s++ ) {
-    if( i_types_s[l_di_s] == 1 ) {
-      l_dims_reduction_s.push_back( l_di_s );
-    }
-  }
+  // low precision inputs are accumulated in FP32
+  bool l_low_precision =    i_dtype_in == backend::dtype_t::bf16
+                         || i_dtype_in == backend::dtype_t::fp16;
+  if( l_low_precision ) {
+    at::Tensor l_ref = at::einsum( l_expr,
+                                   {l_s.to( at::kFloat ), l_t.to( at::kFloat )} );
 
-  for( std::size_t l_di_t = 0; l_di_t < i_types_s.size(); l_di_t++ ) {
-    if( i_types_t[l_di_t] == 1 ) {
-      l_dims_reduction_t.push_back( l_di_t );
-    }
+    return at::allclose( l_u.to( at::kFloat ),
+                         l_ref,
+                         1E-2,
+                         1E-2 );
   }
 
-  at::Tensor l_ref = at::tensordot( l_s,
-                                    l_t,
-                                    l_dims_reduction_s,
-                                    l_dims_reduction_t );
-
-  // derive required permutation
-  std::vector< int64_t > l_perm;
-  for( std::size_t l_di_u = 0; l_di_u < i_types_u.size(); l_di_u++ ) {
-    if( i_types_u[l_di_u] == 0 ) {
-      l_perm.push_back( l_di_u );
-    }
-  }
-  for( std::size_t l_di_u = 0; l_di_u < i_types_u.size(); l_di_u++ ) {
-    if( i_types_u[l_di_u] == 1 ) {
-      l_perm.push_back( l_di_u );
-    }
-  }
-
-  l_u = l_u.permute( l_perm );
+  at::Tensor l_ref = at::einsum( l_expr,
+                                 {l_s, l_t} );
 
   return at::allclose( l_u, l_ref );
 }
 
-double tpp_nets::bench::TensorDot::time_aten( std::vector< int64_t > i_sizes_s,
-                                              std::vector< int64_t > i_sizes_t,
-                                              std::vector<  int8_t > i_types_s,
-                                              std::vector<  int8_t > i_types_t,
-                                              int64_t                i_n_repetitions ) {
-  std::chrono::high_resolution_clock::time_point l_tp0, l_tp1;
-  std::chrono::duration< double > l_dur;
-
-  at::Tensor l_s = at::rand(  i_sizes_s );
-  at::Tensor l_t = at::rand(  i_sizes_t );
+std::tuple< std::vector< double >,
+            int64_t,
+            std::vector< double > > tpp_nets::bench::TensorDot::time_aten( std::vector< int64_t > i_sizes_s,
+                                                             std::vector< int64_t > i_sizes_t,
+                                                             std::vector<  int8_t > i_types_s,
+                                                             std::vector<  int8_t > i_types_t,
+                                                             std::vector<  int8_t > i_types_u,
+                                                             backend::dtype_t       i_dtype,
+                                                             int64_t                i_n_repetitions,
+                                                             int64_t                i_n_samples,
+                                                             bool                   i_cold,
+                                                             bool                   i_counters ) {
+  at::Tensor l_s = at::rand( i_sizes_s, at::TensorOptions().dtype( to_aten( i_dtype ) ) );
+  at::Tensor l_t = at::rand( i_sizes_t, at::TensorOptions().dtype( to_aten( i_dtype ) ) );
 
   std::vector< int64_t > l_dims_reduction_s;
   std::vector< int64_t > l_dims_reduction_t;
@@ -98,58 +322,113 @@ double tpp_nets::bench::TensorDot::time_aten( std::vector< int64_t > i_sizes_s,
     }
   }
 
-  for( std::size_t l_di_t = 0; l_di_t < i_types_s.size(); l_di_t++ ) {
+  for( std::size_t l_di_t = 0; l_di_t < i_types_t.size(); l_di_t++ ) {
     if( i_types_t[l_di_t] == 1 ) {
       l_dims_reduction_t.push_back( l_di_t );
     }
   }
 
-  // warmup
-  at::tensordot( l_s,
-                 l_t,
-                 l_dims_reduction_s,
-                 l_dims_reduction_t );
+  // tensordot doesn't support batch dimensions, einsum is used instead
+  bool l_batch = std::count( i_types_s.begin(), i_types_s.end(), 2 ) > 0;
+  std::string l_expr = einsum_expression( i_types_s,
+                                          i_types_t,
+                                          i_types_u );
 
-  // benchmark
-  l_tp0 = std::chrono::high_resolution_clock::now();
-  for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
-    at::tensordot( l_s,
-                   l_t,
-                   l_dims_reduction_s,
-                   l_dims_reduction_t );
-  }
-  l_tp1 = std::chrono::high_resolution_clock::now();
+  auto l_kernel = [&]() {
+    if( l_batch ) {
+      at::einsum( l_expr,
+                  {l_s, l_t} );
+    }
+    else {
+      at::tensordot( l_s,
+                     l_t,
+                     l_dims_reduction_s,
+                     l_dims_reduction_t );
+    }
+  };
+
+  // benchmark, the warm-up is part of the sampling
+  int64_t l_n_warmup = 0;
+  std::vector< double > l_samples = sample( l_kernel,
+                                            i_n_repetitions,
+                                            i_n_samples,
+                                            i_cold,
+                                            l_n_warmup );
 
-  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  // hardware counters in a separate pass, i.e., the timings are not affected
+  std::vector< double > l_counters;
+  if( i_counters ) {
+    l_counters = count( l_kernel,
+                        i_n_repetitions,
+                        i_cold );
+  }
 
-  return l_dur.count();
+  return std::make_tuple( l_samples,
+                          l_n_warmup,
+                          l_counters );
 }
 
-double tpp_nets::bench::TensorDot::time_tppdot( std::vector< int64_t > i_sizes_s,
-                                                std::vector< int64_t > i_sizes_t,
-                                                std::vector< int64_t > i_sizes_u,
-                                                std::vector<  int8_t > i_types_s,
-                                                std::vector<  int8_t > i_types_t,
-                                                std::vector<  int8_t > i_types_u,
-                                                int64_t                i_n_repetitions ) {
+std::tuple< double,
+            std::vector< double >,
+            int64_t,
+            std::vector< double >,
+            std::vector< double > > tpp_nets::bench::TensorDot::time_tppdot( std::vector< int64_t > i_sizes_s,
+                                                                             std::vector< int64_t > i_sizes_t,
+                                                                             std::vector< int64_t > i_sizes_u,
+                                                                             std::vector<  int8_t > i_types_s,
+                                                                             std::vector<  int8_t > i_types_t,
+                                                                             std::vector<  int8_t > i_types_u,
+                                                                             backend::dtype_t       i_dtype_in,
+                                                                             backend::dtype_t       i_dtype_out,
+                                                                             int64_t                i_n_repetitions,
+                                                                             int64_t                i_n_samples,
+                                                                             bool                   i_cold,
+                                                                             bool                   i_counters ) {
   std::chrono::high_resolution_clock::time_point l_tp0, l_tp1;
-  std::chrono::duration< double > l_dur;
+  std::chrono::duration< double > l_dur_plan;
 
   int64_t l_n_dims_s = i_sizes_s.size();
   int64_t l_n_dims_t = i_sizes_t.size();
   int64_t l_n_dims_u = i_sizes_u.size();
 
-  at::Tensor l_s = at::rand(  i_sizes_s );
-  at::Tensor l_t = at::rand(  i_sizes_t );
-  at::Tensor l_u = at::zeros( i_sizes_u );
+  at::Tensor l_s = at::rand(  i_sizes_s, at::TensorOptions().dtype( to_aten( i_dtype_in ) ) );
+  at::Tensor l_t = at::rand(  i_sizes_t, at::TensorOptions().dtype( to_aten( i_dtype_in ) ) );
+  at::Tensor l_u = at::empty( i_sizes_u, at::TensorOptions().dtype( to_aten( i_dtype_out ) ) );
 
   std::vector< int64_t > l_strides_s = l_s.strides().vec();
   std::vector< int64_t > l_strides_t = l_t.strides().vec();
   std::vector< int64_t > l_strides_u = l_u.strides().vec();
 
-  // warmup
-  tpp_nets::backend::BinaryContraction l_bin_con;
-  l_bin_con.tppdot( l_n_dims_s,
+  // U is overwritten, no zero-initialization required
+  tpp_nets::backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( l_n_dims_s,
+               l_n_dims_t,
+               l_n_dims_u,
+               i_sizes_s.data(),
+               i_sizes_t.data(),
+               i_types_s.data(),
+               i_types_t.data(),
+               i_types_u.data(),
+               l_strides_s.data(),
+               l_strides_t.data(),
+               l_strides_u.data(),
+               i_dtype_in,
+               i_dtype_out,
+               l_epilogue );
+
+  // U is placed in the memory of the threads writing it
+  l_plan.first_touch( l_u.data_ptr() );
+
+  // benchmark plan construction: a few constructions within a time budget, independent of the execution's repetitions
+  int64_t l_n_plans = 0;
+  l_dur_plan = std::chrono::duration< double >( 0 );
+  while( l_n_plans < m_max_plans && l_dur_plan.count() < m_time_plans ) {
+    l_tp0 = std::chrono::high_resolution_clock::now();
+    tpp_nets::backend::ContractionPlan l_plan_re;
+    l_plan_re.init( l_n_dims_s,
                     l_n_dims_t,
                     l_n_dims_u,
                     i_sizes_s.data(),
@@ -160,120 +439,224 @@ double tpp_nets::bench::TensorDot::time_tppdot( std::vector< int64_t > i_sizes_s
                     l_strides_s.data(),
                     l_strides_t.data(),
                     l_strides_u.data(),
-                    l_s.data_ptr(),
-                    l_t.data_ptr(),
-                    l_u.data_ptr() );
+                    i_dtype_in,
+                    i_dtype_out,
+                    l_epilogue );
+    l_tp1 = std::chrono::high_resolution_clock::now();
 
-  // benchmark
-  l_tp0 = std::chrono::high_resolution_clock::now();
-  for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
-    l_bin_con.tppdot( l_n_dims_s,
-                      l_n_dims_t,
-                      l_n_dims_u,
-                      i_sizes_s.data(),
-                      i_sizes_t.data(),
-                      i_types_s.data(),
-                      i_types_t.data(),
-                      i_types_u.data(),
-                      l_strides_s.data(),
-                      l_strides_t.data(),
-                      l_strides_u.data(),
-                      l_s.data_ptr(),
-                      l_t.data_ptr(),
-                      l_u.data_ptr() );
+    l_dur_plan += l_tp1 - l_tp0;
+    l_n_plans++;
   }
-  l_tp1 = std::chrono::high_resolution_clock::now();
 
-  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  // benchmark execution, the threads' busy times show the load balance
+  std::vector< double > l_busy( l_plan.n_threads(), 0 );
 
-  return l_dur.count();
+  int64_t l_n_warmup = 0;
+  std::vector< double > l_samples = sample( [&]() {
+                                              l_plan.execute( l_s.data_ptr(),
+                                                              l_t.data_ptr(),
+                                                              l_u.data_ptr(),
+                                                              nullptr,
+                                                              l_busy.data() );
+                                            },
+                                            i_n_repetitions,
+                                            i_n_samples,
+                                            i_cold,
+                                            l_n_warmup );
+
+  // hardware counters in a separate pass, i.e., the timings and busy times are not affected
+  std::vector< double > l_counters;
+  if( i_counters ) {
+    l_counters = count( [&]() {
+                          l_plan.execute( l_s.data_ptr(),
+                                          l_t.data_ptr(),
+                                          l_u.data_ptr() );
+                        },
+                        i_n_repetitions,
+                        i_cold );
+  }
+
+  return std::make_tuple( l_dur_plan.count() / l_n_plans,
+                          l_samples,
+                          l_n_warmup,
+                          l_busy,
+                          l_counters );
 }
 
 
-std::tuple< uint64_t,
-            double,
-            double > tpp_nets::bench::TensorDot::perf( int8_t                 i_kernel_type,
-                                                       std::vector< int64_t > i_sizes_s,
-                                                       std::vector< int64_t > i_sizes_t,
-                                                       std::vector< int64_t > i_sizes_u,
-                                                       std::vector<  int8_t > i_types_s,
-                                                       std::vector<  int8_t > i_types_t,
-                                                       std::vector<  int8_t > i_types_u,
-                                                       double                 i_time_target,
-                                                       uint64_t               i_n_repetitions_initial ) {
-  // get number of threads and print
-  int l_n_threads = 1;
-
-  // get number of flops per iter
-  int64_t l_n_flops = 2;
-  for( std::size_t l_di_s = 0; l_di_s < i_sizes_s.size(); l_di_s++ ) {
-    l_n_flops *= i_sizes_s[l_di_s]; // M and K
+tpp_nets::bench::TensorDot::Stats tpp_nets::bench::TensorDot::stats( std::vector< double > i_samples ) {
+  Stats l_stats;
+  int64_t l_n_samples = i_samples.size();
+  if( l_n_samples == 0 ) return l_stats;
+
+  std::sort( i_samples.begin(), i_samples.end() );
+
+  auto l_percentile = [&]( double i_pe ) {
+    double l_rank = i_pe * ( l_n_samples - 1 );
+    int64_t l_lower = l_rank;
+    int64_t l_upper = std::min( l_lower + 1, l_n_samples - 1 );
+    return i_samples[l_lower] + ( l_rank - l_lower ) * ( i_samples[l_upper] - i_samples[l_lower] );
+  };
+
+  l_stats.min    = i_samples[0];
+  l_stats.median = l_percentile( 0.5 );
+  l_stats.p90    = l_percentile( 0.9 );
+  l_stats.p99    = l_percentile( 0.99 );
+
+  for( int64_t l_sa = 0; l_sa < l_n_samples; l_sa++ ) {
+    l_stats.mean += i_samples[l_sa] / l_n_samples;
   }
-  for( std::size_t l_di_t = 0; l_di_t < i_sizes_t.size(); l_di_t++ ) {
-    if( i_types_t[l_di_t] == 0 ) {
-      l_n_flops *= i_sizes_t[l_di_t]; // N
-    }
+  for( int64_t l_sa = 0; l_sa < l_n_samples; l_sa++ ) {
+    l_stats.stddev += ( i_samples[l_sa] - l_stats.mean ) * ( i_samples[l_sa] - l_stats.mean );
   }
-
-  double l_dur = 0;
-  if( i_kernel_type == 0 ) {
-    // get time required for initial number of reps
-    l_dur = time_tppdot( i_sizes_s,
-                         i_sizes_t,
-                         i_sizes_u,
-                         i_types_s,
-                         i_types_t,
-                         i_types_u,
-                         i_n_repetitions_initial );
-  }
-  else if( i_kernel_type == 1 ) {
-    l_dur = time_aten( i_sizes_s,
-                       i_sizes_t,
-                       i_types_s,
-                       i_types_t,
-                       i_n_repetitions_initial );
+  if( l_n_samples > 1 ) {
+    l_stats.stddev = std::sqrt( l_stats.stddev / ( l_n_samples - 1 ) );
   }
   else {
-    assert( false );
+    l_stats.stddev = 0;
   }
 
-  // derive number of reps for targeted duration
-  double l_scaling_time = i_time_target / l_dur;
-  uint64_t l_n_repetitions_adj = i_n_repetitions_initial * l_scaling_time;
+  return l_stats;
+}
+
+tpp_nets::bench::TensorDot::Result tpp_nets::bench::TensorDot::perf( int8_t                 i_kernel_type,
+                                                                     std::vector< int64_t > i_sizes_s,
+                                                                     std::vector< int64_t > i_sizes_t,
+                                                                     std::vector< int64_t > i_sizes_u,
+                                                                     std::vector<  int8_t > i_types_s,
+                                                                     std::vector<  int8_t > i_types_t,
+                                                                     std::vector<  int8_t > i_types_u,
+                                                                     backend::dtype_t       i_dtype_in,
+                                                                     backend::dtype_t       i_dtype_out,
+                                                                     double                 i_time_target,
+                                                                     int64_t                i_n_samples,
+                                                                     bool                   i_cold,
+                                                                     uint64_t               i_n_repetitions_initial,
+                                                                     double                 i_peak_gflops,
+                                                                     double                 i_peak_bandwidth,
+                                                                     bool                   i_counters ) {
+  assert( i_n_samples > 0 );
+
+  // get number of flops and compulsory bytes per iter
+  int64_t l_n_flops = n_flops( i_sizes_s,
+                               i_sizes_u,
+                               i_types_s );
+  int64_t l_n_bytes = n_bytes( i_sizes_s,
+                               i_sizes_t,
+                               i_sizes_u,
+                               i_dtype_in,
+                               i_dtype_out );
+
+  // runs the kernel, returns the durations of the samples
+  Result l_result;
+  double l_dur_plan = 0;
+  auto l_run = [&]( int64_t i_n_repetitions,
+                    int64_t i_n_samples_run,
+                    bool    i_counters_run ) {
+    std::vector< double > l_samples;
+
+    if( i_kernel_type == 0 ) {
+      std::tie( l_dur_plan,
+                l_samples,
+                l_result.n_warmup,
+                l_result.busy,
+                l_result.counters ) = time_tppdot( i_sizes_s,
+                                                   i_sizes_t,
+                                                   i_sizes_u,
+                                                   i_types_s,
+                                                   i_types_t,
+                                                   i_types_u,
+                                                   i_dtype_in,
+                                                   i_dtype_out,
+                                                   i_n_repetitions,
+                                                   i_n_samples_run,
+                                                   i_cold,
+                                                   i_counters_run );
+    }
+    else if( i_kernel_type == 1 ) {
+      std::tie( l_samples,
+                l_result.n_warmup,
+                l_result.counters ) = time_aten( i_sizes_s,
+                                                 i_sizes_t,
+                                                 i_types_s,
+                                                 i_types_t,
+                                                 i_types_u,
+                                                 i_dtype_in,
+                                                 i_n_repetitions,
+                                                 i_n_samples_run,
+                                                 i_cold,
+                                                 i_counters_run );
+    }
+    else {
+      assert( false );
+    }
+
+    return l_samples;
+  };
+
+  // cold caches: the flush preceding every repetition isn't part of the samples, but of the wall time
+  if( i_cold ) {
+    flush_cache();
+
+    std::chrono::high_resolution_clock::time_point l_tp0 = std::chrono::high_resolution_clock::now();
+    for( int64_t l_fl = 0; l_fl < m_n_flushes_calibration; l_fl++ ) {
+      flush_cache();
+    }
+    std::chrono::high_resolution_clock::time_point l_tp1 = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration< double > l_dur_flush = l_tp1 - l_tp0;
+    l_result.flush = l_dur_flush.count() / m_n_flushes_calibration;
+  }
+
+  // calibration: derive number of reps per sample for targeted duration, including the flushes
+  std::vector< double > l_samples = l_run( i_n_repetitions_initial,
+                                           1,
+                                           false );
+  double l_dur_rep = l_samples[0] / i_n_repetitions_initial + l_result.flush;
+  uint64_t l_n_repetitions_adj = i_time_target / ( i_n_samples * l_dur_rep );
   if( l_n_repetitions_adj == 0 ) {
     l_n_repetitions_adj = 1;
   }
 
   // benchmark kernel
-  if( i_kernel_type == 0 ) {
-    l_dur = time_tppdot( i_sizes_s,
-                         i_sizes_t,
-                         i_sizes_u,
-                         i_types_s,
-                         i_types_t,
-                         i_types_u,
-                         l_n_repetitions_adj );
-  }
-  else if( i_kernel_type == 1 ) {
-    l_dur = time_aten( i_sizes_s,
-                       i_sizes_t,
-                       i_types_s,
-                       i_types_t,
-                       l_n_repetitions_adj );
-  }
-  else {
-    assert( false );
+  l_samples = l_run( l_n_repetitions_adj,
+                     i_n_samples,
+                     i_counters );
+
+  // durations of single repetitions
+  for( int64_t l_sa = 0; l_sa < i_n_samples; l_sa++ ) {
+    l_result.time += l_samples[l_sa];
+    l_samples[l_sa] /= l_n_repetitions_adj;
   }
 
+  l_result.n_repetitions = l_n_repetitions_adj;
+  l_result.n_samples = i_n_samples;
+  l_result.stats = stats( l_samples );
+
   // derive gflops
-  double l_gflops = l_n_repetitions_adj;
-  l_gflops *= l_n_flops / l_dur;
-  l_gflops *= l_n_threads;
-  l_gflops *= 1.0E-9;
-
-  return std::make_tuple( l_n_repetitions_adj,
-                          l_dur,
-                          l_gflops );
+  l_result.gflops = l_n_flops / l_result.stats.median;
+  l_result.gflops *= 1.0E-9;
+
+  // derive arithmetic intensity and bandwidth
+  l_result.n_flops = l_n_flops;
+  l_result.n_bytes = l_n_bytes;
+  l_result.intensity = (double) l_n_flops / l_n_bytes;
+  l_result.bandwidth = l_n_bytes / l_result.stats.median;
+  l_result.bandwidth *= 1.0E-9;
+
+  // rate w.r.t. the roofline
+  l_result.peak_gflops = i_peak_gflops;
+  l_result.peak_bandwidth = i_peak_bandwidth;
+  if( i_peak_gflops > 0 && i_peak_bandwidth > 0 ) {
+    l_result.roofline = std::min( i_peak_gflops,
+                                  l_result.intensity * i_peak_bandwidth );
+    l_result.pct_roofline = 100.0 * l_result.gflops / l_result.roofline;
+  }
+
+  // average setup time per call
+  l_result.setup = l_dur_plan;
+
+  return l_result;
 }
 
 void tpp_nets::bench::TensorDot:: parse_config( std::string                             i_path,
@@ -282,7 +665,9 @@ void tpp_nets::bench::TensorDot:: parse_config( std::string
                                                 std::vector< std::vector< int64_t > > & o_sizes_u,
                                                 std::vector< std::vector<  int8_t > > & o_types_s,
                                                 std::vector< std::vector<  int8_t > > & o_types_t,
-                                                std::vector< std::vector<  int8_t > > & o_types_u ) {
+                                                std::vector< std::vector<  int8_t > > & o_types_u,
+                                                std::vector< backend::dtype_t >       & o_dtypes_in,
+                                                std::vector< backend::dtype_t >       & o_dtypes_out ) {
   // reset configs
   o_sizes_s.resize(0);
   o_sizes_t.resize(0);
@@ -292,9 +677,15 @@ void tpp_nets::bench::TensorDot:: parse_config( std::string
   o_types_t.resize(0);
   o_types_u.resize(0);
 
-  // parse json file
+  o_dtypes_in.resize(0);
+  o_dtypes_out.resize(0);
+
+  // parse json file, sweep configs hold the settings in an object
   std::ifstream l_file( i_path );
   nlohmann::json l_data = nlohmann::json::parse( l_file );
+  if( l_data.is_object() ) {
+    l_data = l_data["settings"];
+  }
 
   // store configs
   for( std::size_t l_co = 0; l_co < l_data.size(); l_co++ ) {
@@ -305,5 +696,590 @@ void tpp_nets::bench::TensorDot:: parse_config( std::string
     o_types_s.push_back(l_data[l_co]["types_s"] );
     o_types_t.push_back(l_data[l_co]["types_t"] );
     o_types_u.push_back(l_data[l_co]["types_u"] );
+
+    // datatypes are optional
+    backend::dtype_t l_dtype_in = backend::dtype_t::fp32;
+    if( l_data[l_co].contains( "dtype_in" ) ) {
+      l_dtype_in = parse_dtype( l_data[l_co]["dtype_in"] );
+    }
+    backend::dtype_t l_dtype_out = ( l_dtype_in == backend::dtype_t::fp64 ) ? backend::dtype_t::fp64 : backend::dtype_t::fp32;
+    if( l_data[l_co].contains( "dtype_out" ) ) {
+      l_dtype_out = parse_dtype( l_data[l_co]["dtype_out"] );
+    }
+    o_dtypes_in.push_back( l_dtype_in );
+    o_dtypes_out.push_back( l_dtype_out );
+
+    assert( o_sizes_s.back().size() == o_types_s.back().size() );
+    assert( o_sizes_t.back().size() == o_types_t.back().size() );
+    assert( o_sizes_u.back().size() == o_types_u.back().size() );
+
+    // count the dimensions' types (0: M/N, 1: K/N, 2: B)
+    int64_t l_n_types_s[3] = { 0 };
+    int64_t l_n_types_t[3] = { 0 };
+    int64_t l_n_types_u[3] = { 0 };
+
+    for( std::size_t l_di = 0; l_di < o_types_s.back().size(); l_di++ ) {
+      assert( o_types_s.back()[l_di] >= 0 && o_types_s.back()[l_di] <= 2 );
+      l_n_types_s[ o_types_s.back()[l_di] ]++;
+    }
+    for( std::size_t l_di = 0; l_di < o_types_t.back().size(); l_di++ ) {
+      assert( o_types_t.back()[l_di] >= 0 && o_types_t.back()[l_di] <= 2 );
+      l_n_types_t[ o_types_t.back()[l_di] ]++;
+    }
+    for( std::size_t l_di = 0; l_di < o_types_u.back().size(); l_di++ ) {
+      assert( o_types_u.back()[l_di] >= 0 && o_types_u.back()[l_di] <= 2 );
+      l_n_types_u[ o_types_u.back()[l_di] ]++;
+    }
+
+    // M: S and U, N: T and U, K: S and T, B: S, T and U
+    assert( l_n_types_s[0] == l_n_types_u[0] );
+    assert( l_n_types_t[0] == l_n_types_u[1] );
+    assert( l_n_types_s[1] == l_n_types_t[1] );
+    assert( l_n_types_s[2] == l_n_types_t[2] );
+    assert( l_n_types_s[2] == l_n_types_u[2] );
+  }
+}
+
+void tpp_nets::bench::TensorDot::set_num_threads( int64_t i_n_threads ) {
+  omp_set_num_threads( i_n_threads );
+  at::set_num_threads( i_n_threads );
+}
+
+std::vector< int64_t * > tpp_nets::bench::TensorDot::dim_sizes( std::string            const & i_dim,
+                                                                std::vector< int64_t >       & io_sizes_s,
+                                                                std::vector< int64_t >       & io_sizes_t,
+                                                                std::vector< int64_t >       & io_sizes_u,
+                                                                std::vector<  int8_t > const & i_types_s,
+                                                                std::vector<  int8_t > const & i_types_t,
+                                                                std::vector<  int8_t > const & i_types_u ) {
+  assert( i_dim.size() >= 2 );
+  char l_name = i_dim[0];
+  int64_t l_id = std::stoll( i_dim.substr( 1 ) );
+
+  // type of the dimension in S, T and U, -1 if not present
+  int8_t l_type_s = -1;
+  int8_t l_type_t = -1;
+  int8_t l_type_u = -1;
+  if(      l_name == 'm' ) { l_type_s = 0;                l_type_u = 0; }
+  else if( l_name == 'n' ) {                l_type_t = 0; l_type_u = 1; }
+  else if( l_name == 'k' ) { l_type_s = 1;  l_type_t = 1;               }
+  else if( l_name == 'b' ) { l_type_s = 2;  l_type_t = 2; l_type_u = 2; }
+  else assert( false );
+
+  // the i-th dimension of a type is the same in all tensors
+  std::vector< int64_t * > l_sizes;
+  auto l_find = [&]( std::vector< int64_t >       & io_sizes,
+                     std::vector<  int8_t > const & i_types,
+                     int8_t                         i_type ) {
+    int64_t l_count = 0;
+    for( std::size_t l_di = 0; l_di < i_types.size(); l_di++ ) {
+      if( i_types[l_di] == i_type ) {
+        if( l_count == l_id ) {
+          l_sizes.push_back( &io_sizes[l_di] );
+        }
+        l_count++;
+      }
+    }
+  };
+
+  l_find( io_sizes_s, i_types_s, l_type_s );
+  l_find( io_sizes_t, i_types_t, l_type_t );
+  l_find( io_sizes_u, i_types_u, l_type_u );
+
+  assert( l_sizes.size() > 0 );
+  return l_sizes;
+}
+
+void tpp_nets::bench::TensorDot::parse_sweep( std::string                             i_path,
+                                              std::vector< int64_t >                & o_threads,
+                                              std::vector< std::vector< int64_t > > & o_sizes_s,
+                                              std::vector< std::vector< int64_t > > & o_sizes_t,
+                                              std::vector< std::vector< int64_t > > & o_sizes_u,
+                                              std::vector< std::vector<  int8_t > > & o_types_s,
+                                              std::vector< std::vector<  int8_t > > & o_types_t,
+                                              std::vector< std::vector<  int8_t > > & o_types_u,
+                                              std::vector< backend::dtype_t >       & o_dtypes_in,
+                                              std::vector< backend::dtype_t >       & o_dtypes_out,
+                                              std::vector< std::string >            & o_weak ) {
+  // base settings
+  std::vector< std::vector< int64_t > > l_sizes_s;
+  std::vector< std::vector< int64_t > > l_sizes_t;
+  std::vector< std::vector< int64_t > > l_sizes_u;
+  std::vector< std::vector<  int8_t > > l_types_s;
+  std::vector< std::vector<  int8_t > > l_types_t;
+  std::vector< std::vector<  int8_t > > l_types_u;
+  std::vector< backend::dtype_t > l_dtypes_in;
+  std::vector< backend::dtype_t > l_dtypes_out;
+
+  parse_config( i_path,
+                l_sizes_s,
+                l_sizes_t,
+                l_sizes_u,
+                l_types_s,
+                l_types_t,
+                l_types_u,
+                l_dtypes_in,
+                l_dtypes_out );
+
+  // reset configs
+  o_threads.resize(0);
+  o_sizes_s.resize(0);
+  o_sizes_t.resize(0);
+  o_sizes_u.resize(0);
+  o_types_s.resize(0);
+  o_types_t.resize(0);
+  o_types_u.resize(0);
+  o_dtypes_in.resize(0);
+  o_dtypes_out.resize(0);
+  o_weak.resize(0);
+
+  // parse json file
+  std::ifstream l_file( i_path );
+  nlohmann::json l_data = nlohmann::json::parse( l_file );
+
+  if( l_data.is_object() && l_data.contains( "threads" ) ) {
+    o_threads = l_data["threads"].get< std::vector< int64_t > >();
   }
-}
\ No newline at end of file
+  else {
+    o_threads.push_back( omp_get_max_threads() );
+  }
+  assert( o_threads.size() > 0 );
+
+  nlohmann::json l_settings = l_data.is_object() ? l_data["settings"] : l_data;
+
+  for( std::size_t l_co = 0; l_co < l_settings.size(); l_co++ ) {
+    std::string l_weak;
+    if( l_settings[l_co].contains( "weak" ) ) {
+      l_weak = l_settings[l_co]["weak"];
+    }
+
+    // sizes of the swept dimensions
+    std::vector< std::string > l_dims;
+    std::vector< std::vector< int64_t > > l_values;
+    if( l_settings[l_co].contains( "sweep" ) ) {
+      for( auto const & l_sweep: l_settings[l_co]["sweep"] ) {
+        int64_t l_start = l_sweep["start"];
+        int64_t l_stop = l_sweep["stop"];
+        int64_t l_step = l_sweep.value( "step", 0 );
+        int64_t l_factor = l_sweep.value( "factor", 1 );
+        assert( l_step > 0 || l_factor > 1 );
+
+        l_dims.push_back( l_sweep["dim"] );
+        l_values.push_back( std::vector< int64_t >() );
+        for( int64_t l_va = l_start; l_va <= l_stop; l_va = ( l_step > 0 ) ? l_va + l_step : l_va * l_factor ) {
+          l_values.back().push_back( l_va );
+        }
+        assert( l_values.back().size() > 0 );
+      }
+    }
+
+    // cartesian product of the sweeps
+    std::vector< int64_t > l_counters( l_dims.size(), 0 );
+    bool l_done = false;
+    while( !l_done ) {
+      std::vector< int64_t > l_sizes_s_sw = l_sizes_s[l_co];
+      std::vector< int64_t > l_sizes_t_sw = l_sizes_t[l_co];
+      std::vector< int64_t > l_sizes_u_sw = l_sizes_u[l_co];
+
+      for( std::size_t l_sw = 0; l_sw < l_dims.size(); l_sw++ ) {
+        std::vector< int64_t * > l_entries = dim_sizes( l_dims[l_sw],
+                                                        l_sizes_s_sw,
+                                                        l_sizes_t_sw,
+                                                        l_sizes_u_sw,
+                                                        l_types_s[l_co],
+                                                        l_types_t[l_co],
+                                                        l_types_u[l_co] );
+        for( std::size_t l_en = 0; l_en < l_entries.size(); l_en++ ) {
+          *l_entries[l_en] = l_values[l_sw][ l_counters[l_sw] ];
+        }
+      }
+
+      o_sizes_s.push_back( l_sizes_s_sw );
+      o_sizes_t.push_back( l_sizes_t_sw );
+      o_sizes_u.push_back( l_sizes_u_sw );
+      o_types_s.push_back( l_types_s[l_co] );
+      o_types_t.push_back( l_types_t[l_co] );
+      o_types_u.push_back( l_types_u[l_co] );
+      o_dtypes_in.push_back( l_dtypes_in[l_co] );
+      o_dtypes_out.push_back( l_dtypes_out[l_co] );
+      o_weak.push_back( l_weak );
+
+      // advance the counters, the last sweep is the fastest
+      l_done = true;
+      for( int64_t l_sw = (int64_t) l_dims.size() - 1; l_sw >= 0; l_sw-- ) {
+        if( l_counters[l_sw] + 1 < (int64_t) l_values[l_sw].size() ) {
+          l_counters[l_sw]++;
+          l_done = false;
+          break;
+        }
+        l_counters[l_sw] = 0;
+      }
+    }
+  }
+}
+
+std::tuple< double,
+            double,
+            double,
+            double > tpp_nets::bench::TensorDot::time_dispatch( int64_t i_n_repetitions ) {
+  std::chrono::high_resolution_clock::time_point l_tp0, l_tp1;
+  std::chrono::duration< double > l_dur_omp;
+  std::chrono::duration< double > l_dur_pool;
+  // OpenMP and thread pool
+  std::chrono::duration< double > l_dur_tppdot[2];
+
+  // the compiler must not drop the regions
+  std::atomic< int64_t > l_sink = 0;
+
+  // OpenMP, warmup starts the threads
+#pragma omp parallel
+  {
+    l_sink += omp_get_thread_num();
+  }
+
+  l_tp0 = std::chrono::high_resolution_clock::now();
+  for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+#pragma omp parallel
+    {
+      l_sink.fetch_add( 0, std::memory_order_relaxed );
+    }
+  }
+  l_tp1 = std::chrono::high_resolution_clock::now();
+  l_dur_omp = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+
+  // thread pool
+  backend::ThreadPool & l_pool = backend::ThreadPool::instance();
+  l_pool.run( [&]( int64_t i_tid ) {
+    l_sink += i_tid;
+  } );
+
+  l_tp0 = std::chrono::high_resolution_clock::now();
+  for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+    l_pool.run( [&]( int64_t ) {
+      l_sink.fetch_add( 0, std::memory_order_relaxed );
+    } );
+  }
+  l_tp1 = std::chrono::high_resolution_clock::now();
+  l_dur_pool = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+
+  // tppdot of a 1x1x1 contraction: plan lookup and execution dominate the negligible compute
+  std::vector< int64_t > l_sizes = { 1, 1 };
+  std::vector< int64_t > l_strides = { 1, 1 };
+  std::vector< int8_t > l_types_s = { 0, 1 };
+  std::vector< int8_t > l_types_t = { 1, 0 };
+  std::vector< int8_t > l_types_u = { 0, 1 };
+
+  float l_s = 1;
+  float l_t = 1;
+  float l_u = 0;
+
+  backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+
+  backend::BinaryContraction l_bin_cons[2] = { backend::BinaryContraction( nullptr ),
+                                               backend::BinaryContraction( &l_pool ) };
+
+  for( int64_t l_bc = 0; l_bc < 2; l_bc++ ) {
+    auto l_tppdot = [&]() {
+      l_bin_cons[l_bc].tppdot( 2,
+                               2,
+                               2,
+                               l_sizes.data(),
+                               l_sizes.data(),
+                               l_types_s.data(),
+                               l_types_t.data(),
+                               l_types_u.data(),
+                               l_strides.data(),
+                               l_strides.data(),
+                               l_strides.data(),
+                               &l_s,
+                               &l_t,
+                               &l_u,
+                               backend::dtype_t::fp32,
+                               backend::dtype_t::fp32,
+                               l_epilogue );
+    };
+
+    // warmup constructs the plan
+    l_tppdot();
+
+    l_tp0 = std::chrono::high_resolution_clock::now();
+    for( int64_t l_re = 0; l_re < i_n_repetitions; l_re++ ) {
+      l_tppdot();
+    }
+    l_tp1 = std::chrono::high_resolution_clock::now();
+
+    l_dur_tppdot[l_bc] = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  }
+
+  return std::make_tuple( l_dur_omp.count()       / i_n_repetitions,
+                          l_dur_pool.count()      / i_n_repetitions,
+                          l_dur_tppdot[0].count() / i_n_repetitions,
+                          l_dur_tppdot[1].count() / i_n_repetitions );
+}
+
+double tpp_nets::bench::TensorDot::peak_gflops( backend::dtype_t i_dtype_in,
+                                                double           i_time_target ) {
+  // batch of GEMMs: every thread works on a few blocks which fit into its caches
+  int64_t l_size_gemm = 64;
+  int64_t l_size_batch = 4 * omp_get_max_threads();
+
+  std::vector< int64_t > l_sizes_s = { l_size_batch, l_size_gemm, l_size_gemm };
+  std::vector< int64_t > l_sizes_t = { l_size_batch, l_size_gemm, l_size_gemm };
+  std::vector< int64_t > l_sizes_u = { l_size_batch, l_size_gemm, l_size_gemm };
+
+  std::vector< int8_t > l_types_s = { 2, 1, 0 };
+  std::vector< int8_t > l_types_t = { 2, 0, 1 };
+  std::vector< int8_t > l_types_u = { 2, 1, 0 };
+
+  std::vector< int64_t > l_strides = { l_size_gemm * l_size_gemm, l_size_gemm, 1 };
+
+  // FP32 is accumulated in the output for low precision inputs
+  backend::dtype_t l_dtype_out = ( i_dtype_in == backend::dtype_t::fp64 ) ? backend::dtype_t::fp64 : backend::dtype_t::fp32;
+
+  int64_t l_size_in  = c10::elementSize( to_aten( i_dtype_in ) );
+  int64_t l_size_out = c10::elementSize( to_aten( l_dtype_out ) );
+  int64_t l_n_entries = l_size_batch * l_size_gemm * l_size_gemm;
+
+  // the values do not influence the duration
+  std::vector< char > l_s( l_n_entries * l_size_in, 0 );
+  std::vector< char > l_t( l_n_entries * l_size_in, 0 );
+  std::vector< char > l_u( l_n_entries * l_size_out, 0 );
+
+  tpp_nets::backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+
+  tpp_nets::backend::ContractionPlan l_plan;
+  l_plan.init( 3,
+               3,
+               3,
+               l_sizes_s.data(),
+               l_sizes_t.data(),
+               l_types_s.data(),
+               l_types_t.data(),
+               l_types_u.data(),
+               l_strides.data(),
+               l_strides.data(),
+               l_strides.data(),
+               i_dtype_in,
+               l_dtype_out,
+               l_epilogue );
+
+  auto l_kernel = [&]() {
+    l_plan.execute( l_s.data(),
+                    l_t.data(),
+                    l_u.data() );
+  };
+
+  // calibration
+  int64_t l_n_warmup = 0;
+  std::vector< double > l_samples = sample( l_kernel,
+                                            10,
+                                            1,
+                                            false,
+                                            l_n_warmup );
+  int64_t l_n_samples = 10;
+  int64_t l_n_repetitions = std::max( 1.0, 10 * i_time_target / ( l_n_samples * l_samples[0] ) );
+
+  // the fastest sample is the peak
+  l_samples = sample( l_kernel,
+                      l_n_repetitions,
+                      l_n_samples,
+                      false,
+                      l_n_warmup );
+  double l_dur_min = *std::min_element( l_samples.begin(), l_samples.end() );
+
+  int64_t l_n_flops = n_flops( l_sizes_s,
+                               l_sizes_u,
+                               l_types_s );
+
+  return 1.0E-9 * l_n_flops * l_n_repetitions / l_dur_min;
+}
+
+double tpp_nets::bench::TensorDot::peak_bandwidth( double i_time_target ) {
+  // every array is larger than the last level cache
+  int64_t l_size = std::max( (int64_t) 4 * sysconf( _SC_LEVEL3_CACHE_SIZE ),
+                             m_flush_size_min );
+  int64_t l_n_values = l_size / sizeof(double);
+
+  double * l_a = new double[l_n_values];
+  double * l_b = new double[l_n_values];
+  double * l_c = new double[l_n_values];
+
+  // first touch by the threads using the values
+#pragma omp parallel for schedule(static)
+  for( int64_t l_va = 0; l_va < l_n_values; l_va++ ) {
+    l_a[l_va] = 0;
+    l_b[l_va] = 1;
+    l_c[l_va] = 2;
+  }
+
+  auto l_triad = [&]() {
+#pragma omp parallel for simd schedule(static)
+    for( int64_t l_va = 0; l_va < l_n_values; l_va++ ) {
+      l_a[l_va] = l_b[l_va] + 3.0 * l_c[l_va];
+    }
+  };
+
+  // calibration
+  int64_t l_n_warmup = 0;
+  std::vector< double > l_samples = sample( l_triad,
+                                            1,
+                                            1,
+                                            false,
+                                            l_n_warmup );
+  int64_t l_n_samples = std::max( 1.0, i_time_target / l_samples[0] );
+  l_n_samples = std::min( l_n_samples, (int64_t) 1000 );
+
+  // the fastest repetition is the peak
+  l_samples = sample( l_triad,
+                      1,
+                      l_n_samples,
+                      false,
+                      l_n_warmup );
+  double l_dur_min = *std::min_element( l_samples.begin(), l_samples.end() );
+
+  delete[] l_a;
+  delete[] l_b;
+  delete[] l_c;
+
+  return 1.0E-9 * 3 * l_n_values * sizeof(double) / l_dur_min;
+}
+
+void tpp_nets::bench::TensorDot::write_results( std::string           const & i_path,
+                                                std::vector< Record > const & i_records,
+                                                bool                          i_cold ) {
+  // metadata
+  char l_host[256] = { 0 };
+  gethostname( l_host,
+               sizeof( l_host ) - 1 );
+
+  char l_time[32] = { 0 };
+  std::time_t l_now = std::time( nullptr );
+  std::strftime( l_time,
+                 sizeof( l_time ),
+                 "%Y-%m-%dT%H:%M:%SZ",
+                 std::gmtime( &l_now ) );
+
+  std::string l_target = libxsmm_get_target_arch();
+  int64_t l_n_threads = omp_get_max_threads();
+
+  // JSON
+  nlohmann::json l_json;
+  l_json["host"] = l_host;
+  l_json["time"] = l_time;
+  l_json["n_threads"] = l_n_threads;
+  l_json["libxsmm_target"] = l_target;
+  l_json["cold_cache"] = i_cold;
+  l_json["results"] = nlohmann::json::array();
+
+  for( std::size_t l_re = 0; l_re < i_records.size(); l_re++ ) {
+    Record const & l_record = i_records[l_re];
+    Result const & l_result = l_record.result;
+
+    nlohmann::json l_entry;
+    l_entry["setting"] = l_record.setting;
+    l_entry["kernel"] = l_record.kernel;
+    l_entry["n_threads"] = l_record.n_threads;
+    l_entry["sizes_s"] = l_record.sizes_s;
+    l_entry["sizes_t"] = l_record.sizes_t;
+    l_entry["sizes_u"] = l_record.sizes_u;
+    l_entry["types_s"] = l_record.types_s;
+    l_entry["types_t"] = l_record.types_t;
+    l_entry["types_u"] = l_record.types_u;
+    l_entry["dtype_in"] = dtype_name( l_record.dtype_in );
+    l_entry["dtype_out"] = dtype_name( l_record.dtype_out );
+    l_entry["correct"] = l_record.correct;
+    l_entry["repetitions"] = l_result.n_repetitions;
+    l_entry["samples"] = l_result.n_samples;
+    l_entry["warmup"] = l_result.n_warmup;
+    l_entry["time"] = l_result.time;
+    l_entry["flush"] = l_result.flush;
+    l_entry["min"] = l_result.stats.min;
+    l_entry["median"] = l_result.stats.median;
+    l_entry["p90"] = l_result.stats.p90;
+    l_entry["p99"] = l_result.stats.p99;
+    l_entry["mean"] = l_result.stats.mean;
+    l_entry["stddev"] = l_result.stats.stddev;
+    l_entry["gflops"] = l_result.gflops;
+    l_entry["flops"] = l_result.n_flops;
+    l_entry["bytes"] = l_result.n_bytes;
+    l_entry["intensity"] = l_result.intensity;
+    l_entry["bandwidth"] = l_result.bandwidth;
+    l_entry["peak_gflops"] = l_result.peak_gflops;
+    l_entry["peak_bandwidth"] = l_result.peak_bandwidth;
+    l_entry["roofline"] = l_result.roofline;
+    l_entry["pct_roofline"] = l_result.pct_roofline;
+    l_entry["setup"] = l_result.setup;
+    l_entry["speedup"] = l_record.speedup;
+    l_entry["efficiency"] = l_record.efficiency;
+    l_entry["busy"] = l_result.busy;
+
+    // hardware counters per call, unavailable events are null
+    if( l_result.counters.size() > 0 ) {
+      for( int64_t l_ev = 0; l_ev < PerfCounters::m_n_events; l_ev++ ) {
+        std::string l_name = PerfCounters::name( (PerfCounters::event_t) l_ev );
+        if( l_result.counters[l_ev] >= 0 ) {
+          l_entry["counters"][l_name] = l_result.counters[l_ev];
+        }
+        else {
+          l_entry["counters"][l_name] = nullptr;
+        }
+      }
+    }
+
+    l_json["results"].push_back( l_entry );
+  }
+
+  std::ofstream l_file_json( i_path + ".json" );
+  l_file_json << l_json.dump( 2 ) << std::endl;
+
+  // CSV, one row per record, the metadata is repeated in every row
+  auto l_join = []( auto const & i_values ) {
+    std::string l_str;
+    for( std::size_t l_va = 0; l_va < i_values.size(); l_va++ ) {
+      if( l_va > 0 ) l_str += "x";
+      l_str += std::to_string( (int64_t) i_values[l_va] );
+    }
+    return l_str;
+  };
+
+  std::ofstream l_file_csv( i_path + ".csv" );
+  l_file_csv << "host,time,n_threads,libxsmm_target,cold_cache,setting,kernel,threads,"
+             << "sizes_s,sizes_t,sizes_u,types_s,types_t,types_u,dtype_in,dtype_out,correct,"
+             << "repetitions,samples,warmup,min,median,p90,p99,mean,stddev,gflops,"
+             << "flops,bytes,intensity,bandwidth,peak_gflops,peak_bandwidth,roofline,pct_roofline,setup,speedup,efficiency";
+  for( int64_t l_ev = 0; l_ev < PerfCounters::m_n_events; l_ev++ ) {
+    l_file_csv << "," << PerfCounters::name( (PerfCounters::event_t) l_ev );
+  }
+  l_file_csv << std::endl;
+
+  l_file_csv.precision( 9 );
+  for( std::size_t l_re = 0; l_re < i_records.size(); l_re++ ) {
+    Record const & l_record = i_records[l_re];
+    Result const & l_result = l_record.result;
+
+    l_file_csv << l_host << "," << l_time << "," << l_n_threads << "," << l_target << "," << i_cold << ","
+               << l_record.setting << "," << l_record.kernel << "," << l_record.n_threads << ","
+               << l_join( l_record.sizes_s ) << "," << l_join( l_record.sizes_t ) << "," << l_join( l_record.sizes_u ) << ","
+               << l_join( l_record.types_s ) << "," << l_join( l_record.types_t ) << "," << l_join( l_record.types_u ) << ","
+               << dtype_name( l_record.dtype_in ) << "," << dtype_name( l_record.dtype_out ) << "," << l_record.correct << ","
+               << l_result.n_repetitions << "," << l_result.n_samples << "," << l_result.n_warmup << ","
+               << l_result.stats.min << "," << l_result.stats.median << "," << l_result.stats.p90 << ","
+               << l_result.stats.p99 << "," << l_result.stats.mean << "," << l_result.stats.stddev << ","
+               << l_result.gflops << "," << l_result.n_flops << "," << l_result.n_bytes << ","
+               << l_result.intensity << "," << l_result.bandwidth << ","
+               << l_result.peak_gflops << "," << l_result.peak_bandwidth << ","
+               << l_result.roofline << "," << l_result.pct_roofline << "," << l_result.setup << ","
+               << l_record.speedup << "," << l_record.efficiency;
+
+    // hardware counters per call, empty if not measured or unavailable
+    for( int64_t l_ev = 0; l_ev < PerfCounters::m_n_events; l_ev++ ) {
+      l_file_csv << ",";
+      if( l_result.counters.size() > 0 && l_result.counters[l_ev] >= 0 ) {
+        l_file_csv << l_result.counters[l_ev];
+      }
+    }
+    l_file_csv << std::endl;
+  }
+}
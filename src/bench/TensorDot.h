@@ -1,9 +1,13 @@
 #ifndef TPP_NETS_BENCH_TENSOR_DOT
+#define TPP_NETS_BENCH_TENSOR_DOT
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <tuple>
 #include <string>
+#include <c10/core/ScalarType.h>
+#include "../backend/DataType.h"
 
 namespace tpp_nets {
   namespace bench {
@@ -12,51 +16,360 @@ namespace tpp_nets {
 }
 
 class tpp_nets::bench::TensorDot {
+  public:
+    //! statistics of the durations of single repetitions, in seconds
+    struct Stats {
+      //! minimum
+      double min = 0;
+      //! median
+      double median = 0;
+      //! 90th percentile
+      double p90 = 0;
+      //! 99th percentile
+      double p99 = 0;
+      //! mean
+      double mean = 0;
+      //! standard deviation
+      double stddev = 0;
+    };
+
+    //! result of a benchmarked kernel
+    struct Result {
+      //! number of repetitions per sample
+      uint64_t n_repetitions = 0;
+      //! number of timed samples
+      int64_t n_samples = 0;
+      //! number of warm-up samples which were discarded
+      int64_t n_warmup = 0;
+      //! total duration of the timed samples in seconds
+      double time = 0;
+      //! duration of the cache flush which precedes every repetition in the cold-cache mode, zero for warm caches
+      double flush = 0;
+      //! statistics of the duration of a single repetition, derived from the samples
+      Stats stats;
+      //! GFLOPS of the median duration
+      double gflops = 0;
+      //! number of floating point operations per call
+      int64_t n_flops = 0;
+      //! compulsory number of bytes moved per call, i.e., S and T are read once and U is written once
+      int64_t n_bytes = 0;
+      //! arithmetic intensity, i.e., floating point operations per compulsory byte
+      double intensity = 0;
+      //! achieved bandwidth in GB/s of the median duration, w.r.t. the compulsory traffic
+      double bandwidth = 0;
+      //! measured peak GFLOPS of the machine for the input datatype, zero if unknown
+      double peak_gflops = 0;
+      //! measured peak bandwidth of the machine in GB/s, zero if unknown
+      double peak_bandwidth = 0;
+      //! roofline bound in GFLOPS, i.e., min(peak GFLOPS, intensity * peak bandwidth), zero if unknown
+      double roofline = 0;
+      //! achieved GFLOPS in percent of the roofline bound, zero if unknown
+      double pct_roofline = 0;
+      //! average time per call required to construct tppdot's contraction plan (zero for at::tensordot)
+      double setup = 0;
+      //! busy time of every thread in seconds, empty for at::tensordot
+      std::vector< double > busy;
+      //! hardware counters per call (indexed by PerfCounters' events), -1 for unavailable events, empty if not measured
+      std::vector< double > counters;
+    };
+
+    //! benchmarked setting and kernel with its result
+    struct Record {
+      //! id of the setting in the config
+      int64_t setting = 0;
+      //! name of the kernel
+      std::string kernel;
+      //! number of threads
+      int64_t n_threads = 0;
+      //! speedup w.r.t. the GFLOPS of the sweep's smallest thread count, zero outside of sweeps
+      double speedup = 0;
+      //! parallel efficiency, i.e., speedup divided by the relative thread count, zero outside of sweeps
+      double efficiency = 0;
+      //! sizes of S's dimensions
+      std::vector< int64_t > sizes_s;
+      //! sizes of T's dimensions
+      std::vector< int64_t > sizes_t;
+      //! sizes of U's dimensions
+      std::vector< int64_t > sizes_u;
+      //! types of S's dimensions
+      std::vector< int8_t > types_s;
+      //! types of T's dimensions
+      std::vector< int8_t > types_t;
+      //! types of U's dimensions
+      std::vector< int8_t > types_u;
+      //! datatype of S and T
+      backend::dtype_t dtype_in = backend::dtype_t::fp32;
+      //! datatype of U
+      backend::dtype_t dtype_out = backend::dtype_t::fp32;
+      //! result of the correctness check, true if not checked
+      bool correct = true;
+      //! performance
+      Result result;
+    };
+
   private:
+    //! maximum number of warm-up samples
+    static constexpr int64_t m_max_warmup = 10;
+
+    //! relative difference of two consecutive samples below which the warm-up ends
+    static constexpr double m_warmup_tolerance = 0.05;
+
+    //! minimum size (in bytes) of the buffer which is written to flush the caches
+    static constexpr int64_t m_flush_size_min = 64 * 1024 * 1024;
+
+    //! number of cache flushes which are timed to calibrate the cold-cache mode
+    static constexpr int64_t m_n_flushes_calibration = 5;
+
+    //! maximum number of timed plan constructions
+    static constexpr int64_t m_max_plans = 10;
+
+    //! time budget (in seconds) of the plan constructions, the first construction is always timed
+    static constexpr double m_time_plans = 0.5;
+
+    /**
+     * Converts a datatype to ATen's scalar type.
+     *
+     * @param i_dtype datatype.
+     * @return scalar type.
+     **/
+    static c10::ScalarType to_aten( backend::dtype_t i_dtype );
+
+    /**
+     * Parses a datatype, i.e., "fp32", "fp64", "bf16" or "fp16".
+     *
+     * @param i_name name of the datatype.
+     * @return datatype.
+     **/
+    static backend::dtype_t parse_dtype( std::string const & i_name );
+
+    /**
+     * Derives the number of floating point operations of a contraction, i.e., two per entry of U and K-iteration.
+     * This includes batch dimensions and U's which are not a plain M x N matrix.
+     *
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_u sizes of U's dimensions.
+     * @param i_types_s types of S's dimensions.
+     * @return number of floating point operations.
+     **/
+    static int64_t n_flops( std::vector< int64_t > const & i_sizes_s,
+                            std::vector< int64_t > const & i_sizes_u,
+                            std::vector<  int8_t > const & i_types_s );
+
+    /**
+     * Derives the compulsory number of bytes moved by a contraction, i.e., S and T are read once and U is written once.
+     *
+     * @param i_sizes_s sizes of S's dimensions.
+     * @param i_sizes_t sizes of T's dimensions.
+     * @param i_sizes_u sizes of U's dimensions.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @return number of bytes.
+     **/
+    static int64_t n_bytes( std::vector< int64_t > const & i_sizes_s,
+                            std::vector< int64_t > const & i_sizes_t,
+                            std::vector< int64_t > const & i_sizes_u,
+                            backend::dtype_t               i_dtype_in,
+                            backend::dtype_t               i_dtype_out );
+
+    /**
+     * Evicts the benchmarked data from the caches by writing a buffer which is larger than the last level cache.
+     * All threads write, i.e., the private caches of all cores are flushed.
+     **/
+    static void flush_cache();
+
+    /**
+     * Samples the duration of a kernel.
+     * Warm-up samples are executed until two consecutive samples differ by less than 5% (at most ten samples).
+     * In the cold-cache mode, the caches are flushed before every repetition and only the repetitions are timed.
+     *
+     * @param i_kernel kernel, a call executes a single repetition.
+     * @param i_n_repetitions number of repetitions per sample.
+     * @param i_n_samples number of timed samples.
+     * @param i_cold true if the caches are flushed before every repetition.
+     * @param o_n_warmup will be set to the number of warm-up samples.
+     * @return durations of the timed samples in seconds.
+     **/
+    static std::vector< double > sample( std::function< void() > const & i_kernel,
+                                         int64_t                         i_n_repetitions,
+                                         int64_t                         i_n_samples,
+                                         bool                            i_cold,
+                                         int64_t                       & o_n_warmup );
+
+    /**
+     * Reads the hardware counters of the OpenMP threads around repetitions of a kernel, see PerfCounters.
+     * In the cold-cache mode, the caches are flushed before every repetition outside of the counted regions.
+     *
+     * @param i_kernel kernel, a call executes a single repetition.
+     * @param i_n_repetitions number of repetitions.
+     * @param i_cold true if the caches are flushed before every repetition.
+     * @return counts per repetition (indexed by PerfCounters' events), -1 for unavailable events, empty if no event is available.
+     **/
+    static std::vector< double > count( std::function< void() > const & i_kernel,
+                                        int64_t                         i_n_repetitions,
+                                        bool                            i_cold );
+
+    /**
+     * Derives the einsum expression of a contraction, e.g., "abcd,aecf->ebfd".
+     *
+     * @param i_types_s types of S's dimensions (0: M, 1: K, 2: B).
+     * @param i_types_t types of T's dimensions (0: N, 1: K, 2: B).
+     * @param i_types_u types of U's dimensions (0: M, 1: N, 2: B).
+     * @return einsum expression.
+     **/
+    static std::string einsum_expression( std::vector< int8_t > const & i_types_s,
+                                          std::vector< int8_t > const & i_types_t,
+                                          std::vector< int8_t > const & i_types_u );
+
     /**
      * Measures the performance (time) of ATen's tensordot(S, T):
      *
-     * The routine is executed repeatedly as specified by the input i_n_repetitions.
+     * The routine is sampled as specified by the inputs i_n_repetitions and i_n_samples, see sample.
+     * ATen's einsum is used instead of tensordot if batch dimensions are present.
      * 
      * @param i_sizes_s sizes of S's dimensions.
      * @param i_sizes_t sizes of T's dimensions.
      * @param i_types_s types of S's dimensions.
      * @param i_types_t types of T's dimensions. 
-     * @param i_n_repetitions number of performed repetitions.
-     * @return duration in seconds.
+     * @param i_types_u types of U's dimensions.
+     * @param i_dtype datatype of S and T.
+     * @param i_n_repetitions number of performed repetitions per sample.
+     * @param i_n_samples number of timed samples.
+     * @param i_cold true if the caches are flushed before every repetition.
+     * @param i_counters true if the hardware counters are read in an additional pass of i_n_repetitions repetitions, i.e., the duration of a sample.
+     * @return (durations of the samples in seconds, number of warm-up samples, hardware counters per repetition).
      **/
-    static double time_aten( std::vector< int64_t > i_sizes_s,
-                             std::vector< int64_t > i_sizes_t,
-                             std::vector<  int8_t > i_types_s,
-                             std::vector<  int8_t > i_types_t,
-                             int64_t                i_n_repetitions );
+    static std::tuple< std::vector< double >,
+                       int64_t,
+                       std::vector< double > > time_aten( std::vector< int64_t > i_sizes_s,
+                                            std::vector< int64_t > i_sizes_t,
+                                            std::vector<  int8_t > i_types_s,
+                                            std::vector<  int8_t > i_types_t,
+                                            std::vector<  int8_t > i_types_u,
+                                            backend::dtype_t       i_dtype,
+                                            int64_t                i_n_repetitions,
+                                            int64_t                i_n_samples,
+                                            bool                   i_cold,
+                                            bool                   i_counters );
 
 
     /**
      * Measures the performance (time) of tppdot:
-     * U += contract(S, T).
+     * U = contract(S, T), U is overwritten.
      *
-     * The routine is executed repeatedly as specified by the input i_n_repetitions.
+     * The construction of the contraction plan and the plan's execution are timed separately.
+     * The construction is repeated at most ten times within a budget of 0.5 seconds,
+     * the execution is sampled as specified by the inputs i_n_repetitions and i_n_samples, see sample.
      *
      * @param i_sizes_s sizes of S's dimensions.
      * @param i_sizes_t sizes of T's dimensions.
      * @param i_sizes_u sizes of U's dimension.
      * @param i_types_s types of S's dimensions.
      * @param i_types_t types of T's dimensions. 
-     * @param i_n_repetitions number of performed repetitions.
-     * @return duration in seconds.
+     * @param i_types_u types of U's dimensions.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_n_repetitions number of performed repetitions per sample.
+     * @param i_n_samples number of timed samples.
+     * @param i_cold true if the caches are flushed before every repetition.
+     * @param i_counters true if the hardware counters are read in an additional pass of i_n_repetitions repetitions, i.e., the duration of a sample.
+     * @return (average duration of a plan construction, durations of the samples, number of warm-up samples, busy time of every thread, hardware counters per repetition), durations in seconds.
      **/
-    static double time_tppdot( std::vector< int64_t > i_sizes_s,
-                               std::vector< int64_t > i_sizes_t,
-                               std::vector< int64_t > i_sizes_u,
-                               std::vector<  int8_t > i_types_s,
-                               std::vector<  int8_t > i_types_t,
-                               std::vector<  int8_t > i_types_u,
-                               int64_t                i_n_repetitions );
+    static std::tuple< double,
+                       std::vector< double >,
+                       int64_t,
+                       std::vector< double >,
+                       std::vector< double > > time_tppdot( std::vector< int64_t > i_sizes_s,
+                                                            std::vector< int64_t > i_sizes_t,
+                                                            std::vector< int64_t > i_sizes_u,
+                                                            std::vector<  int8_t > i_types_s,
+                                                            std::vector<  int8_t > i_types_t,
+                                                            std::vector<  int8_t > i_types_u,
+                                                            backend::dtype_t       i_dtype_in,
+                                                            backend::dtype_t       i_dtype_out,
+                                                            int64_t                i_n_repetitions,
+                                                            int64_t                i_n_samples,
+                                                            bool                   i_cold,
+                                                            bool                   i_counters );
 
   public:
+    /**
+     * Gets the name of a datatype, i.e., "fp32", "fp64", "bf16" or "fp16".
+     *
+     * @param i_dtype datatype.
+     * @return name of the datatype.
+     **/
+    static std::string dtype_name( backend::dtype_t i_dtype );
+
+    /**
+     * Measures the dispatch latency of tppdot's parallel execution,
+     * i.e., the round trip of an empty parallel region on all OpenMP threads and on the process-wide thread pool.
+     * Additionally, the latency of a full tppdot call (plan lookup and execution) of a 1x1x1 contraction is measured for both.
+     *
+     * @param i_n_repetitions number of performed repetitions.
+     * @return (latency of an OpenMP region, latency of a thread pool region,
+     *          latency of a trivial tppdot on OpenMP, latency of a trivial tppdot on the thread pool) in seconds per call.
+     **/
+    static std::tuple< double,
+                       double,
+                       double,
+                       double > time_dispatch( int64_t i_n_repetitions );
+
+    /**
+     * Measures the peak GFLOPS of the machine for the given input datatype.
+     * tppdot executes a batch of small GEMMs whose operands reside in the threads' caches, i.e., the result is the attainable compute peak.
+     *
+     * @param i_dtype_in datatype of the GEMMs' inputs.
+     * @param i_time_target targeted duration of the measurement in seconds.
+     * @return peak GFLOPS.
+     **/
+    static double peak_gflops( backend::dtype_t i_dtype_in,
+                               double           i_time_target = 1.0 );
+
+    /**
+     * Measures the peak bandwidth of the machine in GB/s using a STREAM-like triad on all OpenMP threads.
+     * Each of the three arrays is at least four times larger than the last level cache.
+     * The best repetition is reported, the write-allocate traffic of the triad's output is not counted.
+     *
+     * @param i_time_target targeted duration of the measurement in seconds.
+     * @return peak bandwidth in GB/s.
+     **/
+    static double peak_bandwidth( double i_time_target = 1.0 );
+
+    /**
+     * Sets the number of threads used by tppdot and ATen.
+     *
+     * @param i_n_threads number of threads.
+     **/
+    static void set_num_threads( int64_t i_n_threads );
+
+    /**
+     * Gets the size entries of a dimension in S, T and U.
+     * A dimension is named by its type and the id among the dimensions of the type,
+     * e.g., "m0" is the first M dimension, "k1" the second K dimension and "b0" the first B dimension.
+     *
+     * @param i_dim name of the dimension.
+     * @param io_sizes_s sizes of S's dimensions.
+     * @param io_sizes_t sizes of T's dimensions.
+     * @param io_sizes_u sizes of U's dimensions.
+     * @param i_types_s types of S's dimensions.
+     * @param i_types_t types of T's dimensions.
+     * @param i_types_u types of U's dimensions.
+     * @return pointers to the dimension's size in every tensor containing the dimension.
+     **/
+    static std::vector< int64_t * > dim_sizes( std::string            const & i_dim,
+                                               std::vector< int64_t >       & io_sizes_s,
+                                               std::vector< int64_t >       & io_sizes_t,
+                                               std::vector< int64_t >       & io_sizes_u,
+                                               std::vector<  int8_t > const & i_types_s,
+                                               std::vector<  int8_t > const & i_types_t,
+                                               std::vector<  int8_t > const & i_types_u );
+
     /**
      * Parses a JSON config using the given path.
+     * The config is either an array of settings or an object holding the settings in the entry "settings", see parse_sweep.
+     * The dimension types are checked for consistency, i.e.,
+     * S and U have the same number of M dimensions, T and U the same number of N dimensions,
+     * S and T the same number of K dimensions, and S, T and U the same number of B dimensions.
      *
      * @param i_path path of the JSON config from which the settings are read.
      * @param o_sizes_s will be set to dimension sizes of S.
@@ -65,6 +378,8 @@ class tpp_nets::bench::TensorDot {
      * @param o_types_s will be set to dimension types of S.
      * @param o_types_t will be set to dimension types of T.
      * @param o_types_u will be set to dimension types of U.
+     * @param o_dtypes_in will be set to datatypes of S and T.
+     * @param o_dtypes_out will be set to datatypes of U.
      **/
     static void parse_config( std::string                             i_path,
                               std::vector< std::vector< int64_t > > & o_sizes_s,
@@ -72,10 +387,52 @@ class tpp_nets::bench::TensorDot {
                               std::vector< std::vector< int64_t > > & o_sizes_u,
                               std::vector< std::vector<  int8_t > > & o_types_s,
                               std::vector< std::vector<  int8_t > > & o_types_t,
-                              std::vector< std::vector<  int8_t > > & o_types_u );
+                              std::vector< std::vector<  int8_t > > & o_types_u,
+                              std::vector< backend::dtype_t >       & o_dtypes_in,
+                              std::vector< backend::dtype_t >       & o_dtypes_out );
+
+    /**
+     * Parses a JSON sweep config using the given path, e.g.,
+     *
+     * { "threads": [ 1, 2, 4, 8 ],
+     *   "settings": [ { "sizes_s": [ 64, 64 ], ..., "types_u": [ 1, 0 ],
+     *                   "sweep": [ { "dim": "m0", "start": 64, "stop": 1024, "factor": 2 },
+     *                              { "dim": "k0", "start": 32, "stop": 128, "step": 32 } ],
+     *                   "weak": "n0" } ] }
+     *
+     * Every setting is expanded to the cartesian product of its sweeps.
+     * A sweep is an arithmetic ("step") or geometric ("factor") progression of a dimension's size, "stop" is inclusive.
+     * Settings without "weak" are strong-scaling runs, i.e., the sizes are the same for all thread counts.
+     * For weak scaling, the size of the given dimension is scaled by the number of threads relative to the first thread count.
+     * Without "threads", only the available number of OpenMP threads is used.
+     *
+     * @param i_path path of the JSON config from which the settings are read.
+     * @param o_threads will be set to the thread counts.
+     * @param o_sizes_s will be set to dimension sizes of S.
+     * @param o_sizes_t will be set to dimension sizes of T.
+     * @param o_sizes_u will be set to dimension sizes of U.
+     * @param o_types_s will be set to dimension types of S.
+     * @param o_types_t will be set to dimension types of T.
+     * @param o_types_u will be set to dimension types of U.
+     * @param o_dtypes_in will be set to datatypes of S and T.
+     * @param o_dtypes_out will be set to datatypes of U.
+     * @param o_weak will be set to the weakly scaled dimension of every setting, empty for strong scaling.
+     **/
+    static void parse_sweep( std::string                             i_path,
+                             std::vector< int64_t >                & o_threads,
+                             std::vector< std::vector< int64_t > > & o_sizes_s,
+                             std::vector< std::vector< int64_t > > & o_sizes_t,
+                             std::vector< std::vector< int64_t > > & o_sizes_u,
+                             std::vector< std::vector<  int8_t > > & o_types_s,
+                             std::vector< std::vector<  int8_t > > & o_types_t,
+                             std::vector< std::vector<  int8_t > > & o_types_u,
+                             std::vector< backend::dtype_t >       & o_dtypes_in,
+                             std::vector< backend::dtype_t >       & o_dtypes_out,
+                             std::vector< std::string >            & o_weak );
 
     /**
-     * Check the correctness of the tppdot routine by comparing it to aten::tensordot.
+     * Check the correctness of the tppdot routine by comparing it to at::einsum.
+     * Low precision inputs are upcasted to FP32 for the reference, the tolerances are relaxed accordingly.
      *
      * @param i_sizes_s will be set to dimension sizes of S.
      * @param i_sizes_t will be set to dimension sizes of T.
@@ -83,6 +440,8 @@ class tpp_nets::bench::TensorDot {
      * @param i_types_s will be set to dimension types of S.
      * @param i_types_t will be set to dimension types of T.
      * @param i_types_u will be set to dimension types of U.
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
      * @return true if the same (up to an epsilon, using at::allclose) tensors are computed, false otherwise.
      **/
     static bool check( std::vector< int64_t > i_sizes_s,
@@ -90,10 +449,30 @@ class tpp_nets::bench::TensorDot {
                        std::vector< int64_t > i_sizes_u,
                        std::vector<  int8_t > i_types_s,
                        std::vector<  int8_t > i_types_t,
-                       std::vector<  int8_t > i_types_u );
+                       std::vector<  int8_t > i_types_u,
+                       backend::dtype_t       i_dtype_in  = backend::dtype_t::fp32,
+                       backend::dtype_t       i_dtype_out = backend::dtype_t::fp32 );
+
+    /**
+     * Derives the statistics of samples.
+     * Percentiles are interpolated linearly between the closest ranks.
+     *
+     * @param i_samples samples.
+     * @return statistics.
+     **/
+    static Stats stats( std::vector< double > i_samples );
 
     /**
-     * Benchmarks the performance (repetitions, time, gflops) of the given tensordot implementation.
+     * Benchmarks the performance of the given tensordot implementation.
+     * Both implementations use all available OpenMP threads.
+     *
+     * A calibration pass derives the number of repetitions per sample such that all samples take the targeted time.
+     * In the cold-cache mode, the calibration includes the duration of the cache flush preceding every repetition,
+     * i.e., the targeted time bounds the wall time and not only the timed repetitions.
+     * Afterwards, warm-up samples are executed until the durations are stable, followed by the timed samples.
+     * The statistics and the GFLOPS are derived from the average duration of a repetition in every sample.
+     * If the machine's peaks are given, the result is additionally rated w.r.t. the roofline bound of the contraction's arithmetic intensity.
+     * If requested, the hardware counters of a final pass are reported per call; unavailable counters don't affect the timings.
      *
      * @param i_kernel_type benchmarked kernel, 0: tppdot, 1: at::tensordor.
      * @param i_sizes_s will be set to dimension sizes of S.
@@ -102,21 +481,45 @@ class tpp_nets::bench::TensorDot {
      * @param i_types_s will be set to dimension types of S.
      * @param i_types_t will be set to dimension types of T.
      * @param i_types_u will be set to dimension types of U.
-     * @param i_time_target targeted total execution time; the number of actual repetitions is adjusted accordingly.
-     * @param i_n_repetitions_initial initial number of performed repetitions.
-     * @return (repetitions, time, gflops).
+     * @param i_dtype_in datatype of S and T.
+     * @param i_dtype_out datatype of U.
+     * @param i_time_target targeted total execution time of the timed samples.
+     * @param i_n_samples number of timed samples.
+     * @param i_cold true if the caches are flushed before every repetition (cold-cache mode).
+     * @param i_n_repetitions_initial number of repetitions of the calibration pass.
+     * @param i_peak_gflops measured peak GFLOPS of the machine for the input datatype, zero if unknown.
+     * @param i_peak_bandwidth measured peak bandwidth of the machine in GB/s, zero if unknown.
+     * @param i_counters true if the hardware counters are read.
+     * @return result.
      **/
-    static std::tuple< uint64_t,
-                       double,
-                       double > perf( int8_t                 i_kernel_type,
-                                      std::vector< int64_t > i_sizes_s,
-                                      std::vector< int64_t > i_sizes_t,
-                                      std::vector< int64_t > i_sizes_u,
-                                      std::vector<  int8_t > i_types_s,
-                                      std::vector<  int8_t > i_types_t,
-                                      std::vector<  int8_t > i_types_u,
-                                      double                 i_time_target = 10.0,
-                                      uint64_t               i_n_repetitions_initial = 10 );
+    static Result perf( int8_t                 i_kernel_type,
+                        std::vector< int64_t > i_sizes_s,
+                        std::vector< int64_t > i_sizes_t,
+                        std::vector< int64_t > i_sizes_u,
+                        std::vector<  int8_t > i_types_s,
+                        std::vector<  int8_t > i_types_t,
+                        std::vector<  int8_t > i_types_u,
+                        backend::dtype_t       i_dtype_in = backend::dtype_t::fp32,
+                        backend::dtype_t       i_dtype_out = backend::dtype_t::fp32,
+                        double                 i_time_target = 10.0,
+                        int64_t                i_n_samples = 20,
+                        bool                   i_cold = false,
+                        uint64_t               i_n_repetitions_initial = 10,
+                        double                 i_peak_gflops = 0,
+                        double                 i_peak_bandwidth = 0,
+                        bool                   i_counters = false );
+
+    /**
+     * Writes benchmark results as JSON (i_path.json) and CSV (i_path.csv).
+     * Both include the metadata of the run, i.e., host, number of threads, LIBXSMM's target, time and cold-cache mode.
+     *
+     * @param i_path path of the output files without extension.
+     * @param i_records benchmarked settings and kernels.
+     * @param i_cold true if the results were obtained in the cold-cache mode.
+     **/
+    static void write_results( std::string           const & i_path,
+                               std::vector< Record > const & i_records,
+                               bool                          i_cold );
 };
 
 #endif
\ No newline at end of file
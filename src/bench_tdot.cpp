@@ -1,7 +1,14 @@
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <omp.h>
+#include <sched.h>
 #include "bench/TensorDot.h"
+#include "bench/PerfCounters.h"
 
 int main( int    i_argc,
           char * i_argv[] ) {
@@ -10,8 +17,39 @@ int main( int    i_argc,
   std::cout << "************************************************" << std::endl;
 
 
-  if( i_argc != 2 ) {
-    std::cerr << "Error, usage: ./bech_tdot my_config.json" << std::endl;
+  // optional arguments: cold-cache timing, number of samples, targeted time per run, sweep mode and hardware counters
+  bool l_cold = false;
+  int64_t l_n_samples = 20;
+  double l_time_target = 10.0;
+  bool l_sweep = false;
+  bool l_counters = false;
+  bool l_usage = i_argc >= 2;
+  for( int l_ar = 2; l_ar < i_argc; l_ar++ ) {
+    std::string l_arg = i_argv[l_ar];
+    if( l_arg == "--cold" ) {
+      l_cold = true;
+    }
+    else if( l_arg == "--samples" && l_ar+1 < i_argc ) {
+      l_n_samples = std::atoll( i_argv[++l_ar] );
+      l_usage = l_usage && l_n_samples > 0;
+    }
+    else if( l_arg == "--time" && l_ar+1 < i_argc ) {
+      l_time_target = std::atof( i_argv[++l_ar] );
+      l_usage = l_usage && l_time_target > 0;
+    }
+    else if( l_arg == "--sweep" ) {
+      l_sweep = true;
+    }
+    else if( l_arg == "--counters" ) {
+      l_counters = true;
+    }
+    else {
+      l_usage = false;
+    }
+  }
+
+  if( !l_usage ) {
+    std::cerr << "Error, usage: ./bech_tdot my_config.json [--cold] [--samples N] [--time SECONDS] [--sweep] [--counters]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -31,19 +69,112 @@ int main( int    i_argc,
   std::vector< std::vector<  int8_t > > l_types_t;
   std::vector< std::vector<  int8_t > > l_types_u;
 
+  std::vector< tpp_nets::backend::dtype_t > l_dtypes_in;
+  std::vector< tpp_nets::backend::dtype_t > l_dtypes_out;
+
+  // thread counts and weakly scaled dimensions, fixed settings use all threads
+  std::vector< int64_t > l_threads;
+  std::vector< std::string > l_weak;
+
   // parse config
-  tpp_nets::bench::TensorDot::parse_config( i_argv[1],
-                                            l_sizes_s,
-                                            l_sizes_t,
-                                            l_sizes_u,
-                                            l_types_s,
-                                            l_types_t,
-                                            l_types_u );
+  if( l_sweep ) {
+    tpp_nets::bench::TensorDot::parse_sweep( i_argv[1],
+                                             l_threads,
+                                             l_sizes_s,
+                                             l_sizes_t,
+                                             l_sizes_u,
+                                             l_types_s,
+                                             l_types_t,
+                                             l_types_u,
+                                             l_dtypes_in,
+                                             l_dtypes_out,
+                                             l_weak );
+  }
+  else {
+    tpp_nets::bench::TensorDot::parse_config( i_argv[1],
+                                              l_sizes_s,
+                                              l_sizes_t,
+                                              l_sizes_u,
+                                              l_types_s,
+                                              l_types_t,
+                                              l_types_u,
+                                              l_dtypes_in,
+                                              l_dtypes_out );
+    l_threads.push_back( omp_get_max_threads() );
+    l_weak.resize( l_sizes_s.size() );
+  }
+
+  int64_t l_n_threads_max = omp_get_max_threads();
+  std::cout << "number of threads: " << l_n_threads_max << std::endl;
+  if( l_sweep ) {
+    std::cout << "sweep over threads:";
+    for( std::size_t l_th = 0; l_th < l_threads.size(); l_th++ ) {
+      std::cout << " " << l_threads[l_th];
+    }
+    std::cout << std::endl;
+  }
+
+  // binding of the threads, tppdot assigns fixed blocks of U to the threads
+  std::vector< int > l_cores( omp_get_max_threads(), -1 );
+#pragma omp parallel
+  {
+    l_cores[ omp_get_thread_num() ] = sched_getcpu();
+  }
+
+  std::cout << "thread binding (proc_bind " << (int) omp_get_proc_bind() << "):";
+  for( std::size_t l_th = 0; l_th < l_cores.size(); l_th++ ) {
+    std::cout << " " << l_th << "->" << l_cores[l_th];
+  }
+  std::cout << std::endl;
+  if( omp_get_proc_bind() == omp_proc_bind_false ) {
+    std::cout << "  warning: threads are not bound, set OMP_PROC_BIND and OMP_PLACES for stable placement" << std::endl;
+  }
+
+  // round trip of an empty parallel region and of a trivial tppdot
+  double l_dispatch_omp = 0;
+  double l_dispatch_pool = 0;
+  double l_dispatch_tppdot_omp = 0;
+  double l_dispatch_tppdot_pool = 0;
+  std::tie( l_dispatch_omp,
+            l_dispatch_pool,
+            l_dispatch_tppdot_omp,
+            l_dispatch_tppdot_pool ) = tpp_nets::bench::TensorDot::time_dispatch( 10000 );
+  std::cout << "dispatch latency (empty region): OpenMP " << l_dispatch_omp * 1.0E6 << " us, thread pool "
+            << l_dispatch_pool * 1.0E6 << " us" << std::endl;
+  std::cout << "dispatch latency (1x1x1 tppdot): OpenMP " << l_dispatch_tppdot_omp * 1.0E6 << " us, thread pool "
+            << l_dispatch_tppdot_pool * 1.0E6 << " us" << std::endl;
+
+  // machine peaks on all threads, the settings are rated w.r.t. the roofline if they use all threads
+  double l_peak_bandwidth = tpp_nets::bench::TensorDot::peak_bandwidth();
+  std::cout << "peak bandwidth (triad): " << l_peak_bandwidth << " GB/s" << std::endl;
+
+  std::map< tpp_nets::backend::dtype_t, double > l_peak_gflops;
+  for( std::size_t l_co = 0; l_co < l_dtypes_in.size(); l_co++ ) {
+    if( l_peak_gflops.count( l_dtypes_in[l_co] ) == 0 ) {
+      l_peak_gflops[ l_dtypes_in[l_co] ] = tpp_nets::bench::TensorDot::peak_gflops( l_dtypes_in[l_co] );
+      std::cout << "peak GFLOPS (dtype_in " << tpp_nets::bench::TensorDot::dtype_name( l_dtypes_in[l_co] ) << "): " << l_peak_gflops[ l_dtypes_in[l_co] ] << std::endl;
+    }
+  }
+
+  // the counters degrade gracefully, e.g., if perf_event_open is not permitted in a container
+  if( l_counters ) {
+    tpp_nets::bench::PerfCounters l_probe;
+    std::cout << "hardware counters:";
+    for( int64_t l_ev = 0; l_ev < tpp_nets::bench::PerfCounters::m_n_events; l_ev++ ) {
+      tpp_nets::bench::PerfCounters::event_t l_event = (tpp_nets::bench::PerfCounters::event_t) l_ev;
+      std::cout << " " << tpp_nets::bench::PerfCounters::name( l_event )
+                << ( l_probe.available( l_event ) ? "" : " (unavailable)" );
+    }
+    std::cout << std::endl;
+    if( !l_probe.available() ) {
+      std::cout << "  warning: perf_event_open failed, check /proc/sys/kernel/perf_event_paranoid and the container's seccomp profile" << std::endl;
+    }
+  }
+
+  std::cout << "samples per setting: " << l_n_samples << ( l_cold ? " (cold cache)" : " (warm cache)" ) << std::endl;
 
   // run settings
-  uint64_t l_n_repetitions = 0;
-  double l_time = 0;
-  double l_gflops = 0;
+  std::vector< tpp_nets::bench::TensorDot::Record > l_records;
 
   for( std::size_t l_co = 0; l_co < l_sizes_s.size(); l_co++ ) {
     std::cout << "*** setting " << l_co+1 << " of " << l_sizes_s.size() << " ***" << std::endl;
@@ -84,40 +215,205 @@ int main( int    i_argc,
     }
     std::cout << std::endl;
 
+    std::cout << "  dtype_in: " << tpp_nets::bench::TensorDot::dtype_name( l_dtypes_in[l_co] ) << std::endl;
+    std::cout << "  dtype_out: " << tpp_nets::bench::TensorDot::dtype_name( l_dtypes_out[l_co] ) << std::endl;
+
+    if( !l_weak[l_co].empty() ) {
+      std::cout << "  weak scaling of dimension " << l_weak[l_co] << std::endl;
+    }
+
+    // records of this setting, the kernels' thread counts are contiguous
+    std::size_t l_first_record = l_records.size();
+
     for( int8_t l_kernel_type = 0; l_kernel_type < 2; l_kernel_type++ ) {
-      if( l_kernel_type == 0 ) {
-        std::cout << "tppdot:" << std::endl;
-
-        bool l_correct = tpp_nets::bench::TensorDot::check( l_sizes_s[l_co],
-                                                            l_sizes_t[l_co],
-                                                            l_sizes_u[l_co],
-                                                            l_types_s[l_co],
-                                                            l_types_t[l_co],
-                                                            l_types_u[l_co] );
-        std::cout << "  correctness: " << l_correct << std::endl;
+      std::size_t l_first_record_kernel = l_records.size();
+
+      for( std::size_t l_th = 0; l_th < l_threads.size(); l_th++ ) {
+        tpp_nets::bench::TensorDot::set_num_threads( l_threads[l_th] );
+
+        tpp_nets::bench::TensorDot::Record l_record;
+        l_record.setting   = l_co;
+        l_record.n_threads = l_threads[l_th];
+        l_record.sizes_s   = l_sizes_s[l_co];
+        l_record.sizes_t   = l_sizes_t[l_co];
+        l_record.sizes_u   = l_sizes_u[l_co];
+        l_record.types_s   = l_types_s[l_co];
+        l_record.types_t   = l_types_t[l_co];
+        l_record.types_u   = l_types_u[l_co];
+        l_record.dtype_in  = l_dtypes_in[l_co];
+        l_record.dtype_out = l_dtypes_out[l_co];
+
+        // weak scaling: the dimension grows with the number of threads
+        if( !l_weak[l_co].empty() ) {
+          std::vector< int64_t * > l_entries = tpp_nets::bench::TensorDot::dim_sizes( l_weak[l_co],
+                                                                                      l_record.sizes_s,
+                                                                                      l_record.sizes_t,
+                                                                                      l_record.sizes_u,
+                                                                                      l_record.types_s,
+                                                                                      l_record.types_t,
+                                                                                      l_record.types_u );
+          for( std::size_t l_en = 0; l_en < l_entries.size(); l_en++ ) {
+            *l_entries[l_en] = *l_entries[l_en] * l_threads[l_th] / l_threads[0];
+          }
+        }
+
+        if( l_kernel_type == 0 ) {
+          std::cout << "tppdot";
+          l_record.kernel = "tppdot";
+        }
+        else if( l_kernel_type == 1) {
+          std::cout << "at::tensordot";
+          l_record.kernel = "at::tensordot";
+        }
+        if( l_sweep ) {
+          std::cout << " (" << l_threads[l_th] << " threads)";
+        }
+        std::cout << ":" << std::endl;
+
+        if( l_kernel_type == 0 ) {
+          bool l_correct = tpp_nets::bench::TensorDot::check( l_record.sizes_s,
+                                                              l_record.sizes_t,
+                                                              l_record.sizes_u,
+                                                              l_record.types_s,
+                                                              l_record.types_t,
+                                                              l_record.types_u,
+                                                              l_record.dtype_in,
+                                                              l_record.dtype_out );
+          std::cout << "  correctness: " << l_correct << std::endl;
+          l_record.correct = l_correct;
+        }
+
+        // the peaks were measured on all threads
+        bool l_roofline = l_threads[l_th] == l_n_threads_max;
+
+        l_record.result = tpp_nets::bench::TensorDot::perf( l_kernel_type,
+                                                            l_record.sizes_s,
+                                                            l_record.sizes_t,
+                                                            l_record.sizes_u,
+                                                            l_record.types_s,
+                                                            l_record.types_t,
+                                                            l_record.types_u,
+                                                            l_record.dtype_in,
+                                                            l_record.dtype_out,
+                                                            l_time_target,
+                                                            l_n_samples,
+                                                            l_cold,
+                                                            10,
+                                                            l_roofline ? l_peak_gflops[ l_dtypes_in[l_co] ] : 0,
+                                                            l_roofline ? l_peak_bandwidth : 0,
+                                                            l_counters );
+        tpp_nets::bench::TensorDot::Result const & l_result = l_record.result;
+
+        std::cout << "  repetitions: " << l_result.n_repetitions << " per sample, "
+                  << l_result.n_samples << " samples, " << l_result.n_warmup << " warm-up samples" << std::endl;
+        if( l_cold ) {
+          std::cout << "  cache flush: " << l_result.flush << " seconds before every repetition" << std::endl;
+        }
+        std::cout << "  duration: " << l_result.time << " seconds" << std::endl;
+        std::cout << "  time per call: min " << l_result.stats.min
+                  << ", median " << l_result.stats.median
+                  << ", p90 " << l_result.stats.p90
+                  << ", p99 " << l_result.stats.p99
+                  << ", stddev " << l_result.stats.stddev << " seconds" << std::endl;
+        std::cout << "  GFLOPS (median): " << l_result.gflops << std::endl;
+        std::cout << "  arithmetic intensity: " << l_result.intensity << " FLOP/byte (compulsory traffic)" << std::endl;
+        std::cout << "  bandwidth (median): " << l_result.bandwidth << " GB/s" << std::endl;
+        if( l_roofline ) {
+          std::cout << "  roofline: " << l_result.pct_roofline << "% of " << l_result.roofline << " GFLOPS ("
+                    << ( l_result.roofline < l_result.peak_gflops ? "bandwidth" : "compute" ) << " bound)" << std::endl;
+        }
+        if( l_result.counters.size() > 0 ) {
+          std::vector< double > const & l_values = l_result.counters;
+          std::cout << "  hardware counters per call:";
+          for( int64_t l_ev = 0; l_ev < tpp_nets::bench::PerfCounters::m_n_events; l_ev++ ) {
+            if( l_values[l_ev] >= 0 ) {
+              std::cout << " " << tpp_nets::bench::PerfCounters::name( (tpp_nets::bench::PerfCounters::event_t) l_ev )
+                        << " " << l_values[l_ev];
+            }
+          }
+          std::cout << std::endl;
+
+          // derived metrics: IPC and misses per thousand instructions
+          double l_cycles = l_values[ (int64_t) tpp_nets::bench::PerfCounters::event_t::cycles ];
+          double l_instructions = l_values[ (int64_t) tpp_nets::bench::PerfCounters::event_t::instructions ];
+          if( l_cycles > 0 && l_instructions > 0 ) {
+            std::cout << "  IPC: " << l_instructions / l_cycles;
+            for( int64_t l_ev = (int64_t) tpp_nets::bench::PerfCounters::event_t::l1d_misses;
+                 l_ev <= (int64_t) tpp_nets::bench::PerfCounters::event_t::dtlb_misses;
+                 l_ev++ ) {
+              if( l_values[l_ev] >= 0 ) {
+                std::cout << ", " << tpp_nets::bench::PerfCounters::name( (tpp_nets::bench::PerfCounters::event_t) l_ev )
+                          << " per kilo-instruction " << 1000.0 * l_values[l_ev] / l_instructions;
+              }
+            }
+            std::cout << std::endl;
+          }
+        }
+        if( l_kernel_type == 0 ) {
+          std::cout << "  plan construction: " << l_result.setup << " seconds per call" << std::endl;
+
+          std::vector< double > const & l_busy = l_result.busy;
+
+          // load balance: busy times of the threads relative to the slowest one
+          double l_busy_max = 0;
+          double l_busy_avg = 0;
+          std::cout << "  busy time per thread:";
+          for( std::size_t l_id = 0; l_id < l_busy.size(); l_id++ ) {
+            std::cout << " " << l_busy[l_id];
+            l_busy_max = std::max( l_busy_max, l_busy[l_id] );
+            l_busy_avg += l_busy[l_id] / l_busy.size();
+          }
+          std::cout << " seconds" << std::endl;
+          if( l_busy_max > 0 ) {
+            std::cout << "  load balance (avg/max busy time): " << l_busy_avg / l_busy_max << std::endl;
+          }
+        }
+
+        l_records.push_back( l_record );
+      }
+
+      // speedup and efficiency w.r.t. the first thread count, for weak scaling through the GFLOPS of the grown problem
+      if( l_sweep ) {
+        tpp_nets::bench::TensorDot::Record const & l_base = l_records[l_first_record_kernel];
+        for( std::size_t l_re = l_first_record_kernel; l_re < l_records.size(); l_re++ ) {
+          l_records[l_re].speedup = l_records[l_re].result.gflops / l_base.result.gflops;
+          l_records[l_re].efficiency = l_records[l_re].speedup * l_base.n_threads / l_records[l_re].n_threads;
+        }
       }
-      else if( l_kernel_type == 1) {
-        std::cout << "at::tensordot:" << std::endl;
+    }
+
+    // scaling table, tppdot vs. at::tensordot at the same number of threads
+    if( l_sweep ) {
+      std::size_t l_n_threads = l_threads.size();
+      std::cout << ( l_weak[l_co].empty() ? "strong" : "weak" ) << " scaling:" << std::endl;
+      std::cout << "  threads | tppdot: GFLOPS speedup efficiency | at::tensordot: GFLOPS speedup efficiency | tppdot/at::tensordot" << std::endl;
+      for( std::size_t l_th = 0; l_th < l_n_threads; l_th++ ) {
+        tpp_nets::bench::TensorDot::Record const & l_tpp = l_records[l_first_record + l_th];
+        tpp_nets::bench::TensorDot::Record const & l_aten = l_records[l_first_record + l_n_threads + l_th];
+
+        std::cout << "  " << l_tpp.n_threads
+                  << " | " << l_tpp.result.gflops << " " << l_tpp.speedup << " " << l_tpp.efficiency
+                  << " | " << l_aten.result.gflops << " " << l_aten.speedup << " " << l_aten.efficiency
+                  << " | " << l_tpp.result.gflops / l_aten.result.gflops << std::endl;
       }
- 
-      std::tie( l_n_repetitions,
-                l_time,
-                l_gflops ) = tpp_nets::bench::TensorDot::perf( l_kernel_type,
-                                                               l_sizes_s[l_co],
-                                                               l_sizes_t[l_co],
-                                                               l_sizes_u[l_co],
-                                                               l_types_s[l_co],
-                                                               l_types_t[l_co],
-                                                               l_types_u[l_co] );
-
-      std::cout << "  repetitions: " << l_n_repetitions << std::endl;
-      std::cout << "  duration: " << l_time << " seconds" << std::endl;
-      std::cout << "  GFLOPS: " << l_gflops << std::endl;
     }
 
     std::cout << std::endl;
   }
 
+  tpp_nets::bench::TensorDot::set_num_threads( l_n_threads_max );
+
+  // machine-readable results next to the config
+  std::string l_path_results = i_argv[1];
+  if( l_path_results.size() > 5 && l_path_results.substr( l_path_results.size() - 5 ) == ".json" ) {
+    l_path_results.resize( l_path_results.size() - 5 );
+  }
+  l_path_results += ".results";
+  tpp_nets::bench::TensorDot::write_results( l_path_results,
+                                             l_records,
+                                             l_cold );
+  std::cout << "results: " << l_path_results << ".json, " << l_path_results << ".csv" << std::endl;
+
   std::cout << "****************" << std::endl;
   std::cout << "*** finished ***" << std::endl;
   std::cout << "****************" << std::endl;
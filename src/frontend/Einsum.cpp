@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include "Einsum.h"
+#include "../backend/BinaryContraction.h"
+
+void tpp_nets::frontend::Einsum::parse( std::string const & i_expr,
+                                        Lowered           & o_lowered ) {
+  // labels of S, T and U
+  std::string l_labels[3];
+  int64_t l_op = 0;
+
+  for( std::size_t l_ch = 0; l_ch < i_expr.size(); l_ch++ ) {
+    char l_char = i_expr[l_ch];
+
+    if( std::isspace( (unsigned char) l_char ) ) {
+      continue;
+    }
+    else if( l_char == ',' ) {
+      TORCH_CHECK( l_op == 0,
+                   "einsum expression \"", i_expr, "\" has more than two inputs" );
+      l_op = 1;
+    }
+    else if( l_char == '-' ) {
+      TORCH_CHECK( l_op == 1,
+                   "einsum expression \"", i_expr, "\" doesn't have two inputs" );
+      TORCH_CHECK( l_ch+1 < i_expr.size() && i_expr[l_ch+1] == '>',
+                   "einsum expression \"", i_expr, "\" has an invalid arrow" );
+      l_op = 2;
+      l_ch++;
+    }
+    else {
+      TORCH_CHECK( std::isalpha( (unsigned char) l_char ),
+                   "einsum expression \"", i_expr, "\" has an invalid label '", l_char, "'" );
+      l_labels[l_op] += l_char;
+    }
+  }
+  // the output has to be given explicitly
+  TORCH_CHECK( l_op == 2,
+               "einsum expression \"", i_expr, "\" doesn't have an explicit output" );
+
+  // labels occur at most once per tensor
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    for( std::size_t l_la = 0; l_la < l_labels[l_te].size(); l_la++ ) {
+      TORCH_CHECK( l_labels[l_te].find( l_labels[l_te][l_la], l_la+1 ) == std::string::npos,
+                   "einsum expression \"", i_expr, "\" repeats label '", l_labels[l_te][l_la], "' in a tensor" );
+    }
+  }
+
+  std::string const & l_labels_s = l_labels[0];
+  std::string const & l_labels_t = l_labels[1];
+  std::string const & l_labels_u = l_labels[2];
+
+  o_lowered.types_s.resize( 0 );
+  o_lowered.types_t.resize( 0 );
+  o_lowered.types_u.resize( 0 );
+  o_lowered.ids_s_t.resize( 0 );
+  o_lowered.ids_s_u.resize( 0 );
+  o_lowered.ids_t_u.resize( 0 );
+  o_lowered.order_t.resize( 0 );
+  o_lowered.order_u.resize( 0 );
+
+  for( std::size_t l_di = 0; l_di < l_labels_s.size(); l_di++ ) {
+    bool l_in_t = l_labels_t.find( l_labels_s[l_di] ) != std::string::npos;
+    bool l_in_u = l_labels_u.find( l_labels_s[l_di] ) != std::string::npos;
+    TORCH_CHECK( l_in_t || l_in_u,
+                 "einsum expression \"", i_expr, "\" sums label '", l_labels_s[l_di], "' of a single input" );
+
+    if(      l_in_t && l_in_u ) o_lowered.types_s.push_back( 2 );
+    else if( l_in_u )           o_lowered.types_s.push_back( 0 );
+    else                        o_lowered.types_s.push_back( 1 );
+  }
+
+  for( std::size_t l_di = 0; l_di < l_labels_t.size(); l_di++ ) {
+    std::size_t l_id_s = l_labels_s.find( l_labels_t[l_di] );
+    bool l_in_s = l_id_s != std::string::npos;
+    bool l_in_u = l_labels_u.find( l_labels_t[l_di] ) != std::string::npos;
+    TORCH_CHECK( l_in_s || l_in_u,
+                 "einsum expression \"", i_expr, "\" sums label '", l_labels_t[l_di], "' of a single input" );
+
+    if(      l_in_s && l_in_u ) o_lowered.types_t.push_back( 2 );
+    else if( l_in_u )           o_lowered.types_t.push_back( 0 );
+    else                        o_lowered.types_t.push_back( 1 );
+
+    o_lowered.ids_s_t.push_back( l_in_s ? (int64_t) l_id_s : -1 );
+  }
+
+  for( std::size_t l_di = 0; l_di < l_labels_u.size(); l_di++ ) {
+    std::size_t l_id_s = l_labels_s.find( l_labels_u[l_di] );
+    std::size_t l_id_t = l_labels_t.find( l_labels_u[l_di] );
+    bool l_in_s = l_id_s != std::string::npos;
+    bool l_in_t = l_id_t != std::string::npos;
+    TORCH_CHECK( l_in_s || l_in_t,
+                 "einsum expression \"", i_expr, "\" has output label '", l_labels_u[l_di], "' which isn't an input label" );
+
+    if(      l_in_s && l_in_t ) o_lowered.types_u.push_back( 2 );
+    else if( l_in_s )           o_lowered.types_u.push_back( 0 );
+    else                        o_lowered.types_u.push_back( 1 );
+
+    o_lowered.ids_s_u.push_back( l_in_s ? (int64_t) l_id_s : -1 );
+    o_lowered.ids_t_u.push_back( l_in_t ? (int64_t) l_id_t : -1 );
+  }
+
+  // T's K and B dimensions follow S's order, the N dimensions keep their positions
+  int64_t l_n_dims_t = l_labels_t.size();
+  int64_t l_n_dims_u = l_labels_u.size();
+
+  std::vector< int64_t > l_slots;
+  std::vector< int64_t > l_dims;
+  for( int64_t l_di = 0; l_di < l_n_dims_t; l_di++ ) {
+    o_lowered.order_t.push_back( l_di );
+    if( o_lowered.ids_s_t[l_di] >= 0 ) {
+      l_slots.push_back( l_di );
+      l_dims.push_back( l_di );
+    }
+  }
+  std::sort( l_dims.begin(),
+             l_dims.end(),
+             [&]( int64_t i_a, int64_t i_b ) { return o_lowered.ids_s_t[i_a] < o_lowered.ids_s_t[i_b]; } );
+  for( std::size_t l_sl = 0; l_sl < l_slots.size(); l_sl++ ) {
+    o_lowered.order_t[ l_slots[l_sl] ] = l_dims[l_sl];
+  }
+
+  // positions of T's dimensions in the backend's order
+  std::vector< int64_t > l_pos_t( l_n_dims_t );
+  for( int64_t l_di = 0; l_di < l_n_dims_t; l_di++ ) {
+    l_pos_t[ o_lowered.order_t[l_di] ] = l_di;
+  }
+
+  // U's M and B dimensions follow S's order, the N dimensions follow T's
+  std::vector< int64_t > l_slots_n;
+  std::vector< int64_t > l_dims_n;
+  l_slots.resize( 0 );
+  l_dims.resize( 0 );
+  for( int64_t l_di = 0; l_di < l_n_dims_u; l_di++ ) {
+    o_lowered.order_u.push_back( l_di );
+    if( o_lowered.ids_s_u[l_di] >= 0 ) {
+      l_slots.push_back( l_di );
+      l_dims.push_back( l_di );
+    }
+    else {
+      l_slots_n.push_back( l_di );
+      l_dims_n.push_back( l_di );
+    }
+  }
+  std::sort( l_dims.begin(),
+             l_dims.end(),
+             [&]( int64_t i_a, int64_t i_b ) { return o_lowered.ids_s_u[i_a] < o_lowered.ids_s_u[i_b]; } );
+  std::sort( l_dims_n.begin(),
+             l_dims_n.end(),
+             [&]( int64_t i_a, int64_t i_b ) { return l_pos_t[ o_lowered.ids_t_u[i_a] ] < l_pos_t[ o_lowered.ids_t_u[i_b] ]; } );
+  for( std::size_t l_sl = 0; l_sl < l_slots.size(); l_sl++ ) {
+    o_lowered.order_u[ l_slots[l_sl] ] = l_dims[l_sl];
+  }
+  for( std::size_t l_sl = 0; l_sl < l_slots_n.size(); l_sl++ ) {
+    o_lowered.order_u[ l_slots_n[l_sl] ] = l_dims_n[l_sl];
+  }
+}
+
+tpp_nets::backend::dtype_t tpp_nets::frontend::Einsum::dtype( c10::ScalarType i_type ) {
+  if(      i_type == at::kFloat    ) return backend::dtype_t::fp32;
+  else if( i_type == at::kDouble   ) return backend::dtype_t::fp64;
+  else if( i_type == at::kBFloat16 ) return backend::dtype_t::bf16;
+  else if( i_type == at::kHalf     ) return backend::dtype_t::fp16;
+
+  TORCH_CHECK( false,
+               "tppdot doesn't support dtype ", i_type );
+  return backend::dtype_t::fp32;
+}
+
+tpp_nets::frontend::Einsum & tpp_nets::frontend::Einsum::instance() {
+  static Einsum l_einsum;
+  return l_einsum;
+}
+
+std::shared_ptr< tpp_nets::frontend::Einsum::Lowered const > tpp_nets::frontend::Einsum::lower( std::string const & i_expr ) {
+  // hit
+  {
+    std::shared_lock< std::shared_mutex > l_lock( m_mutex );
+    auto l_it = m_lowered.find( i_expr );
+    if( l_it != m_lowered.end() ) {
+      return l_it->second;
+    }
+  }
+
+  // miss: parse outside of the lock
+  std::shared_ptr< Lowered > l_lowered = std::make_shared< Lowered >();
+  parse( i_expr,
+         *l_lowered );
+  m_n_parses.fetch_add( 1, std::memory_order_relaxed );
+
+  // another thread might have inserted the expression in the meantime
+  std::unique_lock< std::shared_mutex > l_lock( m_mutex );
+  auto l_res = m_lowered.emplace( i_expr,
+                                  l_lowered );
+  return l_res.first->second;
+}
+
+void tpp_nets::frontend::Einsum::contract( std::string const & i_expr,
+                                           at::Tensor  const & i_s,
+                                           at::Tensor  const & i_t,
+                                           at::Tensor        & o_u ) {
+  std::shared_ptr< Lowered const > l_lowered = lower( i_expr );
+
+  contract( *l_lowered,
+            i_s,
+            i_t,
+            o_u );
+}
+
+void tpp_nets::frontend::Einsum::contract( Lowered    const & i_lowered,
+                                           at::Tensor const & i_s,
+                                           at::Tensor const & i_t,
+                                           at::Tensor       & o_u ) {
+  int64_t l_n_dims_s = i_lowered.types_s.size();
+  int64_t l_n_dims_t = i_lowered.types_t.size();
+  int64_t l_n_dims_u = i_lowered.types_u.size();
+  TORCH_CHECK( i_s.dim() == l_n_dims_s,
+               "tppdot expected S with ", l_n_dims_s, " dimensions, but got ", i_s.dim() );
+  TORCH_CHECK( i_t.dim() == l_n_dims_t,
+               "tppdot expected T with ", l_n_dims_t, " dimensions, but got ", i_t.dim() );
+  TORCH_CHECK( o_u.dim() == l_n_dims_u,
+               "tppdot expected U with ", l_n_dims_u, " dimensions, but got ", o_u.dim() );
+
+  // sizes of dimensions with the same label have to match
+  for( int64_t l_di = 0; l_di < l_n_dims_t; l_di++ ) {
+    TORCH_CHECK(    i_lowered.ids_s_t[l_di] < 0
+                 || i_t.size( l_di ) == i_s.size( i_lowered.ids_s_t[l_di] ),
+                 "tppdot: size ", i_t.size( l_di ), " of T's dimension ", l_di,
+                 " doesn't match the size of S's dimension with the same label" );
+  }
+  for( int64_t l_di = 0; l_di < l_n_dims_u; l_di++ ) {
+    TORCH_CHECK(    i_lowered.ids_s_u[l_di] < 0
+                 || o_u.size( l_di ) == i_s.size( i_lowered.ids_s_u[l_di] ),
+                 "tppdot: size ", o_u.size( l_di ), " of U's dimension ", l_di,
+                 " doesn't match the size of S's dimension with the same label" );
+    TORCH_CHECK(    i_lowered.ids_t_u[l_di] < 0
+                 || o_u.size( l_di ) == i_t.size( i_lowered.ids_t_u[l_di] ),
+                 "tppdot: size ", o_u.size( l_di ), " of U's dimension ", l_di,
+                 " doesn't match the size of T's dimension with the same label" );
+  }
+
+  TORCH_CHECK( i_s.scalar_type() == i_t.scalar_type(),
+               "tppdot expected S and T with the same dtype, but got ", i_s.scalar_type(), " and ", i_t.scalar_type() );
+  TORCH_CHECK(    o_u.scalar_type() == i_s.scalar_type()
+               || (    o_u.scalar_type() == at::kFloat
+                    && ( i_s.scalar_type() == at::kBFloat16 || i_s.scalar_type() == at::kHalf ) ),
+               "tppdot expected U with the dtype of S (or float for low-precision S), but got ", o_u.scalar_type(),
+               " for S with dtype ", i_s.scalar_type() );
+  TORCH_CHECK( i_s.is_cpu() && i_t.is_cpu() && o_u.is_cpu(),
+               "tppdot expected tensors on the CPU, but got ", i_s.device(), ", ", i_t.device(), " and ", o_u.device() );
+
+  // empty tensors: nothing to compute, but a non-empty U has to hold the empty sum over K
+  if( i_s.numel() == 0 || i_t.numel() == 0 || o_u.numel() == 0 ) {
+    if( o_u.numel() > 0 ) {
+      o_u.zero_();
+    }
+    return;
+  }
+
+  // T's and U's dimensions in the backend's order
+  std::vector< int64_t > l_sizes_t( l_n_dims_t );
+  std::vector< int64_t > l_strides_t( l_n_dims_t );
+  std::vector< int8_t > l_types_t( l_n_dims_t );
+  for( int64_t l_di = 0; l_di < l_n_dims_t; l_di++ ) {
+    l_sizes_t[l_di]   = i_t.size(   i_lowered.order_t[l_di] );
+    l_strides_t[l_di] = i_t.stride( i_lowered.order_t[l_di] );
+    l_types_t[l_di]   = i_lowered.types_t[ i_lowered.order_t[l_di] ];
+  }
+
+  std::vector< int64_t > l_strides_u( l_n_dims_u );
+  std::vector< int8_t > l_types_u( l_n_dims_u );
+  for( int64_t l_di = 0; l_di < l_n_dims_u; l_di++ ) {
+    l_strides_u[l_di] = o_u.stride( i_lowered.order_u[l_di] );
+    l_types_u[l_di]   = i_lowered.types_u[ i_lowered.order_u[l_di] ];
+  }
+
+  backend::Epilogue l_epilogue;
+  l_epilogue.zero_u = true;
+
+  backend::BinaryContraction l_bin_con;
+  l_bin_con.tppdot( l_n_dims_s,
+                    l_n_dims_t,
+                    l_n_dims_u,
+                    i_s.sizes().data(),
+                    l_sizes_t.data(),
+                    i_lowered.types_s.data(),
+                    l_types_t.data(),
+                    l_types_u.data(),
+                    i_s.strides().data(),
+                    l_strides_t.data(),
+                    l_strides_u.data(),
+                    i_s.data_ptr(),
+                    i_t.data_ptr(),
+                    o_u.data_ptr(),
+                    dtype( i_s.scalar_type() ),
+                    dtype( o_u.scalar_type() ),
+                    l_epilogue );
+}
+
+void tpp_nets::frontend::Einsum::clear() {
+  std::unique_lock< std::shared_mutex > l_lock( m_mutex );
+  m_lowered.clear();
+  m_n_parses = 0;
+}
+
+void tpp_nets::einsum( std::string const & i_expr,
+                       at::Tensor  const & i_s,
+                       at::Tensor  const & i_t,
+                       at::Tensor        & o_u ) {
+  frontend::Einsum::instance().contract( i_expr,
+                                         i_s,
+                                         i_t,
+                                         o_u );
+}
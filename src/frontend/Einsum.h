@@ -0,0 +1,162 @@
+#ifndef TPP_NETS_FRONTEND_EINSUM
+#define TPP_NETS_FRONTEND_EINSUM
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ATen/ATen.h>
+#include "../backend/DataType.h"
+
+namespace tpp_nets {
+  namespace frontend {
+    class Einsum;
+  }
+}
+
+/**
+ * Einsum-style front-end of binary tensor contractions, e.g., "abcd,aecf->ebfd".
+ *
+ * An expression is lowered once to the dimension types of S, T and U:
+ *   - labels of S and U are M dimensions,
+ *   - labels of T and U are N dimensions,
+ *   - labels of S and T are K dimensions,
+ *   - labels of S, T and U are B dimensions.
+ * Lowered expressions are cached, i.e., parsing is only done in the first call for an expression.
+ * Sizes, strides and datatypes are taken from the tensors, the contraction is dispatched to BinaryContraction,
+ * which caches the contraction plan per geometry.
+ * The backend matches dimensions of the same type by their order,
+ * i.e., T's and U's dimensions are reordered such that they follow the order of the matching dimensions in S (and T).
+ *
+ * Labels are single letters. Every label has to occur in exactly two or all three tensors,
+ * i.e., diagonals, reductions over a single operand, ellipses and implicit outputs are not supported.
+ * Invalid expressions and tensors which don't match the expression (ranks, sizes, dtypes, devices) raise a c10::Error.
+ * U has S's dtype or, for BF16 and FP16 inputs, float. Empty tensors are supported, an empty K zeroes U.
+ **/
+class tpp_nets::frontend::Einsum {
+  public:
+    //! lowered einsum expression
+    struct Lowered {
+      //! types of S's dimensions (0: M, 1: K, 2: B)
+      std::vector< int8_t > types_s;
+      //! types of T's dimensions (0: N, 1: K, 2: B)
+      std::vector< int8_t > types_t;
+      //! types of U's dimensions (0: M, 1: N, 2: B)
+      std::vector< int8_t > types_u;
+
+      //! for every dimension of T: matching dimension of S, -1 for N dimensions
+      std::vector< int64_t > ids_s_t;
+      //! for every dimension of U: matching dimension of S, -1 for N dimensions
+      std::vector< int64_t > ids_s_u;
+      //! for every dimension of U: matching dimension of T, -1 for M dimensions
+      std::vector< int64_t > ids_t_u;
+
+      //! order in which T's dimensions are passed to the backend
+      std::vector< int64_t > order_t;
+      //! order in which U's dimensions are passed to the backend
+      std::vector< int64_t > order_u;
+    };
+
+  private:
+    //! mutex protecting the lowered expressions
+    mutable std::shared_mutex m_mutex;
+
+    //! lowered expressions
+    std::unordered_map< std::string,
+                        std::shared_ptr< Lowered const > > m_lowered;
+
+    //! number of parsed expressions
+    std::atomic< uint64_t > m_n_parses = 0;
+
+    /**
+     * Parses an einsum expression.
+     *
+     * @param i_expr einsum expression.
+     * @param o_lowered will be set to the lowered expression.
+     **/
+    static void parse( std::string const & i_expr,
+                       Lowered           & o_lowered );
+
+    /**
+     * Converts ATen's scalar type to a datatype.
+     *
+     * @param i_type scalar type.
+     * @return datatype.
+     **/
+    static backend::dtype_t dtype( c10::ScalarType i_type );
+
+  public:
+    /**
+     * Gets the process-wide einsum front-end.
+     *
+     * @return einsum front-end.
+     **/
+    static Einsum & instance();
+
+    /**
+     * Gets the lowered einsum expression.
+     * The expression is parsed and inserted into the cache on a miss.
+     *
+     * @param i_expr einsum expression.
+     * @return lowered expression.
+     **/
+    std::shared_ptr< Lowered const > lower( std::string const & i_expr );
+
+    /**
+     * Contracts two tensors: U = einsum(expr, S, T), U is overwritten.
+     *
+     * @param i_expr einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @param o_u output tensor U, has to be allocated.
+     **/
+    void contract( std::string const & i_expr,
+                   at::Tensor  const & i_s,
+                   at::Tensor  const & i_t,
+                   at::Tensor        & o_u );
+
+    /**
+     * Contracts two tensors through a lowered expression: U = einsum(expr, S, T), U is overwritten.
+     *
+     * @param i_lowered lowered einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @param o_u output tensor U, has to be allocated.
+     **/
+    static void contract( Lowered    const & i_lowered,
+                          at::Tensor const & i_s,
+                          at::Tensor const & i_t,
+                          at::Tensor       & o_u );
+
+    /**
+     * Removes all lowered expressions from the cache and resets the counter.
+     **/
+    void clear();
+
+    /**
+     * Gets the number of parsed expressions.
+     *
+     * @return number of parsed expressions.
+     **/
+    uint64_t n_parses() const { return m_n_parses.load( std::memory_order_relaxed ); }
+};
+
+namespace tpp_nets {
+  /**
+   * Contracts two tensors through the process-wide einsum front-end: U = einsum(expr, S, T), U is overwritten.
+   *
+   * @param i_expr einsum expression, e.g., "abcd,aecf->ebfd".
+   * @param i_s input tensor S.
+   * @param i_t input tensor T.
+   * @param o_u output tensor U, has to be allocated.
+   **/
+  void einsum( std::string const & i_expr,
+               at::Tensor  const & i_s,
+               at::Tensor  const & i_t,
+               at::Tensor        & o_u );
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include "Einsum.h"
+
+TEST_CASE( "Tests the lowering of einsum expressions.",
+           "[tpp_nets][Einsum][lower]" ) {
+  tpp_nets::frontend::Einsum l_einsum;
+
+  std::shared_ptr< tpp_nets::frontend::Einsum::Lowered const > l_lowered = l_einsum.lower( "abcd,aecf->ebfd" );
+
+  REQUIRE( l_lowered->types_s == std::vector< int8_t >{ 1, 0, 1, 0 } );
+  REQUIRE( l_lowered->types_t == std::vector< int8_t >{ 1, 0, 1, 0 } );
+  REQUIRE( l_lowered->types_u == std::vector< int8_t >{ 1, 0, 1, 0 } );
+
+  REQUIRE( l_lowered->ids_s_t == std::vector< int64_t >{ 0, -1, 2, -1 } );
+  REQUIRE( l_lowered->ids_s_u == std::vector< int64_t >{ -1, 1, -1, 3 } );
+  REQUIRE( l_lowered->ids_t_u == std::vector< int64_t >{ 1, -1, 3, -1 } );
+
+  // batch dimensions and whitespace
+  l_lowered = l_einsum.lower( "xmk, xkn -> xmn" );
+  REQUIRE( l_lowered->types_s == std::vector< int8_t >{ 2, 0, 1 } );
+  REQUIRE( l_lowered->types_t == std::vector< int8_t >{ 2, 1, 0 } );
+  REQUIRE( l_lowered->types_u == std::vector< int8_t >{ 2, 0, 1 } );
+
+  // K dimensions in different orders
+  l_lowered = l_einsum.lower( "acb,bcd->da" );
+  REQUIRE( l_lowered->order_t == std::vector< int64_t >{ 1, 0, 2 } );
+  REQUIRE( l_lowered->order_u == std::vector< int64_t >{ 0, 1 } );
+
+  // the first expression is cached
+  l_einsum.lower( "abcd,aecf->ebfd" );
+  REQUIRE( l_einsum.n_parses() == 3 );
+}
+
+TEST_CASE( "Tests contractions through the einsum front-end.",
+           "[tpp_nets][Einsum][einsum]" ) {
+  tpp_nets::frontend::Einsum::instance().clear();
+
+  at::Tensor l_s = at::rand( { 18, 5, 22, 13 } );
+  at::Tensor l_t = at::rand( { 18, 8, 22, 7 } );
+  at::Tensor l_u = at::rand( { 8, 5, 7, 13 } );
+
+  // U is overwritten
+  for( int64_t l_re = 0; l_re < 2; l_re++ ) {
+    tpp_nets::einsum( "abcd,aecf->ebfd",
+                      l_s,
+                      l_t,
+                      l_u );
+  }
+
+  at::Tensor l_ref = at::einsum( "abcd,aecf->ebfd",
+                                 {l_s, l_t} );
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+
+  // batched contraction with a permuted output
+  at::Tensor l_s_batch = at::rand( { 3, 16, 24 } );
+  at::Tensor l_t_batch = at::rand( { 3, 24, 20 } );
+  at::Tensor l_u_batch = at::empty( { 20, 3, 16 } );
+
+  tpp_nets::einsum( "xmk,xkn->nxm",
+                    l_s_batch,
+                    l_t_batch,
+                    l_u_batch );
+
+  l_ref = at::einsum( "xmk,xkn->nxm",
+                      {l_s_batch, l_t_batch} );
+  REQUIRE( at::allclose( l_u_batch,
+                         l_ref ) );
+
+  // dimensions of the same type in different orders
+  at::Tensor l_s_perm = at::rand( { 8, 6, 5, 3 } );
+  at::Tensor l_t_perm = at::rand( { 5, 4, 6, 3 } );
+  at::Tensor l_u_perm = at::empty( { 3, 4, 8 } );
+
+  tpp_nets::einsum( "acbx,bdcx->xda",
+                    l_s_perm,
+                    l_t_perm,
+                    l_u_perm );
+
+  l_ref = at::einsum( "acbx,bdcx->xda",
+                      {l_s_perm, l_t_perm} );
+  REQUIRE( at::allclose( l_u_perm,
+                         l_ref ) );
+
+  // every expression is only parsed once
+  REQUIRE( tpp_nets::frontend::Einsum::instance().n_parses() == 3 );
+}
+
+TEST_CASE( "Tests output dtypes and empty tensors in the einsum front-end.",
+           "[tpp_nets][Einsum][empty]" ) {
+  at::Tensor l_s = at::rand( { 16, 24 } );
+  at::Tensor l_t = at::rand( { 24, 20 } );
+
+  // U has to have S's dtype or float for low-precision S
+  at::Tensor l_u_double = at::empty( { 16, 20 }, at::kDouble );
+  REQUIRE_THROWS_AS( tpp_nets::einsum( "mk,kn->mn", l_s, l_t, l_u_double ), c10::Error );
+
+  at::Tensor l_u_bf16 = at::empty( { 16, 20 }, at::kBFloat16 );
+  REQUIRE_THROWS_AS( tpp_nets::einsum( "mk,kn->mn", l_s, l_t, l_u_bf16 ), c10::Error );
+
+  at::Tensor l_u = at::empty( { 16, 20 } );
+  tpp_nets::einsum( "mk,kn->mn",
+                    l_s.to( at::kBFloat16 ),
+                    l_t.to( at::kBFloat16 ),
+                    l_u );
+  REQUIRE( at::allclose( l_u,
+                         at::matmul( l_s.to( at::kBFloat16 ).to( at::kFloat ),
+                                     l_t.to( at::kBFloat16 ).to( at::kFloat ) ),
+                         1E-2,
+                         1E-2 ) );
+
+  // empty K: U holds the empty sum
+  at::Tensor l_s_empty_k = at::rand( { 16, 0 } );
+  at::Tensor l_t_empty_k = at::rand( { 0, 20 } );
+  l_u = at::rand( { 16, 20 } );
+  tpp_nets::einsum( "mk,kn->mn",
+                    l_s_empty_k,
+                    l_t_empty_k,
+                    l_u );
+  REQUIRE( at::equal( l_u,
+                      at::zeros_like( l_u ) ) );
+
+  // empty M: nothing to compute
+  at::Tensor l_s_empty_m = at::rand( { 0, 24 } );
+  at::Tensor l_u_empty_m = at::empty( { 0, 20 } );
+  REQUIRE_NOTHROW( tpp_nets::einsum( "mk,kn->mn", l_s_empty_m, l_t, l_u_empty_m ) );
+}
@@ -0,0 +1,167 @@
+#include <cctype>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/library.h>
+#include "TorchOp.h"
+#include "Einsum.h"
+
+namespace tpp_nets {
+  namespace frontend {
+    class TorchOpFunction;
+  }
+}
+
+/**
+ * Autograd function of the operator, the forward pass redispatches below autograd.
+ **/
+class tpp_nets::frontend::TorchOpFunction : public torch::autograd::Function< TorchOpFunction > {
+  public:
+    /**
+     * Forward pass, saves S and T for the backward pass.
+     *
+     * @param io_ctx autograd context.
+     * @param i_expr einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @return output tensor U.
+     **/
+    static at::Tensor forward( torch::autograd::AutogradContext * io_ctx,
+                               std::string const                & i_expr,
+                               at::Tensor const                 & i_s,
+                               at::Tensor const                 & i_t ) {
+      at::AutoDispatchBelowADInplaceOrView l_guard;
+
+      io_ctx->save_for_backward( { i_s, i_t } );
+      io_ctx->saved_data["expr"] = i_expr;
+
+      return TorchOp::call( i_expr,
+                            i_s,
+                            i_t );
+    }
+
+    /**
+     * Backward pass, the gradients are contractions of U's gradient with T and S.
+     *
+     * @param io_ctx autograd context.
+     * @param i_grads gradient of U.
+     * @return gradients of the expression (undefined), S and T.
+     **/
+    static torch::autograd::variable_list backward( torch::autograd::AutogradContext * io_ctx,
+                                                    torch::autograd::variable_list     i_grads ) {
+      torch::autograd::variable_list l_saved = io_ctx->get_saved_variables();
+      std::string l_expr = io_ctx->saved_data["expr"].toStringRef();
+
+      // expanded gradients (e.g., of a sum) are materialized, permuted ones are used as they are
+      at::Tensor l_grad_u = i_grads[0];
+      if( !l_grad_u.is_non_overlapping_and_dense() ) {
+        l_grad_u = l_grad_u.contiguous();
+      }
+
+      at::Tensor l_grad_s;
+      at::Tensor l_grad_t;
+      if( io_ctx->needs_input_grad( 0 ) ) {
+        l_grad_s = TorchOp::call( TorchOp::expr_grad( l_expr, true ),
+                                  l_grad_u,
+                                  l_saved[1] );
+      }
+      if( io_ctx->needs_input_grad( 1 ) ) {
+        l_grad_t = TorchOp::call( TorchOp::expr_grad( l_expr, false ),
+                                  l_saved[0],
+                                  l_grad_u );
+      }
+
+      return { at::Tensor(), l_grad_s, l_grad_t };
+    }
+};
+
+std::string tpp_nets::frontend::TorchOp::expr_grad( std::string const & i_expr,
+                                                    bool                i_grad_s ) {
+  std::string l_expr;
+  for( char l_char : i_expr ) {
+    if( !std::isspace( (unsigned char) l_char ) ) l_expr += l_char;
+  }
+
+  std::size_t l_pos_comma = l_expr.find( ',' );
+  std::size_t l_pos_arrow = l_expr.find( "->" );
+  TORCH_CHECK( l_pos_comma != std::string::npos && l_pos_arrow != std::string::npos && l_pos_comma < l_pos_arrow,
+               "einsum expression \"", i_expr, "\" doesn't have the form \"<S>,<T>-><U>\"" );
+
+  std::string l_labels_s = l_expr.substr( 0, l_pos_comma );
+  std::string l_labels_t = l_expr.substr( l_pos_comma+1, l_pos_arrow-l_pos_comma-1 );
+  std::string l_labels_u = l_expr.substr( l_pos_arrow+2 );
+
+  if( i_grad_s ) return l_labels_u + "," + l_labels_t + "->" + l_labels_s;
+  else           return l_labels_s + "," + l_labels_u + "->" + l_labels_t;
+}
+
+at::Tensor tpp_nets::frontend::TorchOp::cpu( c10::string_view   i_expr,
+                                             at::Tensor const & i_s,
+                                             at::Tensor const & i_t ) {
+  std::shared_ptr< Einsum::Lowered const > l_lowered = Einsum::instance().lower( std::string( i_expr.data(),
+                                                                                              i_expr.size() ) );
+  TORCH_CHECK( i_s.dim() == (int64_t) l_lowered->types_s.size(),
+               "tppdot expected S with ", l_lowered->types_s.size(), " dimensions, but got ", i_s.dim() );
+  TORCH_CHECK( i_t.dim() == (int64_t) l_lowered->types_t.size(),
+               "tppdot expected T with ", l_lowered->types_t.size(), " dimensions, but got ", i_t.dim() );
+
+  // sizes of U are taken from the matching dimensions of S and T
+  std::vector< int64_t > l_sizes_u;
+  for( std::size_t l_di = 0; l_di < l_lowered->types_u.size(); l_di++ ) {
+    if( l_lowered->ids_s_u[l_di] >= 0 ) l_sizes_u.push_back( i_s.size( l_lowered->ids_s_u[l_di] ) );
+    else                                l_sizes_u.push_back( i_t.size( l_lowered->ids_t_u[l_di] ) );
+  }
+
+  at::Tensor l_u = at::empty( l_sizes_u,
+                              i_s.options() );
+
+  Einsum::contract( *l_lowered,
+                    i_s,
+                    i_t,
+                    l_u );
+
+  return l_u;
+}
+
+at::Tensor tpp_nets::frontend::TorchOp::autograd( c10::string_view   i_expr,
+                                                  at::Tensor const & i_s,
+                                                  at::Tensor const & i_t ) {
+  return TorchOpFunction::apply( std::string( i_expr.data(),
+                                              i_expr.size() ),
+                                 i_s,
+                                 i_t );
+}
+
+at::Tensor tpp_nets::frontend::TorchOp::call( std::string const & i_expr,
+                                              at::Tensor  const & i_s,
+                                              at::Tensor  const & i_t ) {
+  static auto l_op = c10::Dispatcher::singleton().findSchemaOrThrow( "tpp_nets::tppdot", "" )
+                                                 .typed< at::Tensor( c10::string_view,
+                                                                     at::Tensor const &,
+                                                                     at::Tensor const & ) >();
+
+  return l_op.call( i_expr,
+                    i_s,
+                    i_t );
+}
+
+at::Tensor tpp_nets::tppdot( std::string const & i_expr,
+                             at::Tensor  const & i_s,
+                             at::Tensor  const & i_t ) {
+  return frontend::TorchOp::call( i_expr,
+                                  i_s,
+                                  i_t );
+}
+
+TORCH_LIBRARY( tpp_nets, i_lib ) {
+  i_lib.def( "tppdot(str expr, Tensor s, Tensor t) -> Tensor" );
+}
+
+TORCH_LIBRARY_IMPL( tpp_nets, CPU, i_lib ) {
+  i_lib.impl( "tppdot",
+              &tpp_nets::frontend::TorchOp::cpu );
+}
+
+TORCH_LIBRARY_IMPL( tpp_nets, Autograd, i_lib ) {
+  i_lib.impl( "tppdot",
+              &tpp_nets::frontend::TorchOp::autograd );
+}
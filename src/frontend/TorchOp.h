@@ -0,0 +1,90 @@
+#ifndef TPP_NETS_FRONTEND_TORCH_OP
+#define TPP_NETS_FRONTEND_TORCH_OP
+
+#include <string>
+#include <ATen/ATen.h>
+
+namespace tpp_nets {
+  namespace frontend {
+    class TorchOp;
+  }
+}
+
+/**
+ * PyTorch operator tpp_nets::tppdot(str expr, Tensor s, Tensor t) -> Tensor.
+ *
+ * The operator contracts two tensors through the einsum front-end, e.g., tppdot("abcd,aecf->ebfd", s, t).
+ * U is allocated contiguously, S and T are passed with their strides, i.e., permuted views are not copied.
+ *
+ * The operator has a CPU kernel and an autograd kernel.
+ * The gradients of a binary contraction are binary contractions:
+ *   - dS = einsum("<U>,<T>-><S>", dU, T),
+ *   - dT = einsum("<S>,<U>-><T>", S, dU),
+ * which are dispatched to the operator again, i.e., the backward pass is lowered to BinaryContraction as well.
+ *
+ * Python: torch.ops.load_library("libtpp_nets.so"), then torch.ops.tpp_nets.tppdot(expr, s, t).
+ **/
+class tpp_nets::frontend::TorchOp {
+  public:
+    /**
+     * Derives the expression of a gradient.
+     *
+     * @param i_expr einsum expression of the contraction.
+     * @param i_grad_s true if the gradient w.r.t. S is derived, false for the gradient w.r.t. T.
+     * @return einsum expression of the gradient.
+     **/
+    static std::string expr_grad( std::string const & i_expr,
+                                  bool                i_grad_s );
+
+    /**
+     * CPU kernel of the operator.
+     *
+     * @param i_expr einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @return output tensor U.
+     **/
+    static at::Tensor cpu( c10::string_view   i_expr,
+                           at::Tensor const & i_s,
+                           at::Tensor const & i_t );
+
+    /**
+     * Autograd kernel of the operator.
+     *
+     * @param i_expr einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @return output tensor U.
+     **/
+    static at::Tensor autograd( c10::string_view   i_expr,
+                                at::Tensor const & i_s,
+                                at::Tensor const & i_t );
+
+    /**
+     * Calls the operator through the dispatcher.
+     *
+     * @param i_expr einsum expression.
+     * @param i_s input tensor S.
+     * @param i_t input tensor T.
+     * @return output tensor U.
+     **/
+    static at::Tensor call( std::string const & i_expr,
+                            at::Tensor  const & i_s,
+                            at::Tensor  const & i_t );
+};
+
+namespace tpp_nets {
+  /**
+   * Contracts two tensors through the PyTorch operator tpp_nets::tppdot, supports autograd.
+   *
+   * @param i_expr einsum expression, e.g., "abcd,aecf->ebfd".
+   * @param i_s input tensor S.
+   * @param i_t input tensor T.
+   * @return output tensor U.
+   **/
+  at::Tensor tppdot( std::string const & i_expr,
+                     at::Tensor  const & i_s,
+                     at::Tensor  const & i_t );
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include "TorchOp.h"
+
+TEST_CASE( "Tests the expressions of the gradients.",
+           "[tpp_nets][TorchOp][expr_grad]" ) {
+  REQUIRE( tpp_nets::frontend::TorchOp::expr_grad( "xmk, xkn -> xnm", true  ) == "xnm,xkn->xmk" );
+  REQUIRE( tpp_nets::frontend::TorchOp::expr_grad( "xmk, xkn -> xnm", false ) == "xmk,xnm->xkn" );
+}
+
+TEST_CASE( "Tests the forward pass of the operator.",
+           "[tpp_nets][TorchOp][forward]" ) {
+  at::Tensor l_s = at::rand( { 18, 5, 22, 13 } );
+  at::Tensor l_t = at::rand( { 18, 8, 22, 7 } ).permute( { 2, 1, 0, 3 } );
+
+  at::Tensor l_u = tpp_nets::tppdot( "abcd,ceaf->ebfd",
+                                     l_s,
+                                     l_t );
+
+  at::Tensor l_ref = at::einsum( "abcd,ceaf->ebfd",
+                                 {l_s, l_t} );
+  REQUIRE( at::allclose( l_u,
+                         l_ref ) );
+}
+
+TEST_CASE( "Tests the backward pass of the operator.",
+           "[tpp_nets][TorchOp][backward]" ) {
+  at::Tensor l_s = at::rand( { 3, 16, 24 } ).requires_grad_();
+  at::Tensor l_t = at::rand( { 3, 24, 20 } ).requires_grad_();
+  at::Tensor l_s_ref = l_s.detach().clone().requires_grad_();
+  at::Tensor l_t_ref = l_t.detach().clone().requires_grad_();
+
+  at::Tensor l_grad = at::rand( { 20, 3, 16 } );
+
+  at::Tensor l_u = tpp_nets::tppdot( "xmk,xkn->nxm",
+                                     l_s,
+                                     l_t );
+  l_u.backward( l_grad );
+
+  at::Tensor l_u_ref = at::einsum( "xmk,xkn->nxm",
+                                   {l_s_ref, l_t_ref} );
+  l_u_ref.backward( l_grad );
+
+  REQUIRE( at::allclose( l_s.grad(),
+                         l_s_ref.grad() ) );
+  REQUIRE( at::allclose( l_t.grad(),
+                         l_t_ref.grad() ) );
+
+  // expanded gradient of a sum
+  l_s.grad().zero_();
+  l_t.grad().zero_();
+  tpp_nets::tppdot( "xmk,xkn->nxm",
+                    l_s,
+                    l_t ).sum().backward();
+
+  // dS[x,m,k] = sum_n T[x,k,n]
+  REQUIRE( at::allclose( l_s.grad(),
+                         l_t.detach().sum( { 2 } ).unsqueeze( 1 ).expand( { 3, 16, 24 } ) ) );
+}
+
+TEST_CASE( "Tests that malformed calls of the operator raise errors.",
+           "[tpp_nets][TorchOp][errors]" ) {
+  at::Tensor l_s = at::rand( { 16, 24 } );
+  at::Tensor l_t = at::rand( { 24, 20 } );
+
+  // malformed expressions
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mk,kn", l_s, l_t ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mk,kn,n->mn", l_s, l_t ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "m1,1n->mn", l_s, l_t ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mkk,kn->mn", l_s, l_t ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mk,kn->mx", l_s, l_t ), c10::Error );
+
+  // ranks, sizes of shared labels and dtypes
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "xmk,kn->xmn", l_s, l_t ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mk,kn->mn", l_s, l_t.t() ), c10::Error );
+  REQUIRE_THROWS_AS( tpp_nets::tppdot( "mk,kn->mn", l_s, l_t.to( at::kDouble ) ), c10::Error );
+}
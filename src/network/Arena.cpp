@@ -0,0 +1,23 @@
+#include <cassert>
+#include <cstdlib>
+#include <sys/mman.h>
+#include "Arena.h"
+
+tpp_nets::network::Arena::~Arena() {
+  std::free( m_data );
+}
+
+void tpp_nets::network::Arena::reserve( std::size_t i_size ) {
+  if( i_size <= m_size ) return;
+
+  std::free( m_data );
+  m_size = ( i_size + m_alignment - 1 ) / m_alignment * m_alignment;
+  m_data = std::aligned_alloc( m_alignment,
+                               m_size );
+  assert( m_data != nullptr );
+
+  // huge pages are only a hint, the arena works without them
+  madvise( m_data,
+           m_size,
+           MADV_HUGEPAGE );
+}
@@ -0,0 +1,63 @@
+#ifndef TPP_NETS_NETWORK_ARENA
+#define TPP_NETS_NETWORK_ARENA
+
+#include <cstddef>
+
+namespace tpp_nets {
+  namespace network {
+    class Arena;
+  }
+}
+
+/**
+ * Memory arena holding the intermediate tensors of network contractions.
+ *
+ * The memory is aligned to 2MB and its size is a multiple of 2MB,
+ * transparent huge pages are requested for it.
+ * The arena only grows, i.e., the memory is reused by all contractions which fit.
+ **/
+class tpp_nets::network::Arena {
+  private:
+    //! alignment of the memory in bytes
+    static constexpr std::size_t m_alignment = std::size_t(2) * 1024 * 1024;
+
+    //! memory of the arena
+    void * m_data = nullptr;
+
+    //! size of the arena in bytes
+    std::size_t m_size = 0;
+
+  public:
+    Arena() = default;
+    Arena( Arena const & ) = delete;
+    Arena & operator=( Arena const & ) = delete;
+
+    /**
+     * Destructor, frees the memory.
+     **/
+    ~Arena();
+
+    /**
+     * Ensures that the arena holds at least the given number of bytes.
+     * The contents are not preserved if the arena grows.
+     *
+     * @param i_size number of bytes.
+     **/
+    void reserve( std::size_t i_size );
+
+    /**
+     * Gets the memory of the arena.
+     *
+     * @return pointer to the memory.
+     **/
+    void * data() const { return m_data; }
+
+    /**
+     * Gets the size of the arena.
+     *
+     * @return size in bytes.
+     **/
+    std::size_t size() const { return m_size; }
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include "Arena.h"
+
+TEST_CASE( "Tests the growth and alignment of the arena.",
+           "[tpp_nets][Arena]" ) {
+  std::size_t l_huge = std::size_t(2) * 1024 * 1024;
+  tpp_nets::network::Arena l_arena;
+  REQUIRE( l_arena.size() == 0 );
+
+  l_arena.reserve( 1 );
+  REQUIRE( l_arena.size() == l_huge );
+  REQUIRE( (uintptr_t) l_arena.data() % l_huge == 0 );
+
+  // the arena doesn't shrink
+  void * l_data = l_arena.data();
+  l_arena.reserve( 1024 );
+  REQUIRE( l_arena.data() == l_data );
+  REQUIRE( l_arena.size() == l_huge );
+
+  l_arena.reserve( 3 * 1024 * 1024 );
+  REQUIRE( l_arena.size() == 2 * l_huge );
+  REQUIRE( (uintptr_t) l_arena.data() % l_huge == 0 );
+}
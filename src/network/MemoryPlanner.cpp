@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cassert>
+#include "MemoryPlanner.h"
+
+void tpp_nets::network::MemoryPlanner::plan( std::vector< Buffer > const & i_buffers ) {
+  int64_t l_n_buffers = i_buffers.size();
+  m_offsets.assign( l_n_buffers, 0 );
+  m_size = 0;
+
+  // sizes rounded up to the alignment
+  std::vector< int64_t > l_sizes( l_n_buffers );
+  for( int64_t l_bu = 0; l_bu < l_n_buffers; l_bu++ ) {
+    assert( i_buffers[l_bu].size >= 0 );
+    assert( i_buffers[l_bu].first <= i_buffers[l_bu].last );
+    l_sizes[l_bu] = ( i_buffers[l_bu].size + m_alignment - 1 ) / m_alignment * m_alignment;
+  }
+
+  // placement order: large buffers first
+  std::vector< int64_t > l_order( l_n_buffers );
+  for( int64_t l_bu = 0; l_bu < l_n_buffers; l_bu++ ) l_order[l_bu] = l_bu;
+  std::stable_sort( l_order.begin(),
+                    l_order.end(),
+                    [&]( int64_t i_a, int64_t i_b ) { return l_sizes[i_a] > l_sizes[i_b]; } );
+
+  std::vector< int64_t > l_placed;
+  for( int64_t l_bu : l_order ) {
+    Buffer const & l_buffer = i_buffers[l_bu];
+
+    // already placed buffers which are alive at the same time, ordered by their offsets
+    std::vector< int64_t > l_overlaps;
+    for( int64_t l_pl : l_placed ) {
+      if(    i_buffers[l_pl].first <= l_buffer.last
+          && l_buffer.first <= i_buffers[l_pl].last ) {
+        l_overlaps.push_back( l_pl );
+      }
+    }
+    std::sort( l_overlaps.begin(),
+               l_overlaps.end(),
+               [&]( int64_t i_a, int64_t i_b ) { return m_offsets[i_a] < m_offsets[i_b]; } );
+
+    // smallest gap which fits, the end of the ranges otherwise
+    int64_t l_offset = -1;
+    int64_t l_best_gap = -1;
+    int64_t l_end = 0;
+    for( int64_t l_ov : l_overlaps ) {
+      int64_t l_gap = m_offsets[l_ov] - l_end;
+      if(    l_gap >= l_sizes[l_bu]
+          && ( l_best_gap < 0 || l_gap < l_best_gap ) ) {
+        l_offset = l_end;
+        l_best_gap = l_gap;
+      }
+      l_end = std::max( l_end, m_offsets[l_ov] + l_sizes[l_ov] );
+    }
+    if( l_offset < 0 ) l_offset = l_end;
+
+    m_offsets[l_bu] = l_offset;
+    m_size = std::max( m_size, l_offset + l_sizes[l_bu] );
+    l_placed.push_back( l_bu );
+  }
+}
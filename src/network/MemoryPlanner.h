@@ -0,0 +1,69 @@
+#ifndef TPP_NETS_NETWORK_MEMORY_PLANNER
+#define TPP_NETS_NETWORK_MEMORY_PLANNER
+
+#include <cstdint>
+#include <vector>
+
+namespace tpp_nets {
+  namespace network {
+    class MemoryPlanner;
+  }
+}
+
+/**
+ * Liveness-based placement of temporary buffers in a single arena.
+ *
+ * Every buffer is alive from the step which writes it to the last step which reads it (both inclusive).
+ * Buffers which are alive at the same time get disjoint ranges in the arena,
+ * the range of a buffer is reused as soon as the buffer's last consumer has run.
+ *
+ * The buffers are placed greedily by decreasing size (ties by id).
+ * A buffer is put into the smallest gap between the ranges of already placed, overlapping buffers which fits,
+ * or at the end of the ranges if no gap fits.
+ **/
+class tpp_nets::network::MemoryPlanner {
+  public:
+    //! temporary buffer
+    struct Buffer {
+      //! number of elements
+      int64_t size;
+      //! first step in which the buffer is alive
+      int64_t first;
+      //! last step in which the buffer is alive
+      int64_t last;
+    };
+
+  private:
+    //! alignment of the buffers in elements
+    static constexpr int64_t m_alignment = 64;
+
+    //! offsets of the buffers in elements
+    std::vector< int64_t > m_offsets;
+
+    //! number of elements of the arena
+    int64_t m_size = 0;
+
+  public:
+    /**
+     * Places the buffers in the arena.
+     *
+     * @param i_buffers buffers.
+     **/
+    void plan( std::vector< Buffer > const & i_buffers );
+
+    /**
+     * Gets the offsets of the buffers.
+     *
+     * @return offsets in elements.
+     **/
+    std::vector< int64_t > const & offsets() const { return m_offsets; }
+
+    /**
+     * Gets the size of the arena.
+     *
+     * @return number of elements.
+     **/
+    int64_t size() const { return m_size; }
+};
+
+#endif
@@ -0,0 +1,29 @@
+#include <catch2/catch.hpp>
+#include "MemoryPlanner.h"
+
+TEST_CASE( "Tests the reuse of buffers whose lifetimes don't overlap.",
+           "[tpp_nets][MemoryPlanner][reuse]" ) {
+  tpp_nets::network::MemoryPlanner l_planner;
+
+  // sizes are rounded up to 64 elements
+  l_planner.plan( { {100, 0, 1},
+                    { 50, 1, 2},
+                    {100, 2, 3} } );
+
+  REQUIRE( l_planner.offsets() == std::vector< int64_t >{ 0, 128, 0 } );
+  REQUIRE( l_planner.size() == 192 );
+}
+
+TEST_CASE( "Tests the placement of buffers in gaps.",
+           "[tpp_nets][MemoryPlanner][gap]" ) {
+  tpp_nets::network::MemoryPlanner l_planner;
+
+  // the last buffer reuses the range of the second one
+  l_planner.plan( { {64, 0, 3},
+                    {64, 0, 0},
+                    {64, 0, 3},
+                    {64, 1, 3} } );
+
+  REQUIRE( l_planner.offsets() == std::vector< int64_t >{ 0, 64, 128, 64 } );
+  REQUIRE( l_planner.size() == 192 );
+}
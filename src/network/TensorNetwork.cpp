@@ -0,0 +1,551 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cctype>
+#include <functional>
+#include "TensorNetwork.h"
+
+bool tpp_nets::network::TensorNetwork::less( Cost const & i_a,
+                                             Cost const & i_b ) {
+  if( i_a.flops != i_b.flops ) return i_a.flops < i_b.flops;
+  return i_a.memory < i_b.memory;
+}
+
+double tpp_nets::network::TensorNetwork::size( uint64_t i_labels ) const {
+  double l_size = 1;
+  for( std::size_t l_la = 0; l_la < m_sizes_labels.size(); l_la++ ) {
+    if( i_labels & ( uint64_t(1) << l_la ) ) {
+      l_size *= m_sizes_labels[l_la];
+    }
+  }
+  return l_size;
+}
+
+tpp_nets::network::TensorNetwork::Cost tpp_nets::network::TensorNetwork::cost( std::vector< std::pair< int64_t, int64_t > > const & i_path ) const {
+  Cost l_cost;
+
+  std::vector< uint64_t > l_ops = m_labels_in;
+  std::vector< bool > l_inter( l_ops.size(), false );
+  double l_live = 0;
+
+  for( std::size_t l_st = 0; l_st < i_path.size(); l_st++ ) {
+    int64_t l_id_0 = i_path[l_st].first;
+    int64_t l_id_1 = i_path[l_st].second;
+
+    uint64_t l_keep = m_labels_out;
+    for( std::size_t l_op = 0; l_op < l_ops.size(); l_op++ ) {
+      if( (int64_t) l_op != l_id_0 && (int64_t) l_op != l_id_1 ) l_keep |= l_ops[l_op];
+    }
+    uint64_t l_res = ( l_ops[l_id_0] | l_ops[l_id_1] ) & l_keep;
+
+    // the network's output isn't an intermediate
+    bool l_last = l_ops.size() == 2;
+    double l_size_res = l_last ? 0 : size( l_res );
+
+    l_cost.flops += 2 * size( l_ops[l_id_0] | l_ops[l_id_1] );
+    l_cost.memory = std::max( l_cost.memory, l_live + l_size_res );
+
+    l_live += l_size_res;
+    if( l_inter[l_id_0] ) l_live -= size( l_ops[l_id_0] );
+    if( l_inter[l_id_1] ) l_live -= size( l_ops[l_id_1] );
+
+    l_ops.erase(   l_ops.begin()   + l_id_1 );
+    l_ops.erase(   l_ops.begin()   + l_id_0 );
+    l_inter.erase( l_inter.begin() + l_id_1 );
+    l_inter.erase( l_inter.begin() + l_id_0 );
+    l_ops.push_back( l_res );
+    l_inter.push_back( true );
+  }
+
+  return l_cost;
+}
+
+void tpp_nets::network::TensorNetwork::path_greedy( std::vector< std::pair< int64_t, int64_t > > & o_path ) const {
+  o_path.resize( 0 );
+  std::vector< uint64_t > l_ops = m_labels_in;
+
+  while( l_ops.size() > 1 ) {
+    // outer products are only considered if no pair of operands shares a label
+    bool l_shared = false;
+    for( std::size_t l_id_0 = 0; l_id_0 < l_ops.size(); l_id_0++ ) {
+      for( std::size_t l_id_1 = l_id_0+1; l_id_1 < l_ops.size(); l_id_1++ ) {
+        if( ( l_ops[l_id_0] & l_ops[l_id_1] ) != 0 ) l_shared = true;
+      }
+    }
+
+    bool l_found = false;
+    Cost l_best;
+    int64_t l_best_0 = 0;
+    int64_t l_best_1 = 0;
+    uint64_t l_best_res = 0;
+
+    for( std::size_t l_id_0 = 0; l_id_0 < l_ops.size(); l_id_0++ ) {
+      for( std::size_t l_id_1 = l_id_0+1; l_id_1 < l_ops.size(); l_id_1++ ) {
+        if( l_shared && ( l_ops[l_id_0] & l_ops[l_id_1] ) == 0 ) continue;
+
+        uint64_t l_keep = m_labels_out;
+        for( std::size_t l_op = 0; l_op < l_ops.size(); l_op++ ) {
+          if( l_op != l_id_0 && l_op != l_id_1 ) l_keep |= l_ops[l_op];
+        }
+
+        uint64_t l_res = ( l_ops[l_id_0] | l_ops[l_id_1] ) & l_keep;
+        Cost l_cost;
+        l_cost.flops = 2 * size( l_ops[l_id_0] | l_ops[l_id_1] );
+        l_cost.memory = size( l_res );
+
+        if( !l_found || less( l_cost, l_best ) ) {
+          l_found = true;
+          l_best = l_cost;
+          l_best_0 = l_id_0;
+          l_best_1 = l_id_1;
+          l_best_res = l_res;
+        }
+      }
+    }
+    assert( l_found );
+
+    o_path.push_back( { l_best_0, l_best_1 } );
+    l_ops.erase( l_ops.begin() + l_best_1 );
+    l_ops.erase( l_ops.begin() + l_best_0 );
+    l_ops.push_back( l_best_res );
+  }
+}
+
+void tpp_nets::network::TensorNetwork::path_dp( std::vector< std::pair< int64_t, int64_t > > & o_path ) const {
+  int64_t l_n_ops = m_labels_in.size();
+  assert( l_n_ops < 32 );
+
+  uint64_t l_n_sets = uint64_t(1) << l_n_ops;
+  uint64_t l_full = l_n_sets - 1;
+
+  // labels of all subsets of operands
+  std::vector< uint64_t > l_labels( l_n_sets, 0 );
+  for( uint64_t l_set = 1; l_set < l_n_sets; l_set++ ) {
+    l_labels[l_set] = l_labels[ l_set & (l_set-1) ] | m_labels_in[ std::countr_zero( l_set ) ];
+  }
+
+  // labels of a subset's result, i.e., labels which occur outside of the subset
+  auto l_result = [&]( uint64_t i_set ) {
+    return l_labels[i_set] & ( l_labels[l_full ^ i_set] | m_labels_out );
+  };
+
+  // best cost of every subset, the memory is the largest intermediate
+  std::vector< Cost > l_best( l_n_sets );
+  std::vector< uint64_t > l_split( l_n_sets, 0 );
+
+  for( uint64_t l_set = 1; l_set < l_n_sets; l_set++ ) {
+    if( std::popcount( l_set ) < 2 ) continue;
+
+    uint64_t l_res = l_result( l_set );
+    double l_size_res = ( l_set == l_full ) ? 0 : size( l_res );
+
+    // splits into two subsets, the first one contains the lowest operand
+    uint64_t l_low = l_set & ( ~l_set + 1 );
+    uint64_t l_rest = l_set ^ l_low;
+    bool l_found = false;
+    for( uint64_t l_sub = l_rest; ; l_sub = ( l_sub - 1 ) & l_rest ) {
+      uint64_t l_set_0 = l_low | l_sub;
+      uint64_t l_set_1 = l_set ^ l_set_0;
+
+      if( l_set_1 != 0 ) {
+        Cost l_cost;
+        l_cost.flops =   l_best[l_set_0].flops
+                       + l_best[l_set_1].flops
+                       + 2 * size( l_result( l_set_0 ) | l_result( l_set_1 ) );
+        l_cost.memory = std::max( { l_best[l_set_0].memory,
+                                    l_best[l_set_1].memory,
+                                    l_size_res } );
+
+        if( !l_found || less( l_cost, l_best[l_set] ) ) {
+          l_found = true;
+          l_best[l_set] = l_cost;
+          l_split[l_set] = l_set_0;
+        }
+      }
+
+      if( l_sub == 0 ) break;
+    }
+  }
+
+  // convert the tree to a path through a post-order traversal
+  o_path.resize( 0 );
+  std::vector< uint64_t > l_ops;
+  for( int64_t l_op = 0; l_op < l_n_ops; l_op++ ) {
+    l_ops.push_back( uint64_t(1) << l_op );
+  }
+
+  std::function< void( uint64_t ) > l_emit = [&]( uint64_t i_set ) {
+    if( std::popcount( i_set ) < 2 ) return;
+
+    uint64_t l_set_0 = l_split[i_set];
+    uint64_t l_set_1 = i_set ^ l_set_0;
+    l_emit( l_set_0 );
+    l_emit( l_set_1 );
+
+    int64_t l_id_0 = std::find( l_ops.begin(), l_ops.end(), l_set_0 ) - l_ops.begin();
+    int64_t l_id_1 = std::find( l_ops.begin(), l_ops.end(), l_set_1 ) - l_ops.begin();
+    if( l_id_0 > l_id_1 ) std::swap( l_id_0, l_id_1 );
+
+    o_path.push_back( { l_id_0, l_id_1 } );
+    l_ops.erase( l_ops.begin() + l_id_1 );
+    l_ops.erase( l_ops.begin() + l_id_0 );
+    l_ops.push_back( i_set );
+  };
+  l_emit( l_full );
+}
+
+void tpp_nets::network::TensorNetwork::path_optimal( std::vector< std::pair< int64_t, int64_t > > & o_path ) const {
+  // initial bound
+  if( (int64_t) m_labels_in.size() <= m_max_dp ) path_dp( o_path );
+  else                                            path_greedy( o_path );
+  Cost l_best = cost( o_path );
+
+  std::vector< uint64_t > l_ops = m_labels_in;
+  std::vector< bool > l_inter( l_ops.size(), false );
+  std::vector< std::pair< int64_t, int64_t > > l_path;
+
+  std::function< void( double, double, double ) > l_search = [&]( double i_flops,
+                                                                  double i_live,
+                                                                  double i_peak ) {
+    if( l_ops.size() == 1 ) {
+      Cost l_cost = { i_flops, i_peak };
+      if( less( l_cost, l_best ) ) {
+        l_best = l_cost;
+        o_path = l_path;
+      }
+      return;
+    }
+
+    for( std::size_t l_id_0 = 0; l_id_0 < l_ops.size(); l_id_0++ ) {
+      for( std::size_t l_id_1 = l_id_0+1; l_id_1 < l_ops.size(); l_id_1++ ) {
+        uint64_t l_keep = m_labels_out;
+        for( std::size_t l_op = 0; l_op < l_ops.size(); l_op++ ) {
+          if( l_op != l_id_0 && l_op != l_id_1 ) l_keep |= l_ops[l_op];
+        }
+
+        uint64_t l_res = ( l_ops[l_id_0] | l_ops[l_id_1] ) & l_keep;
+        double l_size_res = ( l_ops.size() == 2 ) ? 0 : size( l_res );
+
+        // FLOPs and peak memory only grow, i.e., partial paths which aren't better than the best path are pruned
+        Cost l_cost;
+        l_cost.flops = i_flops + 2 * size( l_ops[l_id_0] | l_ops[l_id_1] );
+        l_cost.memory = std::max( i_peak, i_live + l_size_res );
+        if( !less( l_cost, l_best ) ) continue;
+
+        double l_live = i_live + l_size_res;
+        if( l_inter[l_id_0] ) l_live -= size( l_ops[l_id_0] );
+        if( l_inter[l_id_1] ) l_live -= size( l_ops[l_id_1] );
+
+        // contract
+        uint64_t l_op_0 = l_ops[l_id_0];
+        uint64_t l_op_1 = l_ops[l_id_1];
+        bool l_inter_0 = l_inter[l_id_0];
+        bool l_inter_1 = l_inter[l_id_1];
+        l_ops.erase(   l_ops.begin()   + l_id_1 );
+        l_ops.erase(   l_ops.begin()   + l_id_0 );
+        l_inter.erase( l_inter.begin() + l_id_1 );
+        l_inter.erase( l_inter.begin() + l_id_0 );
+        l_ops.push_back( l_res );
+        l_inter.push_back( true );
+        l_path.push_back( { l_id_0, l_id_1 } );
+
+        l_search( l_cost.flops,
+                  l_live,
+                  l_cost.memory );
+
+        // undo
+        l_path.pop_back();
+        l_ops.pop_back();
+        l_inter.pop_back();
+        l_ops.insert(   l_ops.begin()   + l_id_0, l_op_0 );
+        l_ops.insert(   l_ops.begin()   + l_id_1, l_op_1 );
+        l_inter.insert( l_inter.begin() + l_id_0, l_inter_0 );
+        l_inter.insert( l_inter.begin() + l_id_1, l_inter_1 );
+      }
+    }
+  };
+
+  l_search( 0, 0, 0 );
+}
+
+void tpp_nets::network::TensorNetwork::init( std::string                           const & i_expr,
+                                             std::vector< std::vector< int64_t > > const & i_sizes,
+                                             path_t                                        i_path ) {
+  // labels of the operands and the output
+  std::vector< std::string > l_strs( 1 );
+  std::string l_str_out;
+  bool l_out = false;
+
+  for( std::size_t l_ch = 0; l_ch < i_expr.size(); l_ch++ ) {
+    char l_char = i_expr[l_ch];
+
+    if( std::isspace( (unsigned char) l_char ) ) {
+      continue;
+    }
+    else if( l_char == ',' ) {
+      assert( !l_out );
+      l_strs.push_back( "" );
+    }
+    else if( l_char == '-' ) {
+      assert( !l_out );
+      assert( l_ch+1 < i_expr.size() && i_expr[l_ch+1] == '>' );
+      l_out = true;
+      l_ch++;
+    }
+    else {
+      assert( std::isalpha( (unsigned char) l_char ) );
+      if( l_out ) l_str_out += l_char;
+      else        l_strs.back() += l_char;
+    }
+  }
+  assert( l_out );
+  assert( !l_str_out.empty() );
+  assert( l_strs.size() >= 2 );
+  assert( l_strs.size() == i_sizes.size() );
+
+  // ids and sizes of the labels
+  m_letters.clear();
+  m_sizes_labels.clear();
+  m_labels_in.assign( l_strs.size(), 0 );
+  m_sizes_in = i_sizes;
+
+  for( std::size_t l_op = 0; l_op < l_strs.size(); l_op++ ) {
+    assert( l_strs[l_op].size() == i_sizes[l_op].size() );
+
+    for( std::size_t l_di = 0; l_di < l_strs[l_op].size(); l_di++ ) {
+      std::size_t l_id = m_letters.find( l_strs[l_op][l_di] );
+      if( l_id == std::string::npos ) {
+        l_id = m_letters.size();
+        m_letters += l_strs[l_op][l_di];
+        m_sizes_labels.push_back( i_sizes[l_op][l_di] );
+      }
+      assert( l_id < 64 );
+      assert( m_sizes_labels[l_id] == i_sizes[l_op][l_di] );
+      assert( ( m_labels_in[l_op] & ( uint64_t(1) << l_id ) ) == 0 );
+
+      m_labels_in[l_op] |= uint64_t(1) << l_id;
+    }
+  }
+
+  m_labels_out = 0;
+  for( std::size_t l_di = 0; l_di < l_str_out.size(); l_di++ ) {
+    std::size_t l_id = m_letters.find( l_str_out[l_di] );
+    assert( l_id != std::string::npos );
+    m_labels_out |= uint64_t(1) << l_id;
+  }
+
+  // every label occurs in at least two tensors
+  for( std::size_t l_la = 0; l_la < m_letters.size(); l_la++ ) {
+    int64_t l_count = ( m_labels_out >> l_la ) & 1;
+    for( std::size_t l_op = 0; l_op < m_labels_in.size(); l_op++ ) {
+      l_count += ( m_labels_in[l_op] >> l_la ) & 1;
+    }
+    assert( l_count >= 2 );
+  }
+
+  // search the contraction path
+  int64_t l_n_ops = m_labels_in.size();
+  if( i_path == path_t::automatic ) {
+    if(      l_n_ops <= m_max_optimal ) i_path = path_t::optimal;
+    else if( l_n_ops <= m_max_dp )      i_path = path_t::dp;
+    else                                i_path = path_t::greedy;
+  }
+
+  if(      i_path == path_t::greedy ) path_greedy(  m_path );
+  else if( i_path == path_t::dp )     path_dp(      m_path );
+  else                                path_optimal( m_path );
+  m_cost = cost( m_path );
+
+  // lower the binary contractions
+  m_steps.clear();
+  std::vector< uint64_t > l_ops = m_labels_in;
+  std::vector< int64_t > l_ids( l_n_ops );
+  for( int64_t l_op = 0; l_op < l_n_ops; l_op++ ) l_ids[l_op] = l_op;
+  int64_t l_id_next = l_n_ops;
+
+  for( std::size_t l_st = 0; l_st < m_path.size(); l_st++ ) {
+    int64_t l_id_0 = m_path[l_st].first;
+    int64_t l_id_1 = m_path[l_st].second;
+
+    uint64_t l_keep = m_labels_out;
+    for( std::size_t l_op = 0; l_op < l_ops.size(); l_op++ ) {
+      if( (int64_t) l_op != l_id_0 && (int64_t) l_op != l_id_1 ) l_keep |= l_ops[l_op];
+    }
+    uint64_t l_res = ( l_ops[l_id_0] | l_ops[l_id_1] ) & l_keep;
+    bool l_last = l_ops.size() == 2;
+
+    // labels of the result: the second operand's labels followed by the first operand's,
+    // i.e., the first operand's fastest dimension is the result's fastest one
+    std::string l_str_res;
+    if( l_last ) {
+      assert( l_res == m_labels_out );
+      l_str_res = l_str_out;
+    }
+    else {
+      for( char l_char : l_strs[l_id_1] ) {
+        if( l_res & ( uint64_t(1) << m_letters.find( l_char ) ) ) l_str_res += l_char;
+      }
+      for( char l_char : l_strs[l_id_0] ) {
+        if(    ( l_res & ( uint64_t(1) << m_letters.find( l_char ) ) )
+            && l_str_res.find( l_char ) == std::string::npos ) l_str_res += l_char;
+      }
+    }
+
+    Step l_step;
+    l_step.id_s = l_ids[l_id_0];
+    l_step.id_t = l_ids[l_id_1];
+    l_step.id_u = l_last ? -1 : l_id_next++;
+    for( char l_char : l_str_res ) {
+      l_step.sizes_u.push_back( m_sizes_labels[ m_letters.find( l_char ) ] );
+    }
+    l_step.lowered = frontend::Einsum::instance().lower( l_strs[l_id_0] + "," + l_strs[l_id_1] + "->" + l_str_res );
+    m_steps.push_back( l_step );
+
+    l_ops.erase(  l_ops.begin()  + l_id_1 );
+    l_ops.erase(  l_ops.begin()  + l_id_0 );
+    l_ids.erase(  l_ids.begin()  + l_id_1 );
+    l_ids.erase(  l_ids.begin()  + l_id_0 );
+    l_strs.erase( l_strs.begin() + l_id_1 );
+    l_strs.erase( l_strs.begin() + l_id_0 );
+    l_ops.push_back( l_res );
+    l_ids.push_back( l_step.id_u );
+    l_strs.push_back( l_str_res );
+  }
+
+  // an intermediate is alive from the step which writes it to the step which reads it
+  m_buffers.assign( m_steps.size() - 1, MemoryPlanner::Buffer() );
+  for( std::size_t l_st = 0; l_st < m_steps.size(); l_st++ ) {
+    Step const & l_step = m_steps[l_st];
+    if( l_step.id_u >= 0 ) {
+      int64_t l_size = 1;
+      for( int64_t l_si : l_step.sizes_u ) l_size *= l_si;
+      m_buffers[ l_step.id_u - l_n_ops ].size = l_size;
+      m_buffers[ l_step.id_u - l_n_ops ].first = l_st;
+    }
+    if( l_step.id_s >= l_n_ops ) m_buffers[ l_step.id_s - l_n_ops ].last = l_st;
+    if( l_step.id_t >= l_n_ops ) m_buffers[ l_step.id_t - l_n_ops ].last = l_st;
+  }
+  m_planner.plan( m_buffers );
+}
+
+void tpp_nets::network::TensorNetwork::contract( std::vector< at::Tensor > const & i_tensors,
+                                                 at::Tensor                      & o_u,
+                                                 Arena                           & io_arena ) const {
+  int64_t l_n_ops = m_labels_in.size();
+  assert( (int64_t) i_tensors.size() == l_n_ops );
+  for( int64_t l_op = 0; l_op < l_n_ops; l_op++ ) {
+    assert( i_tensors[l_op].sizes().vec() == m_sizes_in[l_op] );
+    assert( i_tensors[l_op].scalar_type() == i_tensors[0].scalar_type() );
+  }
+
+  int64_t l_dtype_size = i_tensors[0].element_size();
+  io_arena.reserve( m_planner.size() * l_dtype_size );
+
+  // operands followed by the intermediates
+  std::vector< at::Tensor > l_tensors( i_tensors );
+  l_tensors.resize( l_n_ops + m_steps.size() - 1 );
+
+  for( std::size_t l_st = 0; l_st < m_steps.size(); l_st++ ) {
+    Step const & l_step = m_steps[l_st];
+    at::Tensor const & l_s = l_tensors[l_step.id_s];
+    at::Tensor const & l_t = l_tensors[l_step.id_t];
+
+    if( l_step.id_u >= 0 ) {
+      char * l_data = (char *) io_arena.data() + m_planner.offsets()[ l_step.id_u - l_n_ops ] * l_dtype_size;
+      l_tensors[l_step.id_u] = at::from_blob( l_data,
+                                              l_step.sizes_u,
+                                              l_s.options() );
+    }
+    at::Tensor & l_u = ( l_step.id_u >= 0 ) ? l_tensors[l_step.id_u] : o_u;
+
+    frontend::Einsum::contract( *l_step.lowered,
+                                l_s,
+                                l_t,
+                                l_u );
+  }
+}
+
+void tpp_nets::network::TensorNetwork::contract( std::vector< at::Tensor > const & i_tensors,
+                                                 at::Tensor                      & o_u ) const {
+  thread_local Arena l_arena;
+
+  contract( i_tensors,
+            o_u,
+            l_arena );
+}
+
+tpp_nets::backend::Executor::handle_t tpp_nets::network::TensorNetwork::submit( backend::Executor                               & io_executor,
+                                                                               std::vector< at::Tensor >                 const & i_tensors,
+                                                                               at::Tensor                                      & o_u,
+                                                                               Arena                                           & io_arena,
+                                                                               std::vector< backend::Executor::handle_t > const & i_deps ) const {
+  int64_t l_n_ops = m_labels_in.size();
+  assert( (int64_t) i_tensors.size() == l_n_ops );
+  for( int64_t l_op = 0; l_op < l_n_ops; l_op++ ) {
+    assert( i_tensors[l_op].sizes().vec() == m_sizes_in[l_op] );
+    assert( i_tensors[l_op].scalar_type() == i_tensors[0].scalar_type() );
+  }
+
+  int64_t l_dtype_size = i_tensors[0].element_size();
+  io_arena.reserve( m_planner.size() * l_dtype_size );
+
+  // operands followed by the intermediates, the intermediates are views of the arena
+  std::vector< at::Tensor > l_tensors( i_tensors );
+  l_tensors.resize( l_n_ops + m_steps.size() - 1 );
+  for( std::size_t l_st = 0; l_st < m_steps.size(); l_st++ ) {
+    Step const & l_step = m_steps[l_st];
+    if( l_step.id_u >= 0 ) {
+      char * l_data = (char *) io_arena.data() + m_planner.offsets()[ l_step.id_u - l_n_ops ] * l_dtype_size;
+      l_tensors[l_step.id_u] = at::from_blob( l_data,
+                                              l_step.sizes_u,
+                                              i_tensors[0].options() );
+    }
+  }
+
+  std::vector< backend::Executor::handle_t > l_tasks( m_steps.size() );
+  for( std::size_t l_st = 0; l_st < m_steps.size(); l_st++ ) {
+    Step const & l_step = m_steps[l_st];
+    std::vector< backend::Executor::handle_t > l_deps( i_deps );
+
+    // producers of the operands
+    if( l_step.id_s >= l_n_ops ) l_deps.push_back( l_tasks[ m_buffers[ l_step.id_s - l_n_ops ].first ] );
+    if( l_step.id_t >= l_n_ops ) l_deps.push_back( l_tasks[ m_buffers[ l_step.id_t - l_n_ops ].first ] );
+
+    // writers and readers of earlier intermediates which share arena space with the result,
+    // the planner only lets buffers overlap if their lifetimes are disjoint
+    if( l_step.id_u >= 0 ) {
+      int64_t l_bu = l_step.id_u - l_n_ops;
+      int64_t l_first = m_planner.offsets()[l_bu];
+      int64_t l_last = l_first + m_buffers[l_bu].size;
+
+      for( std::size_t l_ot = 0; l_ot < m_buffers.size(); l_ot++ ) {
+        MemoryPlanner::Buffer const & l_other = m_buffers[l_ot];
+        if( l_other.first >= (int64_t) l_st ) continue;
+
+        int64_t l_first_other = m_planner.offsets()[l_ot];
+        int64_t l_last_other = l_first_other + l_other.size;
+        if( l_first < l_last_other && l_first_other < l_last ) {
+          assert( l_other.last < (int64_t) l_st );
+          l_deps.push_back( l_tasks[l_other.first] );
+          l_deps.push_back( l_tasks[l_other.last] );
+        }
+      }
+    }
+
+    at::Tensor l_s = l_tensors[l_step.id_s];
+    at::Tensor l_t = l_tensors[l_step.id_t];
+    at::Tensor l_u = ( l_step.id_u >= 0 ) ? l_tensors[l_step.id_u] : o_u;
+    std::shared_ptr< frontend::Einsum::Lowered const > l_lowered = l_step.lowered;
+
+    l_tasks[l_st] = io_executor.submit( [l_lowered, l_s, l_t, l_u]() mutable {
+                                          frontend::Einsum::contract( *l_lowered,
+                                                                      l_s,
+                                                                      l_t,
+                                                                      l_u );
+                                        },
+                                        l_deps );
+  }
+
+  // the final step reads the last intermediate(s), all other steps finished before it
+  return l_tasks.back();
+}
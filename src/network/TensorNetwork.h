@@ -0,0 +1,238 @@
+#ifndef TPP_NETS_NETWORK_TENSOR_NETWORK
+#define TPP_NETS_NETWORK_TENSOR_NETWORK
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ATen/ATen.h>
+#include "../backend/Executor.h"
+#include "../frontend/Einsum.h"
+#include "Arena.h"
+#include "MemoryPlanner.h"
+
+namespace tpp_nets {
+  namespace network {
+    class TensorNetwork;
+  }
+}
+
+/**
+ * Contraction of a tensor network, given as einsum expression with an arbitrary number of operands, e.g., "ab,bcd,de,ce->ae".
+ *
+ * The network is contracted through a sequence of binary contractions.
+ * The order of the binary contractions (the path) is derived once in init,
+ * contract only executes the binary contractions through BinaryContraction.
+ * The intermediate tensors are placed in a single arena by a liveness-based memory planner, also in init.
+ *
+ * A path is given in the format of opt_einsum:
+ * every entry (i,j) contracts the i-th and j-th operand of the current list of operands,
+ * both are removed from the list and the result is appended.
+ *
+ * The cost of a path is given by the FLOPs and the memory of the intermediate tensors,
+ * i.e., the peak number of elements of all intermediates which are alive at the same time.
+ * Paths are compared by their FLOPs first, the memory breaks ties.
+ * The following searches are supported:
+ *   - greedy: contracts the pair with the fewest FLOPs (smallest result on ties) next, outer products are only used if no pair shares a label,
+ *   - dp: dynamic programming over all subsets of operands, minimizes the FLOPs, exponential in the number of operands,
+ *   - optimal: branch-and-bound over all sequences of binary contractions, minimizes the FLOPs and the exact memory.
+ *
+ * Every label has to occur in at least two tensors (operands or output),
+ * i.e., reductions over dimensions of a single operand are not supported.
+ * The output has at least one dimension.
+ **/
+class tpp_nets::network::TensorNetwork {
+  public:
+    //! search of the contraction path
+    enum class path_t : int8_t {
+      automatic = 0,
+      greedy    = 1,
+      dp        = 2,
+      optimal   = 3
+    };
+
+    //! cost of a contraction path
+    struct Cost {
+      //! number of floating point operations
+      double flops = 0;
+      //! peak number of elements of all intermediate tensors which are alive at the same time
+      double memory = 0;
+    };
+
+  private:
+    //! maximum number of operands for which the automatic search is optimal
+    static constexpr int64_t m_max_optimal = 6;
+
+    //! maximum number of operands for which the automatic search uses dynamic programming
+    static constexpr int64_t m_max_dp = 14;
+
+    //! single binary contraction of the network
+    struct Step {
+      //! id of the first operand, intermediates follow the network's operands
+      int64_t id_s;
+      //! id of the second operand
+      int64_t id_t;
+      //! id of the result, -1 for the network's output
+      int64_t id_u;
+      //! sizes of the result
+      std::vector< int64_t > sizes_u;
+      //! binary contraction lowered to dimension types
+      std::shared_ptr< frontend::Einsum::Lowered const > lowered;
+    };
+
+    //! letters of the labels, a label's id is its position
+    std::string m_letters;
+
+    //! sizes of the labels
+    std::vector< double > m_sizes_labels;
+
+    //! labels (bitmasks) of the operands
+    std::vector< uint64_t > m_labels_in;
+
+    //! labels (bitmask) of the output
+    uint64_t m_labels_out = 0;
+
+    //! sizes of the operands
+    std::vector< std::vector< int64_t > > m_sizes_in;
+
+    //! contraction path
+    std::vector< std::pair< int64_t, int64_t > > m_path;
+
+    //! cost of the contraction path
+    Cost m_cost;
+
+    //! binary contractions in the order of the path
+    std::vector< Step > m_steps;
+
+    //! sizes and lifetimes of the intermediate tensors
+    std::vector< MemoryPlanner::Buffer > m_buffers;
+
+    //! placement of the intermediate tensors in the arena
+    MemoryPlanner m_planner;
+
+    /**
+     * Compares two costs, FLOPs are compared first and memory breaks ties.
+     *
+     * @param i_a first cost.
+     * @param i_b second cost.
+     * @return true if i_a is smaller than i_b, false otherwise.
+     **/
+    static bool less( Cost const & i_a,
+                      Cost const & i_b );
+
+    /**
+     * Gets the number of elements of a tensor.
+     *
+     * @param i_labels labels of the tensor.
+     * @return number of elements.
+     **/
+    double size( uint64_t i_labels ) const;
+
+    /**
+     * Derives the exact cost of a contraction path.
+     *
+     * @param i_path contraction path.
+     * @return cost.
+     **/
+    Cost cost( std::vector< std::pair< int64_t, int64_t > > const & i_path ) const;
+
+    /**
+     * Derives a contraction path greedily.
+     *
+     * @param o_path will be set to the contraction path.
+     **/
+    void path_greedy( std::vector< std::pair< int64_t, int64_t > > & o_path ) const;
+
+    /**
+     * Derives a contraction path with minimal FLOPs through dynamic programming over subsets of the operands.
+     *
+     * @param o_path will be set to the contraction path.
+     **/
+    void path_dp( std::vector< std::pair< int64_t, int64_t > > & o_path ) const;
+
+    /**
+     * Derives an optimal contraction path through a branch-and-bound search over all sequences of binary contractions.
+     *
+     * @param o_path will be set to the contraction path.
+     **/
+    void path_optimal( std::vector< std::pair< int64_t, int64_t > > & o_path ) const;
+
+  public:
+    /**
+     * Initializes the network, i.e., searches the contraction path and lowers the binary contractions.
+     *
+     * @param i_expr einsum expression of the network, labels are single letters.
+     * @param i_sizes sizes of the operands' dimensions.
+     * @param i_path search of the contraction path, automatic selects the search based on the number of operands.
+     **/
+    void init( std::string                           const & i_expr,
+               std::vector< std::vector< int64_t > > const & i_sizes,
+               path_t                                        i_path = path_t::automatic );
+
+    /**
+     * Gets the contraction path.
+     *
+     * @return contraction path.
+     **/
+    std::vector< std::pair< int64_t, int64_t > > const & path() const { return m_path; }
+
+    /**
+     * Gets the cost of the contraction path.
+     *
+     * @return cost.
+     **/
+    Cost const & cost() const { return m_cost; }
+
+    /**
+     * Gets the size of the arena holding the intermediate tensors.
+     *
+     * @return number of elements.
+     **/
+    int64_t size_arena() const { return m_planner.size(); }
+
+    /**
+     * Contracts the network: U = einsum(expr, operands), U is overwritten.
+     * The intermediate tensors have the operands' datatype and are placed in the given arena.
+     *
+     * @param i_tensors operands of the network.
+     * @param o_u output tensor U, has to be allocated.
+     * @param io_arena arena of the intermediate tensors, grows if required.
+     **/
+    void contract( std::vector< at::Tensor > const & i_tensors,
+                   at::Tensor                      & o_u,
+                   Arena                           & io_arena ) const;
+
+    /**
+     * Contracts the network: U = einsum(expr, operands), U is overwritten.
+     * The intermediate tensors are placed in the calling thread's arena.
+     *
+     * @param i_tensors operands of the network.
+     * @param o_u output tensor U, has to be allocated.
+     **/
+    void contract( std::vector< at::Tensor > const & i_tensors,
+                   at::Tensor                      & o_u ) const;
+
+    /**
+     * Submits the contraction of the network to an executor: U = einsum(expr, operands), U is overwritten.
+     *
+     * Every binary contraction is a task which depends on the producers of its operands
+     * and on the tasks which used the arena space of its result before.
+     * Independent binary contractions, e.g., those of disjoint subtrees of the path, run concurrently on different workers.
+     * The operands, U and the arena have to stay valid and the arena must not be used otherwise until the returned task finished.
+     *
+     * @param io_executor executor which runs the binary contractions.
+     * @param i_tensors operands of the network.
+     * @param o_u output tensor U, has to be allocated.
+     * @param io_arena arena of the intermediate tensors, grows if required.
+     * @param i_deps tasks which have to finish before any binary contraction starts, e.g., producers of the operands.
+     * @return handle of the task which writes U, finishes after all other tasks of the network.
+     **/
+    backend::Executor::handle_t submit( backend::Executor                               & io_executor,
+                                        std::vector< at::Tensor >                 const & i_tensors,
+                                        at::Tensor                                      & o_u,
+                                        Arena                                           & io_arena,
+                                        std::vector< backend::Executor::handle_t > const & i_deps = {} ) const;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+#include <ATen/ATen.h>
+#include "TensorNetwork.h"
+
+TEST_CASE( "Tests the contraction paths of a matrix chain.",
+           "[tpp_nets][TensorNetwork][path]" ) {
+  tpp_nets::network::TensorNetwork l_network;
+
+  for( tpp_nets::network::TensorNetwork::path_t l_path : { tpp_nets::network::TensorNetwork::path_t::greedy,
+                                                           tpp_nets::network::TensorNetwork::path_t::dp,
+                                                           tpp_nets::network::TensorNetwork::path_t::optimal } ) {
+    l_network.init( "ab,bc,cd->ad",
+                    { {10, 100}, {100, 5}, {5, 50} },
+                    l_path );
+
+    // (AB)C: 2*10*100*5 + 2*10*5*50 FLOPs
+    REQUIRE( l_network.path() == std::vector< std::pair< int64_t, int64_t > >{ {0, 1}, {0, 1} } );
+    REQUIRE( l_network.cost().flops == 15000 );
+    REQUIRE( l_network.cost().memory == 50 );
+
+    // single intermediate, rounded up to the alignment
+    REQUIRE( l_network.size_arena() == 64 );
+  }
+}
+
+TEST_CASE( "Tests the contraction paths of a network with a cycle.",
+           "[tpp_nets][TensorNetwork][path]" ) {
+  std::string l_expr = "abc,bde,cdf,efg,gh->ah";
+  std::vector< std::vector< int64_t > > l_sizes = { {8, 4, 6}, {4, 12, 3}, {6, 12, 5}, {3, 5, 7}, {7, 9} };
+
+  tpp_nets::network::TensorNetwork l_greedy;
+  tpp_nets::network::TensorNetwork l_dp;
+  tpp_nets::network::TensorNetwork l_optimal;
+  l_greedy.init(  l_expr, l_sizes, tpp_nets::network::TensorNetwork::path_t::greedy );
+  l_dp.init(      l_expr, l_sizes, tpp_nets::network::TensorNetwork::path_t::dp );
+  l_optimal.init( l_expr, l_sizes, tpp_nets::network::TensorNetwork::path_t::optimal );
+
+  REQUIRE( l_dp.path().size() == 4 );
+  REQUIRE( l_optimal.cost().flops == l_dp.cost().flops );
+  REQUIRE( l_dp.cost().flops <= l_greedy.cost().flops );
+  REQUIRE( l_optimal.cost().memory <= l_dp.cost().memory );
+}
+
+TEST_CASE( "Tests the contraction of tensor networks.",
+           "[tpp_nets][TensorNetwork][contract]" ) {
+  at::Tensor l_a = at::rand( { 8, 4, 6 } );
+  at::Tensor l_b = at::rand( { 4, 12, 3 } );
+  at::Tensor l_c = at::rand( { 6, 12, 5 } );
+  at::Tensor l_d = at::rand( { 3, 5, 7 } );
+  at::Tensor l_e = at::rand( { 7, 9 } );
+
+  at::Tensor l_ref = at::einsum( "abc,bde,cdf,efg,gh->ha",
+                                 {l_a, l_b, l_c, l_d, l_e} );
+
+  // matrix-vector products in the steps
+  at::Tensor l_v = at::rand( { 8 } );
+  at::Tensor l_ref_vec = at::einsum( "abc,bde,cdf,efg,a->g",
+                                     {l_a, l_b, l_c, l_d, l_v} );
+
+  for( tpp_nets::network::TensorNetwork::path_t l_path : { tpp_nets::network::TensorNetwork::path_t::greedy,
+                                                           tpp_nets::network::TensorNetwork::path_t::dp,
+                                                           tpp_nets::network::TensorNetwork::path_t::optimal } ) {
+    tpp_nets::network::TensorNetwork l_network;
+    l_network.init( "abc,bde,cdf,efg,gh->ha",
+                    { {8, 4, 6}, {4, 12, 3}, {6, 12, 5}, {3, 5, 7}, {7, 9} },
+                    l_path );
+
+    at::Tensor l_u = at::rand( { 9, 8 } );
+    l_network.contract( {l_a, l_b, l_c, l_d, l_e},
+                        l_u );
+    REQUIRE( at::allclose( l_u,
+                           l_ref,
+                           1E-4,
+                           1E-5 ) );
+
+    l_network.init( "abc,bde,cdf,efg,a->g",
+                    { {8, 4, 6}, {4, 12, 3}, {6, 12, 5}, {3, 5, 7}, {8} },
+                    l_path );
+
+    // explicit arena
+    tpp_nets::network::Arena l_arena;
+    at::Tensor l_u_vec = at::rand( { 7 } );
+    l_network.contract( {l_a, l_b, l_c, l_d, l_v},
+                        l_u_vec,
+                        l_arena );
+    REQUIRE( l_arena.size() >= l_network.size_arena() * sizeof(float) );
+    REQUIRE( at::allclose( l_u_vec,
+                           l_ref_vec,
+                           1E-4,
+                           1E-5 ) );
+  }
+}
+
+TEST_CASE( "Tests the asynchronous contraction of tensor networks.",
+           "[tpp_nets][TensorNetwork][submit]" ) {
+  at::Tensor l_a = at::rand( { 8, 4, 6 } );
+  at::Tensor l_b = at::rand( { 4, 12, 3 } );
+  at::Tensor l_c = at::rand( { 6, 12, 5 } );
+  at::Tensor l_d = at::rand( { 3, 5, 7 } );
+  at::Tensor l_e = at::rand( { 7, 9 } );
+
+  at::Tensor l_ref = at::einsum( "abc,bde,cdf,efg,gh->ha",
+                                 {l_a, l_b, l_c, l_d, l_e} );
+
+  tpp_nets::backend::Executor l_executor( 2,
+                                          1 );
+
+  tpp_nets::network::TensorNetwork l_network;
+  l_network.init( "abc,bde,cdf,efg,gh->ha",
+                  { {8, 4, 6}, {4, 12, 3}, {6, 12, 5}, {3, 5, 7}, {7, 9} } );
+
+  // second contraction reuses the arena after the first one, both are submitted before waiting
+  tpp_nets::network::Arena l_arena;
+  at::Tensor l_u_0 = at::rand( { 9, 8 } );
+  at::Tensor l_u_1 = at::rand( { 9, 8 } );
+
+  tpp_nets::backend::Executor::handle_t l_task_0 = l_network.submit( l_executor,
+                                                                     {l_a, l_b, l_c, l_d, l_e},
+                                                                     l_u_0,
+                                                                     l_arena );
+  tpp_nets::backend::Executor::handle_t l_task_1 = l_network.submit( l_executor,
+                                                                     {l_a, l_b, l_c, l_d, l_e},
+                                                                     l_u_1,
+                                                                     l_arena,
+                                                                     { l_task_0 } );
+  l_task_1->wait();
+
+  REQUIRE( at::allclose( l_u_0,
+                         l_ref,
+                         1E-4,
+                         1E-5 ) );
+  REQUIRE( at::allclose( l_u_1,
+                         l_ref,
+                         1E-4,
+                         1E-5 ) );
+
+  // chain of alternating wide and narrow matrices: the path contracts disjoint pairs,
+  // i.e., independent subtrees run concurrently and later pairs reuse the arena space of earlier ones
+  std::vector< std::vector< int64_t > > l_sizes_chain;
+  std::vector< at::Tensor > l_chain;
+  for( int64_t l_ma = 0; l_ma < 8; l_ma++ ) {
+    l_sizes_chain.push_back( ( l_ma % 2 == 0 ) ? std::vector< int64_t >{ 4, 100 } : std::vector< int64_t >{ 100, 4 } );
+    l_chain.push_back( at::rand( l_sizes_chain.back() ) );
+  }
+
+  tpp_nets::network::TensorNetwork l_network_chain;
+  l_network_chain.init( "ab,bc,cd,de,ef,fg,gh,hi->ai",
+                        l_sizes_chain );
+
+  // three intermediates are live at most, i.e., the arena is smaller than the six intermediates
+  REQUIRE( l_network_chain.size_arena() < 6 * 64 );
+
+  at::Tensor l_ref_chain = at::einsum( "ab,bc,cd,de,ef,fg,gh,hi->ai",
+                                       l_chain );
+
+  tpp_nets::network::Arena l_arena_chain;
+  at::Tensor l_u_chain = at::rand( { 4, 4 } );
+  l_network_chain.submit( l_executor,
+                          l_chain,
+                          l_u_chain,
+                          l_arena_chain )->wait();
+
+  REQUIRE( at::allclose( l_u_chain,
+                         l_ref_chain,
+                         1E-4,
+                         1E-5 ) );
+}